@@ -15,6 +15,8 @@
 #include "memory.h"
 #include "heap_algo.h"
 #include "functional.h"
+#include "parallel.h"
+#include "simd.h"
 
 /*
 all_of          都满足一元操作
@@ -43,6 +45,7 @@ is_sorted       升序
 median          找三个值的中间值
 max_element
 min_element
+minmax_element  一趟求出最小和最大的元素
 sawp_ranges     交换两区间相同个数的元素
 tranform        unary_op 作用于区间中的每个元素，或binary_op 作用于两个区间的相同位置，结果result返回
 
@@ -74,7 +77,9 @@ merge_adaptive
 
 partial_sort
 partial_sort_copy
-partition       按一元条件运算为true放到前段，稳定的
+partition       按一元条件运算为true放到前段，不保证相对位置
+stable_partition 按一元条件运算为true放到前段，保持相对位置
+parallel_partition 多线程 partition
 partition_copy
 
 nth_element     所有小于第 n 个元素的元素出现在它的前面
@@ -171,7 +176,7 @@ size_t count_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
 template <class InputIter, class T>
 InputIter find(InputIter first, InputIter last, const T& value) {
     while(first != last && *first != value) {
-        ++frist;
+        ++first;
     }
     return first;
 }
@@ -184,7 +189,7 @@ InputIter find(InputIter first, InputIter last, const T& value) {
 template <class InputIter, class UnaryPredicate>
 InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
     while(first != last && !unary_pred(*first)) {
-        ++frist;
+        ++first;
     }
     return first;
 }
@@ -197,7 +202,7 @@ InputIter find_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
 template <class InputIter, class UnaryPredicate>
 InputIter find_if_not(InputIter first, InputIter last, UnaryPredicate unary_pred) {
     while(first != last && unary_pred(*first)) {
-        ++frist;
+        ++first;
     }
     return first;
 }
@@ -215,7 +220,7 @@ ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
     if(d2 > d1)
         return last1;
     auto cur1 = first1;
-    auto cur2 = frist2;
+    auto cur2 = first2;
     while(cur2 != last2) {
         if(*cur1 == *cur2) {
             ++cur1;
@@ -243,7 +248,7 @@ ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
     if(d2 > d1)
         return last1;
     auto cur1 = first1;
-    auto cur2 = frist2;
+    auto cur2 = first2;
     while(cur2 != last2) {
         if(comp(*cur1, *cur2)) {
             ++cur1;
@@ -270,20 +275,20 @@ ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
 template <class ForwardIter, class Size, class T>
 ForwardIter search_n(ForwardIter first, ForwardIter last, Size n, const T& value) {
     if(n <= 0)
-        return false;
+        return first;
     first = mystl::find(first, last, value);
     while(first != last) {
         auto tmp = first;
         auto count = n - 1;
         ++tmp;
-        while(tmp != last && count > 0 && *tmp = value ) {
+        while(tmp != last && count > 0 && *tmp == value) {
             ++tmp;
             --count;
         }
         if(count == 0)
             return first;
         else 
-            first = mystl::find(tmp, last, value;)
+            first = mystl::find(tmp, last, value);
     }
     return last;
 }
@@ -293,8 +298,8 @@ template <class ForwardIter, class Size, class T, class Compare>
 ForwardIter search_n(ForwardIter first, ForwardIter last, Size n, 
         const T& value, Compare comp) {
     if(n <= 0)
-        return false;
-    while(frist != last) {
+        return first;
+    while(first != last) {
         if(comp(*first, value)) 
             break;
         ++first;
@@ -310,12 +315,12 @@ ForwardIter search_n(ForwardIter first, ForwardIter last, Size n,
         if(count == 0)
             return first;
         else {
-            while(tmp != last) {
+            first = tmp;
+            while(first != last) {
                 if(comp(*first, value)) 
                     break;
                 ++first;
             }
-            first = tmp;
         }
     }
     return last;
@@ -328,20 +333,20 @@ ForwardIter search_n(ForwardIter first, ForwardIter last, Size n,
 /*****************************************************************************************/
 template <class ForwardIter1, class ForwardIter2>
 ForwardIter1 find_end_dispatch(ForwardIter1 first1, ForwardIter1 last1,
-        ForwardIter2 frist2, ForwardIter2 last2,
+        ForwardIter2 first2, ForwardIter2 last2,
         forward_iterator_tag, forward_iterator_tag) {
     if(first2 == last2)
         return last1;
     auto result = last1;
     while(true) {
-        auto new_result = mystl::search(first1, last1, frist2, last2);
+        auto new_result = mystl::search(first1, last1, first2, last2);
         if(new_result == last1) {
             return result;
         }
         else {
             result = new_result;
             first1 = new_result;
-            ++frist1;
+            ++first1;
         }
     }
 }
@@ -354,8 +359,8 @@ BidirectionalIter1 find_end_dispatch(BidirectionalIter1 first1, BidirectionalIte
     
     typedef reverse_iterator<BidirectionalIter1> reviter1;
     typedef reverse_iterator<BidirectionalIter2> reviter2;
-    reviter1 rlast1(frist1);
-    reviter2 rlast2(frist2);
+    reviter1 rlast1(first1);
+    reviter2 rlast2(first2);
     reviter1 rresult = mystl::search(reviter1(last1), rlast1, reviter2(last2), rlast2);
     if(rresult == rlast1)
         return last1;
@@ -371,7 +376,7 @@ ForwardIter1 find_end(ForwardIter1 first1, ForwardIter1 last1,
         ForwardIter2 first2, ForwardIter2 last2) {
     typedef typename iterator_traits<ForwardIter1>::iterator_category Category1;
     typedef typename iterator_traits<ForwardIter2>::iterator_category Category2;
-    mystl::find_end_dispatch(frist1, last1, first2, last2, Category1(), Category2());
+    return mystl::find_end_dispatch(first1, last1, first2, last2, Category1(), Category2());
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -385,11 +390,11 @@ find_end_dispatch(ForwardIter1 first1, ForwardIter1 last1,
         return last1;
     auto result = last1; 
     while(true) {
-        auto new_result = mystl::search(frist1, last1, first2, last2, comp);
+        auto new_result = mystl::search(first1, last1, first2, last2, comp);
         if(new_result == last1)
             return result;
         else {
-            result = new_reault;
+            result = new_result;
             first1 = result;
             ++first1;
         }
@@ -404,8 +409,8 @@ find_end_dispatch(BidirectionalIter1 first1, BidirectionalIter1 last1,
         bidirectional_iterator_tag, bidirectional_iterator_tag, Compared comp) {
     typedef reverse_iterator<BidirectionalIter1> reviter1;
     typedef reverse_iterator<BidirectionalIter2> reviter2;
-    reviter1 rlast1(frist1);
-    reviter2 rlast2(frist2);
+    reviter1 rlast1(first1);
+    reviter2 rlast2(first2);
     reviter1 rresult = mystl::search(reviter1(last1), rlast1, reviter2(last2), rlast2, comp);
     if(rresult == rlast1)
         return last1;
@@ -418,7 +423,7 @@ find_end_dispatch(BidirectionalIter1 first1, BidirectionalIter1 last1,
 
 template <class ForwardIter1, class ForwardIter2, class Compared>
 ForwardIter1 find_end(ForwardIter1 first1, ForwardIter1 last1,
-        ForwardIter2 first2, ForwardIter last2, Compared comp) {
+        ForwardIter2 first2, ForwardIter2 last2, Compared comp) {
     typedef typename iterator_traits<ForwardIter1>::iterator_category Category1;
     typedef typename iterator_traits<ForwardIter2>::iterator_category Category2;
     return mystl::find_end_dispatch(first1, last1, first2, last2,
@@ -431,7 +436,7 @@ ForwardIter1 find_end(ForwardIter1 first1, ForwardIter1 last1,
 // 在[first1, last1)中查找[first2, last2)中的某些元素，返回指向第一次出现的元素的迭代器
 /*****************************************************************************************/
 template <class InputIter, class ForwardIter>
-InputIter find_first_if(InputIter first1, InputIter last1, 
+InputIter find_first_of(InputIter first1, InputIter last1, 
         ForwardIter first2, ForwardIter last2) {
     for(; first1 != last1; ++first1) {
         for(auto tmp = first2; tmp != last2; ++tmp) {
@@ -444,7 +449,7 @@ InputIter find_first_if(InputIter first1, InputIter last1,
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter, class ForwardIter, class Compared>
-InputIter find_first_if(InputIter first1, InputIter last1, 
+InputIter find_first_of(InputIter first1, InputIter last1, 
         ForwardIter first2, ForwardIter last2, Compared comp) {
     for(; first1 != last1; ++first1) {
         for(auto tmp = first2; tmp != last2; ++tmp) {
@@ -469,12 +474,201 @@ Function for_each(InputIter first, InputIter last, Function f) {
 }
 
 
+/*****************************************************************************************/
+// 连续算术区间的相邻元素比较
+// 把 [i, i + L) 与错开一个元素的 [i + 1, i + L + 1) 作为两个向量比较，一次检查 L 对相邻元素
+// 浮点数使用有序比较，与 operator== / operator< 对 NaN、-0.0 的结果一致
+/*****************************************************************************************/
+template <class T>
+struct is_neighbor_simd_type : public m_bool_constant<
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+    (std::is_integral<T>::value || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+// 可以原地压缩去重的类型
+template <class T>
+struct is_unique_simd_type : public m_bool_constant<
+    is_neighbor_simd_type<T>::value && !std::is_const<T>::value &&
+    (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+#ifdef MYSTL_SIMD_X86
+// 比较结果统一为 __m256i 的全 1 / 全 0 掩码
+template <class T>
+struct avx2_neighbor_ops {
+    MYSTL_TARGET_AVX2 static __m256i load(const T* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    MYSTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) {
+        if constexpr(std::is_same<T, float>::value)
+            return _mm256_castps_si256(_mm256_cmp_ps(
+                _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+        else if constexpr(std::is_same<T, double>::value)
+            return _mm256_castpd_si256(_mm256_cmp_pd(
+                _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+        else if constexpr(sizeof(T) == 1)
+            return _mm256_cmpeq_epi8(a, b);
+        else if constexpr(sizeof(T) == 2)
+            return _mm256_cmpeq_epi16(a, b);
+        else if constexpr(sizeof(T) == 4)
+            return _mm256_cmpeq_epi32(a, b);
+        else
+            return _mm256_cmpeq_epi64(a, b);
+    }
+    // a > b，无符号整型先翻转最高位
+    MYSTL_TARGET_AVX2 static __m256i gt(__m256i a, __m256i b) {
+        if constexpr(std::is_same<T, float>::value)
+            return _mm256_castps_si256(_mm256_cmp_ps(
+                _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_GT_OQ));
+        else if constexpr(std::is_same<T, double>::value)
+            return _mm256_castpd_si256(_mm256_cmp_pd(
+                _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_GT_OQ));
+        else {
+            if constexpr(!std::is_signed<T>::value) {
+                __m256i bias;
+                if constexpr(sizeof(T) == 1)
+                    bias = _mm256_set1_epi8(static_cast<char>(0x80));
+                else if constexpr(sizeof(T) == 2)
+                    bias = _mm256_set1_epi16(static_cast<short>(0x8000));
+                else if constexpr(sizeof(T) == 4)
+                    bias = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+                else
+                    bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+                a = _mm256_xor_si256(a, bias);
+                b = _mm256_xor_si256(b, bias);
+            }
+            if constexpr(sizeof(T) == 1)
+                return _mm256_cmpgt_epi8(a, b);
+            else if constexpr(sizeof(T) == 2)
+                return _mm256_cmpgt_epi16(a, b);
+            else if constexpr(sizeof(T) == 4)
+                return _mm256_cmpgt_epi32(a, b);
+            else
+                return _mm256_cmpgt_epi64(a, b);
+        }
+    }
+    // 以下只用于 4 / 8 字节类型
+    MYSTL_TARGET_AVX2 static __m256i broadcast(T v) {
+        if constexpr(sizeof(T) == 4) {
+            int32_t bits;
+            std::memcpy(&bits, &v, 4);
+            return _mm256_set1_epi32(bits);
+        }
+        else {
+            int64_t bits;
+            std::memcpy(&bits, &v, 8);
+            return _mm256_set1_epi64x(bits);
+        }
+    }
+    // 返回 [prev 的最后一个元素, x 的前 L - 1 个元素]
+    MYSTL_TARGET_AVX2 static __m256i shift_in(__m256i prev, __m256i x) {
+        if constexpr(sizeof(T) == 4) {
+            const __m256i p = _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+            const __m256i l = _mm256_permutevar8x32_epi32(prev, _mm256_set1_epi32(7));
+            return _mm256_blend_epi32(p, l, 0x01);
+        }
+        else {
+            const __m256i p = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 3));
+            const __m256i l = _mm256_permute4x64_epi64(prev, _MM_SHUFFLE(3, 3, 3, 3));
+            return _mm256_blend_epi32(p, l, 0x03);
+        }
+    }
+};
+
+// 返回第一个满足 a[i] == a[i + 1] 的 i，不存在时返回 n
+template <class T>
+MYSTL_TARGET_AVX2
+size_t adjacent_find_avx2(const T* a, size_t n) {
+    typedef avx2_neighbor_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    size_t i = 0;
+    for(; i + L < n; i += L) {
+        const __m256i m = ops::eq(ops::load(a + i), ops::load(a + i + 1));
+        const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+        if(bits != 0)
+            return i + mystl::ctz32(bits) / sizeof(T);
+    }
+    for(; i + 1 < n; ++i) {
+        if(a[i] == a[i + 1])
+            return i;
+    }
+    return n;
+}
+
+// 返回第一个满足 a[i] < a[i - 1] 的 i，不存在时返回 n
+template <class T>
+MYSTL_TARGET_AVX2
+size_t is_sorted_until_avx2(const T* a, size_t n) {
+    typedef avx2_neighbor_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    size_t i = 0;
+    for(; i + L < n; i += L) {
+        const __m256i m = ops::gt(ops::load(a + i), ops::load(a + i + 1));
+        const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+        if(bits != 0)
+            return i + 1 + mystl::ctz32(bits) / sizeof(T);
+    }
+    for(; i + 1 < n; ++i) {
+        if(a[i + 1] < a[i])
+            return i + 1;
+    }
+    return n;
+}
+
+// 有序区间去重的流压缩: 保留与前一个元素不相等的元素，out 可以等于 a
+// 原地处理时整块写回的位置不超过已读取的位置，前一块的最后一个元素保存在寄存器中
+// 写到另一块内存时使用 maskstore，只写入保留的元素
+// n 不能为 0，返回保留的元素个数
+template <class T>
+MYSTL_TARGET_AVX2
+size_t unique_avx2(const T* a, size_t n, T* out) {
+    typedef avx2_neighbor_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    constexpr unsigned W = sizeof(T) / 4;    // 每个元素占用的 32 位通道数
+    const bool in_place = static_cast<const T*>(out) == a;
+    out[0] = a[0];
+    size_t k = 1, i = 1;
+    __m256i prev = ops::broadcast(a[0]);
+    for(; i + L <= n; i += L) {
+        const __m256i x = ops::load(a + i);
+        const __m256i p = ops::shift_in(prev, x);
+        const __m256i drop = ops::eq(x, p);
+        const unsigned keep = ~static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(drop))) & 0xffu;
+        const __m256i v = mystl::compress_epi32(x, keep);
+        const unsigned cnt = mystl::popcount32(keep);
+        if(in_place)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), v);
+        else
+            _mm256_maskstore_epi32(reinterpret_cast<int*>(out + k), mystl::prefix_mask_epi32(cnt), v);
+        k += cnt / W;
+        prev = x;
+    }
+    for(; i < n; ++i) {
+        if(a[i] != out[k - 1])
+            out[k++] = a[i];
+    }
+    return k;
+}
+#endif // MYSTL_SIMD_X86
+
+// 原地去重的标量版本，每个元素都写入，只用比较结果移动写位置，没有分支
+template <class T>
+size_t unique_branchless(T* a, size_t n) {
+    size_t k = 1;
+    for(size_t i = 1; i < n; ++i) {
+        const T v = a[i];
+        a[k] = v;
+        k += static_cast<size_t>(v != a[k - 1]);
+    }
+    return k;
+}
+
+
 /*****************************************************************************************/
 // adjacent_find
 // 找出第一对匹配的相邻元素，缺省使用 operator== 比较，如果找到返回一个迭代器，指向这对元素的第一个元素
 /*****************************************************************************************/
 template <class ForwardIter>
-ForwardIter adjacent_find(ForwardIter first, ForwardIter last) {
+ForwardIter unchecked_adjacent_find(ForwardIter first, ForwardIter last) {
     if(first == last)
         return last;
     auto tmp = first;
@@ -486,6 +680,25 @@ ForwardIter adjacent_find(ForwardIter first, ForwardIter last) {
     return last;
 }
 
+// 为连续算术区间提供特化版本
+template <class Tp>
+typename std::enable_if_t<
+    is_neighbor_simd_type<typename std::remove_const_t<Tp>>::value, Tp*>
+    unchecked_adjacent_find(Tp* first, Tp* last) {
+#ifdef MYSTL_SIMD_X86
+        if(mystl::simd_level() >= simd_avx2) {
+            const auto n = static_cast<size_t>(last - first);
+            return first + mystl::adjacent_find_avx2<typename std::remove_const_t<Tp>>(first, n);
+        }
+#endif // MYSTL_SIMD_X86
+        return mystl::unchecked_adjacent_find<Tp*>(first, last);    // 通用版本
+}
+
+template <class ForwardIter>
+ForwardIter adjacent_find(ForwardIter first, ForwardIter last) {
+    return mystl::unchecked_adjacent_find(first, last);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class ForwardIter, class Compared>
 ForwardIter adjacent_find(ForwardIter first, ForwardIter last, Compared comp) {
@@ -517,7 +730,7 @@ ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last,
         middle = first;
         mystl::advance(middle, half);
         if(*middle < value) {
-            first = middle + 1;
+            first = ++middle;
             len = len - half - 1; 
         }
         else 
@@ -564,7 +777,7 @@ ForwardIter lbound_dispatch(ForwardIter first, ForwardIter last,
         middle = first;
         mystl::advance(middle, half);
         if(comp(*middle, value)) {
-            first = middle + 1;
+            first = ++middle;
             len = len - half - 1;
         }
         else 
@@ -613,11 +826,11 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last,
     while(len > 0) {
         half = len >> 1;
         middle = first;
-        mystl::advance(first, half);
+        mystl::advance(middle, half);
         if(value < *middle) 
             len = half;
         else {   
-            first = middle + 1;
+            first = ++middle;
             len = len - half - 1;
         }
     }
@@ -627,8 +840,8 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last,
 // ubound_dispatch 的 random_access_iterator_tag 版本
 template <class RandomIter, class T>
 RandomIter ubound_dispatch(RandomIter first, RandomIter last, 
-        const T& value, random_iterator_tag) {
-    auto len = first - last;
+        const T& value, random_access_iterator_tag) {
+    auto len = last - first;
     auto half = len;
     RandomIter middle;
     while(len > 0) {
@@ -660,11 +873,11 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last,
     while(len > 0) {
         half = len >> 1;
         middle = first;
-        mystl::advance(first, half);
+        mystl::advance(middle, half);
         if(comp(value, *middle)) 
             len = half;
         else {   
-            first = middle + 1;
+            first = ++middle;
             len = len - half - 1;
         }
     }
@@ -674,8 +887,8 @@ ForwardIter ubound_dispatch(ForwardIter first, ForwardIter last,
 // ubound_dispatch 的 random_access_iterator_tag 版本
 template <class RandomIter, class T, class Compared>
 RandomIter ubound_dispatch(RandomIter first, RandomIter last, 
-        const T& value, random_iterator_tag, Compared comp) {
-    auto len = first - last;
+        const T& value, random_access_iterator_tag, Compared comp) {
+    auto len = last - first;
     auto half = len;
     RandomIter middle;
     while(len > 0) {
@@ -703,14 +916,14 @@ ForwardIter upper_bound(ForwardIter first, ForwardIter last,
 // 二分查找，如果在[first, last)内有等同于 value 的元素，返回 true，否则返回 false
 /*****************************************************************************************/
 template <class ForwardIter, class T>
-bool binary_search(ForwardIter first, ForwardIter last, const T& vlaue) {
+bool binary_search(ForwardIter first, ForwardIter last, const T& value) {
     auto tmp = mystl::lower_bound(first, last, value);
     return tmp != last && !(value < *tmp);
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class ForwardIter, class T, class Compared>
-bool binary_search(ForwardIter first, ForwardIter last, const T& vlaue, Compared comp) {
+bool binary_search(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
     auto tmp = mystl::lower_bound(first, last, value);
     return tmp != last && !comp(value, *tmp);
 }
@@ -733,7 +946,7 @@ mystl::pair<ForwardIter, ForwardIter> erange_dispatch(ForwardIter first,
         middle = first;
         mystl::advance(middle, half);
         if(*middle < value) {
-            first = middle + 1;
+            first = ++middle;
             len = len - half - 1;
         }
         else if(value < *middle)
@@ -745,7 +958,7 @@ mystl::pair<ForwardIter, ForwardIter> erange_dispatch(ForwardIter first,
             return mystl::pair<ForwardIter, ForwardIter>(left, right);
         }
     }
-    return mystl::pair<ForwardIter, ForwardIter>(last, last);
+    return mystl::pair<ForwardIter, ForwardIter>(first, first);
 }
 
 // erange_dispatch 的 random_access_iterator_tag 版本
@@ -760,7 +973,7 @@ mystl::pair<RandomIter, RandomIter> erange_dispatch(RandomIter first,
         middle = first + half;
         if(*middle < value) {
             len = len - half - 1;
-            frist = middle + 1;
+            first = middle + 1;
         }
         else if(value < *middle) {
             len = half;
@@ -771,7 +984,7 @@ mystl::pair<RandomIter, RandomIter> erange_dispatch(RandomIter first,
             return mystl::pair<RandomIter, RandomIter>(left, right);
         }
     }
-    return mystl::pair<RandomIter, RandomIter>(last, last);
+    return mystl::pair<RandomIter, RandomIter>(first, first);
 }
 
 template <class ForwardIter, class T>
@@ -793,19 +1006,19 @@ mystl::pair<ForwardIter, ForwardIter> erange_dispatch(ForwardIter first,
         middle = first;
         mystl::advance(middle, half);
         if(comp(*middle, value)) {
-            first = middle + 1;
+            first = ++middle;
             len = len - half - 1;
         }
         else if(comp(value, *middle))
             len = half;
         else {
-            left = mystl::lower_bound(first, middle, value);
+            left = mystl::lower_bound(first, middle, value, comp);
             mystl::advance(first, len);
             right = mystl::upper_bound(++middle, first, value, comp);
             return mystl::pair<ForwardIter, ForwardIter>(left, right);
         }
     }
-    return mystl::pair<ForwardIter, ForwardIter>(last, last);
+    return mystl::pair<ForwardIter, ForwardIter>(first, first);
 }
 
 // erange_dispatch 的 random access iterator 版本
@@ -820,18 +1033,18 @@ mystl::pair<RandomIter, RandomIter> erange_dispatch(RandomIter first,
         middle = first + half;
         if(comp(*middle, value)) {
             len = len - half - 1;
-            frist = middle + 1;
+            first = middle + 1;
         }
         else if(comp(value, *middle)) {
             len = half;
         }
         else {
-            left = mystl::lower_bound(first, middle, value);
-            right = mystl::upper_bound(++middle, first + len, value);
+            left = mystl::lower_bound(first, middle, value, comp);
+            right = mystl::upper_bound(++middle, first + len, value, comp);
             return mystl::pair<RandomIter, RandomIter>(left, right);
         }
     }
-    return mystl::pair<RandomIter, RandomIter>(last, last);
+    return mystl::pair<RandomIter, RandomIter>(first, first);
 }
 
 template <class ForwardIter, class T, class Compared>
@@ -847,7 +1060,7 @@ mystl::pair<ForwardIter, ForwardIter> equal_range(ForwardIter first,
 /*****************************************************************************************/
 template <class ForwardIter, class Generator>
 void generate(ForwardIter first, ForwardIter last, Generator gen) {
-    for(; frist != last; ++first)
+    for(; first != last; ++first)
         *first = gen();
 }
 
@@ -871,10 +1084,10 @@ template <class InputIter1, class InputIter2>
 bool includes(InputIter1 first1, InputIter1 last1,
         InputIter2 first2, InputIter2 last2) {
     while(first2 != last2 && first1 != last1) {
-        if(*frist2 < *first1)
+        if(*first2 < *first1)
             return false;
         else if(*first1 < *first2)
-            ++frist1;
+            ++first1;
         else {
             ++first1; ++first2;
         }
@@ -887,10 +1100,10 @@ template <class InputIter1, class InputIter2, class Compared>
 bool includes(InputIter1 first1, InputIter1 last1,
         InputIter2 first2, InputIter2 last2, Compared comp) {
     while(first2 != last2 && first1 != last1) {
-        if(comp(*frist2, *first1))
+        if(comp(*first2, *first1))
             return false;
         else if(comp(*first1, *first2))
-            ++frist1;
+            ++first1;
         else {
             ++first1; ++first2;
         }
@@ -936,24 +1149,43 @@ bool is_heap(RandomIter first, RandomIter last, Compared comp) {
 // 检查[first, last)内的元素是否升序，如果是升序，则返回 true
 /*****************************************************************************************/
 template <class ForwardIter>
-bool is_sorted(ForwardIter first, ForwardIter last) {
+bool unchecked_is_sorted(ForwardIter first, ForwardIter last) {
     if(first == last)
         return true;
-    auto next = first + 1;
-    for(; next != last; ++next, ++first){
+    auto next = first;
+    for(++next; next != last; ++next, ++first){
         if(*next < *first)
             return false;
     }
     return true;
 }
 
+// 为连续算术区间提供特化版本
+template <class Tp>
+typename std::enable_if_t<
+    is_neighbor_simd_type<typename std::remove_const_t<Tp>>::value, bool>
+    unchecked_is_sorted(Tp* first, Tp* last) {
+#ifdef MYSTL_SIMD_X86
+        if(mystl::simd_level() >= simd_avx2) {
+            const auto n = static_cast<size_t>(last - first);
+            return mystl::is_sorted_until_avx2<typename std::remove_const_t<Tp>>(first, n) == n;
+        }
+#endif // MYSTL_SIMD_X86
+        return mystl::unchecked_is_sorted<Tp*>(first, last);    // 通用版本
+}
+
+template <class ForwardIter>
+bool is_sorted(ForwardIter first, ForwardIter last) {
+    return mystl::unchecked_is_sorted(first, last);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class ForwardIter, class Compared>
 bool is_sorted(ForwardIter first, ForwardIter last, Compared comp) {
     if(first == last)
         return true;
-    auto next = first + 1;
-    for(; next != last; ++next, ++first){
+    auto next = first;
+    for(++next; next != last; ++next, ++first){
         if(comp(*next, *first))
             return false;
     }
@@ -979,7 +1211,7 @@ const T& median(const T& left, const T& mid, const T& right) {
     else if(right < mid)
         return mid;             // r < m <= l;
     else    
-        return rightl           // m  <= r <= l
+        return right;           // m  <= r <= l
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -1001,12 +1233,339 @@ const T& median(const T& left, const T& mid, const T& right, Compared comp) {
 }
 
 
+/*****************************************************************************************/
+// 连续算术区间的极值下标
+// 4 / 8 字节类型: AVX2 的每个通道记录当前极值及其下标，最后在通道之间归约，只需一趟
+// 1 / 2 字节整型: 先用 SIMD 求出极值，再查找它第一次(或最后一次)出现的位置
+// 浮点数中存在 NaN 时返回 false，由调用者退回逐个比较，以保持与通用版本相同的结果
+/*****************************************************************************************/
+template <class T>
+struct is_extremum_simd_type : public m_bool_constant<
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+    (std::is_integral<T>::value || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+#ifdef MYSTL_SIMD_X86
+// 各类型的向量操作，比较结果统一为 __m256i 的全 1 / 全 0 掩码
+// 无符号整型加载时翻转最高位，使有符号比较得到正确的顺序
+template <class T, class = void>
+struct avx2_extremum_ops {};
+
+template <class T>
+struct avx2_extremum_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 4>> {
+    typedef __m256i vec;
+    constexpr static size_t lanes = 8;
+    MYSTL_TARGET_AVX2 static vec load(const T* p) {
+        const vec v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return std::is_signed<T>::value ? v 
+            : _mm256_xor_si256(v, _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+    }
+    MYSTL_TARGET_AVX2 static __m256i gt(vec a, vec b)  { return _mm256_cmpgt_epi32(a, b); }
+    MYSTL_TARGET_AVX2 static vec select(vec a, vec b, __m256i m) { return _mm256_blendv_epi8(a, b, m); }
+    MYSTL_TARGET_AVX2 static __m256i unordered(vec) { return _mm256_setzero_si256(); }
+    MYSTL_TARGET_AVX2 static __m256i first_index()  { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    MYSTL_TARGET_AVX2 static __m256i next_index(__m256i idx) {
+        return _mm256_add_epi32(idx, _mm256_set1_epi32(8));
+    }
+    MYSTL_TARGET_AVX2 static void store_index(__m256i idx, size_t* out) {
+        uint32_t tmp[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp), idx);
+        for(size_t i = 0; i < 8; ++i)
+            out[i] = tmp[i];
+    }
+};
+
+template <class T>
+struct avx2_extremum_ops<T, std::enable_if_t<std::is_integral<T>::value && sizeof(T) == 8>> {
+    typedef __m256i vec;
+    constexpr static size_t lanes = 4;
+    MYSTL_TARGET_AVX2 static vec load(const T* p) {
+        const vec v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        return std::is_signed<T>::value ? v 
+            : _mm256_xor_si256(v, _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull)));
+    }
+    MYSTL_TARGET_AVX2 static __m256i gt(vec a, vec b)  { return _mm256_cmpgt_epi64(a, b); }
+    MYSTL_TARGET_AVX2 static vec select(vec a, vec b, __m256i m) { return _mm256_blendv_epi8(a, b, m); }
+    MYSTL_TARGET_AVX2 static __m256i unordered(vec) { return _mm256_setzero_si256(); }
+    MYSTL_TARGET_AVX2 static __m256i first_index()  { return _mm256_setr_epi64x(0, 1, 2, 3); }
+    MYSTL_TARGET_AVX2 static __m256i next_index(__m256i idx) {
+        return _mm256_add_epi64(idx, _mm256_set1_epi64x(4));
+    }
+    MYSTL_TARGET_AVX2 static void store_index(__m256i idx, size_t* out) {
+        uint64_t tmp[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp), idx);
+        for(size_t i = 0; i < 4; ++i)
+            out[i] = static_cast<size_t>(tmp[i]);
+    }
+};
+
+template <>
+struct avx2_extremum_ops<float, void> {
+    typedef __m256 vec;
+    constexpr static size_t lanes = 8;
+    MYSTL_TARGET_AVX2 static vec load(const float* p) { return _mm256_loadu_ps(p); }
+    MYSTL_TARGET_AVX2 static __m256i gt(vec a, vec b) {
+        return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ));
+    }
+    MYSTL_TARGET_AVX2 static vec select(vec a, vec b, __m256i m) {
+        return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(m));
+    }
+    MYSTL_TARGET_AVX2 static __m256i unordered(vec v) {
+        return _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+    }
+    MYSTL_TARGET_AVX2 static __m256i first_index()  { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+    MYSTL_TARGET_AVX2 static __m256i next_index(__m256i idx) {
+        return _mm256_add_epi32(idx, _mm256_set1_epi32(8));
+    }
+    MYSTL_TARGET_AVX2 static void store_index(__m256i idx, size_t* out) {
+        uint32_t tmp[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp), idx);
+        for(size_t i = 0; i < 8; ++i)
+            out[i] = tmp[i];
+    }
+};
+
+template <>
+struct avx2_extremum_ops<double, void> {
+    typedef __m256d vec;
+    constexpr static size_t lanes = 4;
+    MYSTL_TARGET_AVX2 static vec load(const double* p) { return _mm256_loadu_pd(p); }
+    MYSTL_TARGET_AVX2 static __m256i gt(vec a, vec b) {
+        return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_GT_OQ));
+    }
+    MYSTL_TARGET_AVX2 static vec select(vec a, vec b, __m256i m) {
+        return _mm256_blendv_pd(a, b, _mm256_castsi256_pd(m));
+    }
+    MYSTL_TARGET_AVX2 static __m256i unordered(vec v) {
+        return _mm256_castpd_si256(_mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    }
+    MYSTL_TARGET_AVX2 static __m256i first_index()  { return _mm256_setr_epi64x(0, 1, 2, 3); }
+    MYSTL_TARGET_AVX2 static __m256i next_index(__m256i idx) {
+        return _mm256_add_epi64(idx, _mm256_set1_epi64x(4));
+    }
+    MYSTL_TARGET_AVX2 static void store_index(__m256i idx, size_t* out) {
+        uint64_t tmp[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp), idx);
+        for(size_t i = 0; i < 4; ++i)
+            out[i] = static_cast<size_t>(tmp[i]);
+    }
+};
+
+// 4 / 8 字节类型，单趟记录下标
+// WantMin / WantMax 选择要计算的极值，LastMax 为 true 时最大值取最后一次出现的位置
+template <class T, bool WantMin, bool WantMax, bool LastMax>
+MYSTL_TARGET_AVX2
+bool extremum_index_avx2(const T* a, size_t n, size_t& min_idx, size_t& max_idx) {
+    typedef avx2_extremum_ops<T> ops;
+    typedef typename ops::vec vec;
+    constexpr size_t L = ops::lanes;
+    size_t i = 0;
+    min_idx = max_idx = 0;
+    if(n >= 2 * L) {
+        vec v = ops::load(a);
+        vec vmin = v, vmax = v;
+        __m256i idx = ops::first_index();
+        __m256i imin = idx, imax = idx;
+        __m256i nan = ops::unordered(v);
+        for(i = L; i + L <= n; i += L) {
+            idx = ops::next_index(idx);
+            v = ops::load(a + i);
+            nan = _mm256_or_si256(nan, ops::unordered(v));
+            if constexpr(WantMin) {
+                const __m256i m = ops::gt(vmin, v);
+                vmin = ops::select(vmin, v, m);
+                imin = _mm256_blendv_epi8(imin, idx, m);
+            }
+            if constexpr(WantMax) {
+                const __m256i m = LastMax 
+                    ? _mm256_xor_si256(ops::gt(vmax, v), _mm256_set1_epi32(-1))
+                    : ops::gt(v, vmax);
+                vmax = ops::select(vmax, v, m);
+                imax = _mm256_blendv_epi8(imax, idx, m);
+            }
+        }
+        if(!_mm256_testz_si256(nan, nan))
+            return false;
+        // 通道之间归约，相等时按下标决定
+        size_t lane[L];
+        if constexpr(WantMin) {
+            ops::store_index(imin, lane);
+            min_idx = lane[0];
+            for(size_t l = 1; l < L; ++l) {
+                const size_t j = lane[l];
+                if(a[j] < a[min_idx] || (!(a[min_idx] < a[j]) && j < min_idx))
+                    min_idx = j;
+            }
+        }
+        if constexpr(WantMax) {
+            ops::store_index(imax, lane);
+            max_idx = lane[0];
+            for(size_t l = 1; l < L; ++l) {
+                const size_t j = lane[l];
+                if(a[max_idx] < a[j] || 
+                   (!(a[j] < a[max_idx]) && (LastMax ? j > max_idx : j < max_idx)))
+                    max_idx = j;
+            }
+        }
+    }
+    for(; i < n; ++i) {
+        if(a[i] != a[i])
+            return false;
+        if(a[i] < a[min_idx])
+            min_idx = i;
+        if(LastMax ? !(a[i] < a[max_idx]) : a[max_idx] < a[i])
+            max_idx = i;
+    }
+    return true;
+}
+
+// 1 / 2 字节整型的向量操作
+template <class T>
+struct avx2_narrow_ops {
+    MYSTL_TARGET_AVX2 static __m256i vmin(__m256i a, __m256i b) {
+        if constexpr(sizeof(T) == 1)
+            return std::is_signed<T>::value ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+        else
+            return std::is_signed<T>::value ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+    }
+    MYSTL_TARGET_AVX2 static __m256i vmax(__m256i a, __m256i b) {
+        if constexpr(sizeof(T) == 1)
+            return std::is_signed<T>::value ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+        else
+            return std::is_signed<T>::value ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+    }
+    MYSTL_TARGET_AVX2 static __m256i eq(__m256i a, __m256i b) {
+        if constexpr(sizeof(T) == 1)
+            return _mm256_cmpeq_epi8(a, b);
+        else
+            return _mm256_cmpeq_epi16(a, b);
+    }
+    MYSTL_TARGET_AVX2 static __m256i set1(T v) {
+        if constexpr(sizeof(T) == 1)
+            return _mm256_set1_epi8(static_cast<char>(v));
+        else
+            return _mm256_set1_epi16(static_cast<short>(v));
+    }
+};
+
+// 在 [0, n) 中查找第一个等于 value 的位置，一定存在
+template <class T>
+MYSTL_TARGET_AVX2
+size_t narrow_find_first(const T* a, size_t n, T value) {
+    typedef avx2_narrow_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    const __m256i v = ops::set1(value);
+    size_t i = 0;
+    for(; i + L <= n; i += L) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(ops::eq(x, v)));
+        if(m != 0)
+            return i + mystl::ctz32(m) / sizeof(T);
+    }
+    while(a[i] != value)
+        ++i;
+    return i;
+}
+
+// 在 [0, n) 中查找最后一个等于 value 的位置，一定存在
+template <class T>
+MYSTL_TARGET_AVX2
+size_t narrow_find_last(const T* a, size_t n, T value) {
+    typedef avx2_narrow_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    const __m256i v = ops::set1(value);
+    size_t i = n;
+    for(; i >= L; i -= L) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i - L));
+        const uint32_t m = static_cast<uint32_t>(_mm256_movemask_epi8(ops::eq(x, v)));
+        if(m != 0)
+            return i - L + (31 - mystl::clz32(m)) / sizeof(T);
+    }
+    while(a[--i] != value) {}
+    return i;
+}
+
+// 1 / 2 字节整型，先求极值再查找位置
+template <class T, bool WantMin, bool WantMax, bool LastMax>
+MYSTL_TARGET_AVX2
+bool extremum_index_avx2_narrow(const T* a, size_t n, size_t& min_idx, size_t& max_idx) {
+    typedef avx2_narrow_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    T lo = a[0], hi = a[0];
+    size_t i = 0;
+    if(n >= L) {
+        __m256i vmin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i vmax = vmin;
+        for(i = L; i + L <= n; i += L) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            vmin = ops::vmin(vmin, x);
+            vmax = ops::vmax(vmax, x);
+        }
+        T lane[L];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), vmin);
+        for(size_t l = 0; l < L; ++l)
+            lo = lane[l] < lo ? lane[l] : lo;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane), vmax);
+        for(size_t l = 0; l < L; ++l)
+            hi = hi < lane[l] ? lane[l] : hi;
+    }
+    for(; i < n; ++i) {
+        lo = a[i] < lo ? a[i] : lo;
+        hi = hi < a[i] ? a[i] : hi;
+    }
+    min_idx = max_idx = 0;
+    if constexpr(WantMin)
+        min_idx = mystl::narrow_find_first(a, n, lo);
+    if constexpr(WantMax)
+        max_idx = LastMax ? mystl::narrow_find_last(a, n, hi) : mystl::narrow_find_first(a, n, hi);
+    return true;
+}
+#endif // MYSTL_SIMD_X86
+
+// 根据 CPU 特性选择内核，n 不能为 0，返回 false 时调用者使用通用版本
+template <class T, bool WantMin, bool WantMax, bool LastMax>
+bool simd_extremum_index(const T* a, size_t n, size_t& min_idx, size_t& max_idx) {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2) {
+        if constexpr(sizeof(T) <= 2) {
+            return mystl::extremum_index_avx2_narrow<T, WantMin, WantMax, LastMax>(
+                a, n, min_idx, max_idx);
+        }
+        else {
+            // 4 字节类型的通道下标为 32 位，按块处理后再合并
+            constexpr size_t chunk = sizeof(T) == 4 ? (static_cast<size_t>(1) << 31) : ~static_cast<size_t>(0);
+            for(size_t base = 0; base < n; ) {
+                const size_t len = n - base < chunk ? n - base : chunk;
+                size_t lo, hi;
+                if(!mystl::extremum_index_avx2<T, WantMin, WantMax, LastMax>(a + base, len, lo, hi))
+                    return false;
+                lo += base; hi += base;
+                if(base == 0) {
+                    min_idx = lo; max_idx = hi;
+                }
+                else {
+                    if(a[lo] < a[min_idx])
+                        min_idx = lo;
+                    if(LastMax ? !(a[hi] < a[max_idx]) : a[max_idx] < a[hi])
+                        max_idx = hi;
+                }
+                base += len;
+            }
+            return true;
+        }
+    }
+#else
+    (void)a; (void)n; (void)min_idx; (void)max_idx;
+#endif // MYSTL_SIMD_X86
+    return false;
+}
+
+
 /*****************************************************************************************/
 // max_element
 // 返回一个迭代器，指向序列中最大的元素
 /*****************************************************************************************/
 template <class ForwardIter>
-ForwardIter max_element(ForwardIter first, ForwardIter last) {
+ForwardIter unchecked_max_element(ForwardIter first, ForwardIter last) {
     if(first == last)
         return last;
     auto result = first;
@@ -1017,6 +1576,26 @@ ForwardIter max_element(ForwardIter first, ForwardIter last) {
     return result;
 }
 
+// 为连续算术区间提供特化版本
+template <class Tp>
+typename std::enable_if_t<
+    is_extremum_simd_type<typename std::remove_const_t<Tp>>::value, Tp*>
+    unchecked_max_element(Tp* first, Tp* last) {
+        typedef typename std::remove_const_t<Tp> value_type;
+        if(first == last)
+            return last;
+        size_t lo, hi;
+        if(mystl::simd_extremum_index<value_type, false, true, false>(
+            first, static_cast<size_t>(last - first), lo, hi))
+            return first + hi;
+        return mystl::unchecked_max_element<Tp*>(first, last);    // 通用版本
+}
+
+template <class ForwardIter>
+ForwardIter max_element(ForwardIter first, ForwardIter last) {
+    return mystl::unchecked_max_element(first, last);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class ForwardIter, class Compared>
 ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp) {
@@ -1036,7 +1615,7 @@ ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp) {
 // 返回一个迭代器，指向序列中最小的元素
 /*****************************************************************************************/
 template <class ForwardIter>
-ForwardIter min_element(ForwardIter first, ForwardIter last) {
+ForwardIter unchecked_min_element(ForwardIter first, ForwardIter last) {
     if(first == last)
         return last;
     auto result = first;
@@ -1047,6 +1626,26 @@ ForwardIter min_element(ForwardIter first, ForwardIter last) {
     return result;
 }
 
+// 为连续算术区间提供特化版本
+template <class Tp>
+typename std::enable_if_t<
+    is_extremum_simd_type<typename std::remove_const_t<Tp>>::value, Tp*>
+    unchecked_min_element(Tp* first, Tp* last) {
+        typedef typename std::remove_const_t<Tp> value_type;
+        if(first == last)
+            return last;
+        size_t lo, hi;
+        if(mystl::simd_extremum_index<value_type, true, false, false>(
+            first, static_cast<size_t>(last - first), lo, hi))
+            return first + lo;
+        return mystl::unchecked_min_element<Tp*>(first, last);    // 通用版本
+}
+
+template <class ForwardIter>
+ForwardIter min_element(ForwardIter first, ForwardIter last) {
+    return mystl::unchecked_min_element(first, last);
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class ForwardIter, class Compared>
 ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp) {
@@ -1061,6 +1660,75 @@ ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp) {
 }
 
 
+/*****************************************************************************************/
+// minmax_element
+// 一趟求出最小和最大的元素，返回 pair，first 指向第一个最小的元素，second 指向最后一个最大的元素
+// 每次取两个元素，先比较二者，再分别与当前最小、最大值比较，共约 3n/2 次比较
+/*****************************************************************************************/
+template <class ForwardIter, class Compared>
+mystl::pair<ForwardIter, ForwardIter>
+    minmax_element(ForwardIter first, ForwardIter last, Compared comp) {
+    mystl::pair<ForwardIter, ForwardIter> result(first, first);
+    if(first == last || ++first == last)
+        return result;
+    // 先处理前两个元素
+    if(comp(*first, *result.first))
+        result.first = first;
+    else
+        result.second = first;
+    while(++first != last) {
+        auto i = first;
+        if(++first == last) {
+            // 剩余一个元素
+            if(comp(*i, *result.first))
+                result.first = i;
+            else if(!comp(*i, *result.second))
+                result.second = i;
+            break;
+        }
+        if(comp(*first, *i)) {
+            if(comp(*first, *result.first))
+                result.first = first;
+            if(!comp(*i, *result.second))
+                result.second = i;
+        }
+        else {
+            if(comp(*i, *result.first))
+                result.first = i;
+            if(!comp(*first, *result.second))
+                result.second = first;
+        }
+    }
+    return result;
+}
+
+template <class ForwardIter>
+mystl::pair<ForwardIter, ForwardIter>
+    unchecked_minmax_element(ForwardIter first, ForwardIter last) {
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::minmax_element(first, last, mystl::less<value_type>());
+}
+
+// 为连续算术区间提供特化版本
+template <class Tp>
+typename std::enable_if_t<
+    is_extremum_simd_type<typename std::remove_const_t<Tp>>::value, mystl::pair<Tp*, Tp*>>
+    unchecked_minmax_element(Tp* first, Tp* last) {
+        typedef typename std::remove_const_t<Tp> value_type;
+        size_t lo, hi;
+        if(first != last && mystl::simd_extremum_index<value_type, true, true, true>(
+            first, static_cast<size_t>(last - first), lo, hi))
+            return mystl::pair<Tp*, Tp*>(first + lo, first + hi);
+        return mystl::minmax_element(first, last, mystl::less<value_type>());
+}
+
+template <class ForwardIter>
+mystl::pair<ForwardIter, ForwardIter>
+    minmax_element(ForwardIter first, ForwardIter last) {
+    return mystl::unchecked_minmax_element(first, last);
+}
+
+
 /*****************************************************************************************/
 // swap_ranges
 // 将[first1, last1)从 first2 开始，交换相同个数元素
@@ -1068,7 +1736,7 @@ ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp) {
 /*****************************************************************************************/
 template <class ForwardIter1, class ForwardIter2>
 ForwardIter2 swap_ranges(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2) {
-    for(; frist1 != last1; ++frist1, ++first2) {
+    for(; first1 != last1; ++first1, ++first2) {
         mystl::iter_swap(first1, first2);
     }
     return first2;
@@ -1104,7 +1772,7 @@ OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
 // 移除区间内与指定 value 相等的元素，并将结果复制到以 result 标示起始位置的容器上
 /*****************************************************************************************/
 template <class InputIter, class OutputIter, class T>
-OutputIter remove_copy(InputIter first, InputIter last, 
+OutputIter unchecked_remove_copy(InputIter first, InputIter last, 
         OutputIter result, const T& value) {
     for(; first != last; ++first) {
         if(*first != value) {
@@ -1115,6 +1783,24 @@ OutputIter remove_copy(InputIter first, InputIter last,
     return result;
 }
 
+// 为可以逐字节复制的类型提供特化版本，转换为与 value 的比较谓词后流压缩
+template <class Tp, class Up>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Up>::value &&
+    is_compact_type<Up>::value, Up*>
+    unchecked_remove_copy(Tp* first, Tp* last, Up* result, const Up& value) {
+        auto pred = mystl::bind2nd(mystl::equal_to<Up>(), value);
+        const auto n = static_cast<size_t>(last - first);
+        return result + mystl::compact_copy<false, true>(first, n,
+            static_cast<Up*>(nullptr), result, pred).second;
+}
+
+template <class InputIter, class OutputIter, class T>
+OutputIter remove_copy(InputIter first, InputIter last, 
+        OutputIter result, const T& value) {
+    return mystl::unchecked_remove_copy(first, last, result, value);
+}
+
 
 /*****************************************************************************************/
 // remove
@@ -1122,19 +1808,37 @@ OutputIter remove_copy(InputIter first, InputIter last,
 // 并不从容器中删除这些元素，所以 remove 和 remove_if 不适用于 array
 /*****************************************************************************************/
 template <class ForwardIter, class T>
-ForwardIter remove(ForwardIter first, ForwardIter last, const T& value) {
+ForwardIter unchecked_remove(ForwardIter first, ForwardIter last, const T& value) {
     first = mystl::find(first, last, value);
     auto next = first;
     return first == last ? first : mystl::remove_copy(++next, last, first, value);
 }
 
+// 为可以逐字节复制的类型提供特化版本，原地流压缩
+// 从第一个被移除的元素之后开始压缩，写到该元素的位置，每个元素只比较一次
+template <class Tp>
+typename std::enable_if_t<is_compact_type<Tp>::value && !std::is_const<Tp>::value, Tp*>
+    unchecked_remove(Tp* first, Tp* last, const Tp& value) {
+        first = mystl::find(first, last, value);
+        if(first == last)
+            return last;
+        auto pred = mystl::bind2nd(mystl::equal_to<Tp>(), value);
+        return first + mystl::compact_in_place<false>(first, first + 1,
+            static_cast<size_t>(last - first - 1), pred);
+}
+
+template <class ForwardIter, class T>
+ForwardIter remove(ForwardIter first, ForwardIter last, const T& value) {
+    return mystl::unchecked_remove(first, last, value);
+}
+
 
 /*****************************************************************************************/
 // remove_copy_if
 // 移除区间内所有令一元操作 unary_pred 为 true 的元素，并将结果复制到以 result 为起始位置的容器上
 /*****************************************************************************************/
 template <class InputIter, class OutputIter, class UnaryPredicate>
-OutputIter remove_copy(InputIter first, InputIter last, 
+OutputIter unchecked_remove_copy_if(InputIter first, InputIter last, 
         OutputIter result, UnaryPredicate unary_pred) {
     for(; first != last; ++first) {
         if(!unary_pred(*first)) {
@@ -1145,18 +1849,52 @@ OutputIter remove_copy(InputIter first, InputIter last,
     return result;
 }
 
+// 为可以逐字节复制的类型提供特化版本
+template <class Tp, class Up, class UnaryPredicate>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Up>::value &&
+    is_compact_type<Up>::value, Up*>
+    unchecked_remove_copy_if(Tp* first, Tp* last, Up* result, UnaryPredicate unary_pred) {
+        const auto n = static_cast<size_t>(last - first);
+        return result + mystl::compact_copy<false, true>(first, n,
+            static_cast<Up*>(nullptr), result, unary_pred).second;
+}
+
+template <class InputIter, class OutputIter, class UnaryPredicate>
+OutputIter remove_copy_if(InputIter first, InputIter last, 
+        OutputIter result, UnaryPredicate unary_pred) {
+    return mystl::unchecked_remove_copy_if(first, last, result, unary_pred);
+}
+
 
 /*****************************************************************************************/
 // remove_if
 // 移除区间内所有令一元操作 unary_pred 为 true 的元素
 /*****************************************************************************************/
 template <class ForwardIter, class UnaryPredicate>
-ForwardIter remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
-    first = mystl::find(first, last, value);
+ForwardIter unchecked_remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+    first = mystl::find_if(first, last, unary_pred);
     auto next = first;
     return first == last ? first : mystl::remove_copy_if(++next, last, first, unary_pred);
 }
 
+// 为可以逐字节复制的类型提供特化版本，原地流压缩
+// 从第一个被移除的元素之后开始压缩，写到该元素的位置，谓词对每个元素只调用一次
+template <class Tp, class UnaryPredicate>
+typename std::enable_if_t<is_compact_type<Tp>::value && !std::is_const<Tp>::value, Tp*>
+    unchecked_remove_if(Tp* first, Tp* last, UnaryPredicate unary_pred) {
+        first = mystl::find_if(first, last, unary_pred);
+        if(first == last)
+            return last;
+        return first + mystl::compact_in_place<false>(first, first + 1,
+            static_cast<size_t>(last - first - 1), unary_pred);
+}
+
+template <class ForwardIter, class UnaryPredicate>
+ForwardIter remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+    return mystl::unchecked_remove_if(first, last, unary_pred);
+}
+
 
 /*****************************************************************************************/
 // replace
@@ -1177,7 +1915,7 @@ void replace(InputIter first, InputIter last,
 // 行为与 replace 类似，不同的是将结果复制到 result 所指的容器中，原序列没有改变
 /*****************************************************************************************/
 template <class InputIter, class OutputIter, class T>
-void replace_copy(InputIter first, InputIter last, OutputIter result, 
+OutputIter replace_copy(InputIter first, InputIter last, OutputIter result, 
         const T& old_value, const T& new_value) {
     for(; first != last; ++first, ++result) {
         *result = *first == old_value ? new_value : *first;
@@ -1221,8 +1959,8 @@ void replace_if(InputIter first, InputIter last, UnaryPredicate unary_pred,
 template <class BiIter>
 void reverse_dispatch(BiIter first, BiIter last, bidirectional_iterator_tag) {
     while(true) {
-        if(first == last || frist == --last)
-            retrun;
+        if(first == last || first == --last)
+            return;
         mystl::iter_swap(first++, last);
     }
 }
@@ -1245,7 +1983,7 @@ void reverse(BiIter first, BiIter last) {
 // 行为与 reverse 类似，不同的是将结果复制到 result 所指容器中
 /*****************************************************************************************/
 template <class BiIter, class OutputIter>
-OutputIter reversr_copy(BiIter first, BiIter last, OutputIter result) {
+OutputIter reverse_copy(BiIter first, BiIter last, OutputIter result) {
     while(first != last) {
         --last;
         *result = *last;
@@ -1316,9 +2054,10 @@ BiIter rotate_dispatch(BiIter first, BiIter middle, BiIter last,
     mystl::reverse_dispatch(middle, last, bidirectional_iterator_tag());
     while(first != middle && last != middle)
         mystl::swap(*first++, *--last);
-    if(first == middle) 
+    if(first == middle) {
         mystl::reverse_dispatch(middle, last, bidirectional_iterator_tag());
         return last;
+    }
     else {
         mystl::reverse_dispatch(first, middle, bidirectional_iterator_tag());
         return first;
@@ -1343,39 +2082,39 @@ RandomIter rotate_dispatch(RandomIter first, RandomIter middle,
     auto n = last -first;
     auto l = middle - first;
     auto r = n - l;
-    auto result = first + last - middle;
+    auto result = first + (last - middle);
     if(l == r) {
         mystl::swap_ranges(first, middle, middle);
         return result;
     }
-    auto cycle_times = rgcd(l,n);
-    for(auto i = 0; i < cycle_times; ++i) {
-        auto tmp = *first;
+    auto cycle_times = rgcd(n, l);
+    for(decltype(n) i = 0; i < cycle_times; ++i) {
+        auto tmp = mystl::move(*first);
         auto p = first;
         if(l < r) {
-            for(auto j = 0; j < r / cycle_times; ++j) {
+            for(decltype(n) j = 0; j < r / cycle_times; ++j) {
                 if(p > first + r) {
-                    *p = *(p - r);
+                    *p = mystl::move(*(p - r));
                     p -= r;
                 }
-                *p = *(p + l);
+                *p = mystl::move(*(p + l));
                 p += l;
             }
         }
         else {
-            for(auto j = 0; j < l / cycle_times; ++j) {
+            for(decltype(n) j = 0; j < l / cycle_times - 1; ++j) {
                 if(p < last - l) {
-                    *p = *(p + l);
+                    *p = mystl::move(*(p + l));
                     p += l;
                 }
-                *p = *(p - r);
+                *p = mystl::move(*(p - r));
                 p -= r;
             }
         }
-        *p = tmp;
+        *p = mystl::move(tmp);
         ++first;
     }
-    return first;
+    return result;
 }
 
 template <class ForwardIter>
@@ -1393,8 +2132,8 @@ ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last) {
 // 行为与 rotate 类似，不同的是将结果复制到 result 所指的容器中
 /*****************************************************************************************/
 template <class ForwardIter, class OutputIter>
-ForwardIter rotate_copy(ForwardIter first1, ForwardIter last1,
-        ForwardIter first2, ForwardIter last2) {
+OutputIter rotate_copy(ForwardIter first, ForwardIter middle, ForwardIter last,
+        OutputIter result) {
     return mystl::copy(first, middle, mystl::copy(middle, last, result));
 }
 
@@ -1423,7 +2162,7 @@ bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1,
     // 比较剩余部分长度
     if(is_ra_it) {
         if(first1 == last1)
-            return ture;
+            return true;
     }
     else {
         auto len1 = mystl::distance(first1, last1);
@@ -1437,21 +2176,21 @@ bool is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1,
     // 判断剩余部分
     for(auto i = first1; i != last1; ++i) {
         bool is_repeated = false;
-        // 剩余部分中=*i的位置
-        for(auto j = first2; j != last2; ++j) {
-            if(pred(*i, *j)) {
+        // *i 是否已在 [first1, i) 中出现过，出现过的值已经统计
+        for(auto j = first1; j != i; ++j) {
+            if(pred(*j, *i)) {
                 is_repeated = true;
                 break;
             }
         }
         if(!is_repeated) {
-            auto count = 0;
+            auto count2 = 0;
             // iter2中*i在 [mark, last2) 的数目
             for(auto j = first2; j != last2; ++j) {
                 if(pred(*i, *j)) 
-                    ++count;
+                    ++count2;
             }
-            if(count == 0)
+            if(count2 == 0)
                 return false;
             
             auto count1 = 1;
@@ -1682,13 +2421,13 @@ BiIter1 merge_backward(BiIter1 first1, BiIter1 last1,
             *--result = *last1;
             if(first1 == last1)
                 return mystl::copy_backward(first2, ++last2, result);
-                --last1;
+            --last1;
         }
         else {
             *--result = *last2;
-            if(first1 == last1)
+            if(first2 == last2)
                 return mystl::copy_backward(first1, ++last1, result);
-                --last2;
+            --last2;
         }
     }
 }
@@ -1755,7 +2494,7 @@ void merge_adaptive(BiIter first, BiIter middle, BiIter last, Distance len1,
 template <class BiIter, class T>
 void inplace_merge_aux(BiIter first, BiIter middle, BiIter last, T*) {
     auto len1 = mystl::distance(first, middle);
-    auto len1 = mystl::distance(middle, last);
+    auto len2 = mystl::distance(middle, last);
     temporary_buffer<BiIter, T> buf(first, last);
     if(!buf.begin()) {
         mystl::merge_without_buffer(first, middle, last, len1, len2);
@@ -1769,7 +2508,7 @@ template <class BiIter>
 void inplace_merge(BiIter first, BiIter middle, BiIter last) {
     if(first == middle || middle == last)
         return;
-    mystl::inplace_merge_aux(first, middle, last, vlaue_type(first));
+    mystl::inplace_merge_aux(first, middle, last, mystl::value_type(first));
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -1809,7 +2548,7 @@ void merge_without_buffer(BiIter first, BiIter middle, BiIter last,
 
 template <class BiIter1, class BiIter2, class Compared>
 BiIter1 merge_backward(BiIter1 first1, BiIter1 last1,
-        BiIter2 first2, BiIter2 last2, BiIter1 result) {
+        BiIter2 first2, BiIter2 last2, BiIter1 result, Compared comp) {
     if(first1 == last1)
         return mystl::copy_backward(first2, last2, result);
     if(first2 == last2)
@@ -1821,13 +2560,13 @@ BiIter1 merge_backward(BiIter1 first1, BiIter1 last1,
             *--result = *last1;
             if(first1 == last1)
                 return mystl::copy_backward(first2, ++last2, result);
-                --last1;
+            --last1;
         }
         else {
             *--result = *last2;
-            if(first1 == last1)
+            if(first2 == last2)
                 return mystl::copy_backward(first1, ++last1, result);
-                --last2;
+            --last2;
         }
     }
 }
@@ -1877,7 +2616,7 @@ void merge_adaptive(BiIter first, BiIter middle, BiIter last, Distance len1,
 template <class BiIter, class T, class Compared>
 void inplace_merge_aux(BiIter first, BiIter middle, BiIter last, T*, Compared comp) {
     auto len1 = mystl::distance(first, middle);
-    auto len1 = mystl::distance(middle, last);
+    auto len2 = mystl::distance(middle, last);
     temporary_buffer<BiIter, T> buf(first, last);
     if(!buf.begin()) {
         mystl::merge_without_buffer(first, middle, last, len1, len2, comp);
@@ -1891,7 +2630,7 @@ template <class BiIter, class Compared>
 void inplace_merge(BiIter first, BiIter middle, BiIter last, Compared comp) {
     if(first == middle || middle == last)
         return;
-    mystl::inplace_merge_aux(first, middle, last, vlaue_type(first), comp);
+    mystl::inplace_merge_aux(first, middle, last, mystl::value_type(first), comp);
 }
 
 
@@ -1901,10 +2640,12 @@ void inplace_merge(BiIter first, BiIter middle, BiIter last, Compared comp) {
 /*****************************************************************************************/
 template <class RandomIter>
 void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
+    if(first == middle)
+        return;
     mystl::make_heap(first, middle);
     for(auto i = middle; i < last; ++i) {
         if(*i < *first)
-            mystl::pop_heap_aux(first, middle, i, *i, distance_type(first));
+            mystl::pop_heap_aux(first, middle, i, mystl::move(*i), distance_type(first));
     }
     mystl::sort_heap(first, middle);
 }
@@ -1912,10 +2653,12 @@ void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
 // 重载版本使用函数对象 comp 代替比较操作
 template <class RandomIter, class Compared>
 void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
-    mystl::make_heap(first, middle);
+    if(first == middle)
+        return;
+    mystl::make_heap(first, middle, comp);
     for(auto i = middle; i < last; ++i) {
         if(comp(*i, *first))
-            mystl::pop_heap_aux(first, middle, i, *i, distance_type(first), comp);
+            mystl::pop_heap_aux(first, middle, i, mystl::move(*i), distance_type(first), comp);
     }
     mystl::sort_heap(first, middle, comp);
 }
@@ -1932,7 +2675,7 @@ RandomIter psort_copy_aux(InputIter first, InputIter last, RandomIter result_fir
         return result_last;
     auto result_iter = result_first;
     while(first != last && result_iter != result_last) {
-        *result_iter = *firstl
+        *result_iter = *first;
         ++result_iter;
         ++first;
     }
@@ -1962,7 +2705,7 @@ RandomIter psort_copy_aux(InputIter first, InputIter last, RandomIter result_fir
         return result_last;
     auto result_iter = result_first;
     while(first != last && result_iter != result_last) {
-        *result_iter = *firstl
+        *result_iter = *first;
         ++result_iter;
         ++first;
     }
@@ -1990,8 +2733,12 @@ RandomIter partial_sort_copy(InputIter first, InputIter last,
 // 对区间内的元素重排，被一元条件运算判定为 true 的元素会放到区间的前段
 // 该函数不保证元素的原始相对位置
 /*****************************************************************************************/
+constexpr static size_t kPartitionBlock = 64;    // 分块 partition 每块的元素个数
+
+// partition_dispatch 的 bidirectional_iterator_tag 版本
 template <class BiIter, class UnaryPredicate>
-BiIter partition(BiIter first, BiIter last, UnaryPredicate unary_pred) {
+BiIter partition_dispatch(BiIter first, BiIter last, UnaryPredicate& unary_pred,
+        bidirectional_iterator_tag) {
     while(true) {
         while(first != last && unary_pred(*first))
             ++first;
@@ -2008,6 +2755,305 @@ BiIter partition(BiIter first, BiIter last, UnaryPredicate unary_pred) {
     return first;
 }
 
+// partition_dispatch 的 random_access_iterator_tag 版本
+// 分块处理: 左右两端各取一块，先无分支地记下放错位置的元素在块内的偏移，再成对交换
+// 谓词的结果不再决定分支，避免选择率接近 50% 时频繁的分支预测失败
+// [first, l) 内的元素都令谓词为 true，[r, last) 内的元素都令谓词为 false
+template <class RandomIter, class UnaryPredicate>
+RandomIter partition_dispatch(RandomIter first, RandomIter last, UnaryPredicate& unary_pred,
+        random_access_iterator_tag) {
+    constexpr size_t B = kPartitionBlock;
+    unsigned char offsets_l[B];
+    unsigned char offsets_r[B];
+    size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+    RandomIter l = first, r = last;
+    while(r - l > static_cast<ptrdiff_t>(2 * B)) {
+        if(num_l == 0) {
+            start_l = 0;
+            for(size_t i = 0; i < B; ++i) {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !unary_pred(l[i]);
+            }
+        }
+        if(num_r == 0) {
+            start_r = 0;
+            for(size_t i = 0; i < B; ++i) {
+                offsets_r[num_r] = static_cast<unsigned char>(i);
+                num_r += static_cast<bool>(unary_pred(*(r - 1 - i)));
+            }
+        }
+        const size_t num = num_l < num_r ? num_l : num_r;
+        for(size_t k = 0; k < num; ++k)
+            mystl::iter_swap(l + offsets_l[start_l + k], r - 1 - offsets_r[start_r + k]);
+        num_l -= num; num_r -= num;
+        start_l += num; start_r += num;
+        if(num_l == 0)
+            l += B;
+        if(num_r == 0)
+            r -= B;
+    }
+    // 剩余不超过两块: 尚未分类的部分作为最后的左块 / 右块，已记下的偏移直接使用，不再调用谓词
+    const size_t rest = static_cast<size_t>(r - l);
+    const size_t bl = num_l != 0 ? B : num_r != 0 ? rest - B : rest / 2;
+    const size_t br = rest - bl;
+    if(num_l == 0) {
+        start_l = 0;
+        for(size_t i = 0; i < bl; ++i) {
+            offsets_l[num_l] = static_cast<unsigned char>(i);
+            num_l += !unary_pred(l[i]);
+        }
+    }
+    if(num_r == 0) {
+        start_r = 0;
+        for(size_t i = 0; i < br; ++i) {
+            offsets_r[num_r] = static_cast<unsigned char>(i);
+            num_r += static_cast<bool>(unary_pred(*(r - 1 - i)));
+        }
+    }
+    const size_t num = num_l < num_r ? num_l : num_r;
+    for(size_t k = 0; k < num; ++k)
+        mystl::iter_swap(l + offsets_l[start_l + k], r - 1 - offsets_r[start_r + k]);
+    num_l -= num; num_r -= num;
+    start_l += num; start_r += num;
+    if(num_l != 0) {
+        // 右块已全部为 false，把左块中剩下的 false 元素从右往左依次换到左块末尾
+        RandomIter hi = l + bl;
+        while(num_l != 0) {
+            --num_l;
+            mystl::iter_swap(l + offsets_l[start_l + num_l], --hi);
+        }
+        return hi;
+    }
+    // 左块已全部为 true，把右块中剩下的 true 元素从左往右依次换到右块开头
+    RandomIter lo = l + bl;
+    while(num_r != 0) {
+        --num_r;
+        mystl::iter_swap(r - 1 - offsets_r[start_r + num_r], lo);
+        ++lo;
+    }
+    return lo;
+}
+
+template <class BiIter, class UnaryPredicate>
+BiIter partition(BiIter first, BiIter last, UnaryPredicate unary_pred) {
+    return mystl::partition_dispatch(first, last, unary_pred, iterator_category(first));
+}
+
+
+/*****************************************************************************************/
+// stable_partition
+// 与 partition 相同，但保持元素的原始相对位置
+// 有缓冲区时一趟完成，缓冲区不足时分治后用 rotate 合并两半
+/*****************************************************************************************/
+// 跳过 [first, first + len) 中令谓词为 true 的前缀，len 减去跳过的个数
+template <class ForwardIter, class UnaryPredicate, class Distance>
+ForwardIter stable_partition_skip(ForwardIter first, UnaryPredicate& unary_pred, Distance& len) {
+    while(len != 0 && unary_pred(*first)) {
+        ++first;
+        --len;
+    }
+    return first;
+}
+
+// 以下两个函数要求 *first 已知令谓词为 false，len >= 1，每个元素只调用一次谓词
+// 没有缓冲区的情况下，分治并用 rotate 合并，len 为区间长度
+template <class BiIter, class UnaryPredicate, class Distance>
+BiIter stable_partition_without_buffer(BiIter first, BiIter last, UnaryPredicate& unary_pred,
+        Distance len) {
+    if(len == 1)
+        return first;
+    auto middle = first;
+    mystl::advance(middle, len / 2);
+    auto left = mystl::stable_partition_without_buffer(first, middle, unary_pred, len / 2);
+    Distance right_len = len - len / 2;
+    auto right = mystl::stable_partition_skip(middle, unary_pred, right_len);
+    if(right_len != 0)
+        right = mystl::stable_partition_without_buffer(right, last, unary_pred, right_len);
+    return mystl::rotate(left, middle, right);
+}
+
+// 有缓冲区的情况下，令谓词为 true 的元素前移，其余元素暂存到缓冲区后再移回
+// 可以逐字节复制的类型两边都写入，只用谓词结果移动写位置
+// 区间长度超过缓冲区时分治，用 rotate_adaptive 合并两半
+template <class BiIter, class UnaryPredicate, class Distance, class Pointer>
+BiIter stable_partition_adaptive(BiIter first, BiIter last, UnaryPredicate& unary_pred,
+        Distance len, Pointer buffer, Distance buffer_size) {
+    if(len <= buffer_size) {
+        auto result1 = first;
+        auto result2 = buffer;
+        *result2 = mystl::move(*first);
+        ++result2;
+        ++first;
+        typedef typename iterator_traits<BiIter>::value_type value_type;
+        if constexpr(std::is_trivially_copyable<value_type>::value) {
+            for(; first != last; ++first) {
+                const value_type v = *first;
+                const bool p = static_cast<bool>(unary_pred(v));
+                *result1 = v;
+                *result2 = v;
+                if constexpr(is_random_access_iterator<BiIter>::value)
+                    result1 += p;
+                else if(p)
+                    ++result1;
+                result2 += !p;
+            }
+        }
+        else {
+            for(; first != last; ++first) {
+                if(unary_pred(*first)) {
+                    *result1 = mystl::move(*first);
+                    ++result1;
+                }
+                else {
+                    *result2 = mystl::move(*first);
+                    ++result2;
+                }
+            }
+        }
+        mystl::move(buffer, result2, result1);
+        return result1;
+    }
+    auto middle = first;
+    mystl::advance(middle, len / 2);
+    auto left = mystl::stable_partition_adaptive(first, middle, unary_pred,
+        Distance(len / 2), buffer, buffer_size);
+    Distance right_len = len - len / 2;
+    auto right = mystl::stable_partition_skip(middle, unary_pred, right_len);
+    if(right_len != 0)
+        right = mystl::stable_partition_adaptive(right, last, unary_pred,
+            right_len, buffer, buffer_size);
+    return mystl::rotate_adaptive(left, middle, right, Distance(mystl::distance(left, middle)),
+        Distance(mystl::distance(middle, right)), buffer, buffer_size);
+}
+
+template <class BiIter, class UnaryPredicate, class T>
+BiIter stable_partition_aux(BiIter first, BiIter last, UnaryPredicate& unary_pred, T*) {
+    typedef typename iterator_traits<BiIter>::difference_type distance_type;
+    const distance_type len = mystl::distance(first, last);
+    temporary_buffer<BiIter, T> buf(first, last);
+    if(!buf.begin())
+        return mystl::stable_partition_without_buffer(first, last, unary_pred, len);
+    return mystl::stable_partition_adaptive(first, last, unary_pred, len,
+        buf.begin(), static_cast<distance_type>(buf.size()));
+}
+
+template <class BiIter, class UnaryPredicate>
+BiIter stable_partition(BiIter first, BiIter last, UnaryPredicate unary_pred) {
+    // 跳过已经在正确位置上的前缀，之后 *first 令谓词为 false
+    first = mystl::find_if_not(first, last, unary_pred);
+    if(first == last)
+        return first;
+    return mystl::stable_partition_aux(first, last, unary_pred, mystl::value_type(first));
+}
+
+
+/*****************************************************************************************/
+// parallel_partition
+// 多线程版本的 partition，不保证元素的原始相对位置
+// 区间分成若干块，各线程分别 partition 自己的块，得到全部 true 元素的个数 T 后，
+// [first, first + T) 中的 false 元素与 [first + T, last) 中的 true 元素个数相同，再并行地两两交换
+/*****************************************************************************************/
+constexpr static size_t kParallelPartitionGrain = 1 << 16;    // 每个线程至少处理的元素个数
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter parallel_partition_aux(RandomIter first, RandomIter last, UnaryPredicate& unary_pred,
+        size_t parts) {
+    typedef typename iterator_traits<RandomIter>::difference_type distance_type;
+    const distance_type n = last - first;
+    // 放错位置的区间看成一个连续序列，loffset / roffset 为各区间在序列中的起点
+    distance_type* bound = new distance_type[6 * parts + 1];
+    distance_type* split = bound + parts + 1;           // 各块内 true / false 的分界
+    distance_type* lbegin = split + parts;              // [first, first + T) 中放错位置的区间
+    distance_type* loffset = lbegin + parts;
+    distance_type* rbegin = loffset + parts;            // [first + T, last) 中放错位置的区间
+    distance_type* roffset = rbegin + parts;
+    for(size_t i = 0; i <= parts; ++i)
+        bound[i] = static_cast<distance_type>(static_cast<size_t>(n) / parts * i);
+    bound[parts] = n;
+    try {
+        mystl::parallel_invoke_n(parts, [&](size_t i) {
+            split[i] = mystl::partition_dispatch(first + bound[i], first + bound[i + 1],
+                unary_pred, random_access_iterator_tag()) - first;
+        });
+    }
+    catch(...) {
+        delete[] bound;
+        throw;
+    }
+    distance_type total = 0;
+    for(size_t i = 0; i < parts; ++i)
+        total += split[i] - bound[i];
+    // 块 i 的 false 部分 [split[i], bound[i + 1]) 落在 [0, total) 内的是左侧的错位元素
+    // 块 i 的 true 部分 [bound[i], split[i]) 落在 [total, n) 内的是右侧的错位元素
+    size_t lc = 0, rc = 0;
+    distance_type misplaced = 0;
+    for(size_t i = 0; i < parts; ++i) {
+        const distance_type lb = split[i];
+        const distance_type le = bound[i + 1] < total ? bound[i + 1] : total;
+        if(lb < le) {
+            lbegin[lc] = lb;
+            loffset[lc++] = misplaced;
+            misplaced += le - lb;
+        }
+    }
+    distance_type rtotal = 0;
+    for(size_t i = 0; i < parts; ++i) {
+        const distance_type rb = bound[i] > total ? bound[i] : total;
+        const distance_type re = split[i];
+        if(rb < re) {
+            rbegin[rc] = rb;
+            roffset[rc++] = rtotal;
+            rtotal += re - rb;
+        }
+    }
+    if(misplaced > 0) {
+        const size_t workers = parts;
+        try {
+            mystl::parallel_invoke_n(workers, [&](size_t w) {
+                const distance_type kb = static_cast<distance_type>(
+                    static_cast<size_t>(misplaced) / workers * w);
+                const distance_type ke = w + 1 == workers ? misplaced : static_cast<distance_type>(
+                    static_cast<size_t>(misplaced) / workers * (w + 1));
+                if(kb >= ke)
+                    return;
+                size_t li = 0, ri = 0;
+                while(li + 1 < lc && loffset[li + 1] <= kb)
+                    ++li;
+                while(ri + 1 < rc && roffset[ri + 1] <= kb)
+                    ++ri;
+                distance_type lp = lbegin[li] + (kb - loffset[li]);
+                distance_type rp = rbegin[ri] + (kb - roffset[ri]);
+                for(distance_type k = kb; k < ke; ++k) {
+                    // 跨过区间边界时移到下一个区间的起点
+                    if(li + 1 < lc && k == loffset[li + 1])
+                        lp = lbegin[++li];
+                    if(ri + 1 < rc && k == roffset[ri + 1])
+                        rp = rbegin[++ri];
+                    mystl::iter_swap(first + lp, first + rp);
+                    ++lp; ++rp;
+                }
+            });
+        }
+        catch(...) {
+            delete[] bound;
+            throw;
+        }
+    }
+    delete[] bound;
+    return first + total;
+}
+
+template <class RandomIter, class UnaryPredicate>
+RandomIter parallel_partition(RandomIter first, RandomIter last, UnaryPredicate unary_pred) {
+    const auto n = static_cast<size_t>(last - first);
+    size_t parts = n / kParallelPartitionGrain;
+    const size_t threads = mystl::hardware_threads();
+    parts = parts < threads ? parts : threads;
+    if(parts <= 1)
+        return mystl::partition_dispatch(first, last, unary_pred, random_access_iterator_tag());
+    return mystl::parallel_partition_aux(first, last, unary_pred, parts);
+}
+
 
 /*****************************************************************************************/
 // partition_copy
@@ -2015,7 +3061,7 @@ BiIter partition(BiIter first, BiIter last, UnaryPredicate unary_pred) {
 // 其余放到 result_false 的输出区间，并返回一个 mystl::pair 指向这两个区间的尾部
 /*****************************************************************************************/
 template <class InputIter, class OutputIter1, class OutputIter2, class UnaryPredicate>
-mystl::pair<OutputIter1, OutputIter2> partition_copy(InputIter first, InputIter last,
+mystl::pair<OutputIter1, OutputIter2> unchecked_partition_copy(InputIter first, InputIter last,
         OutputIter1 result_true, OutputIter2 result_false, UnaryPredicate unary_pred) {
     for(; first != last; ++first) {
         if(unary_pred(*first)) {
@@ -2030,6 +3076,24 @@ mystl::pair<OutputIter1, OutputIter2> partition_copy(InputIter first, InputIter
     return mystl::pair<OutputIter1, OutputIter2>(result_true, result_false);
 }
 
+// 为可以逐字节复制的类型提供特化版本
+template <class Tp, class Up, class UnaryPredicate>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Up>::value &&
+    is_compact_type<Up>::value, mystl::pair<Up*, Up*>>
+    unchecked_partition_copy(Tp* first, Tp* last, Up* result_true, Up* result_false,
+        UnaryPredicate unary_pred) {
+        const auto n = static_cast<size_t>(last - first);
+        const auto r = mystl::compact_copy<true, true>(first, n, result_true, result_false, unary_pred);
+        return mystl::pair<Up*, Up*>(result_true + r.first, result_false + r.second);
+}
+
+template <class InputIter, class OutputIter1, class OutputIter2, class UnaryPredicate>
+mystl::pair<OutputIter1, OutputIter2> partition_copy(InputIter first, InputIter last,
+        OutputIter1 result_true, OutputIter2 result_false, UnaryPredicate unary_pred) {
+    return mystl::unchecked_partition_copy(first, last, result_true, result_false, unary_pred);
+}
+
 
 /*****************************************************************************************/
 // sort
@@ -2067,7 +3131,7 @@ RandomIter unchecked_partition(RandomIter first, RandomIter last, const T& pivot
 
 // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
 template <class RandomIter, class Size>
-void intro_sort(RandomIter frist, RandomIter last, Size depth_limit) {
+void intro_sort(RandomIter first, RandomIter last, Size depth_limit) {
     while(static_cast<size_t>(last - first) > kSmallSectionSize) {
         if(depth_limit == 0) {
             mystl::partial_sort(first, last, last);
@@ -2083,7 +3147,7 @@ void intro_sort(RandomIter frist, RandomIter last, Size depth_limit) {
 
 // 插入排序辅助函数 unchecked_linear_insert
 template <class RandomIter, class T>
-void unchecked_linear_insert(RandomIter last, const T& value) {
+void unchecked_linear_insert(RandomIter last, T value) {
     auto next = last;
     --next;
     // 从last向前找第一个小于value的元素位置，并在后插入value
@@ -2162,14 +3226,14 @@ RandomIter unchecked_partition(RandomIter first, RandomIter last,
 
 // 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
 template <class RandomIter, class Size, class Compared>
-void intro_sort(RandomIter frist, RandomIter last, Size depth_limit, Compared comp) {
+void intro_sort(RandomIter first, RandomIter last, Size depth_limit, Compared comp) {
     while(static_cast<size_t>(last - first) > kSmallSectionSize) {
         if(depth_limit == 0) {
             mystl::partial_sort(first, last, last, comp);
             return;
         }
         --depth_limit;
-        auto mid = mystl::median(*first, *(first + (last - first) / 2), *(last - 1));
+        auto mid = mystl::median(*first, *(first + (last - first) / 2), *(last - 1), comp);
         auto cut = unchecked_partition(first, last, mid, comp);
         mystl::intro_sort(cut, last, depth_limit, comp);
         last = cut;
@@ -2178,7 +3242,7 @@ void intro_sort(RandomIter frist, RandomIter last, Size depth_limit, Compared co
 
 // 插入排序辅助函数 unchecked_linear_insert
 template <class RandomIter, class T, class Compared>
-void unchecked_linear_insert(RandomIter last, const T& value, Compared comp) {
+void unchecked_linear_insert(RandomIter last, T value, Compared comp) {
     auto next = last;
     --next;
     // 从last向前找第一个小于value的元素位置，并在后插入value
@@ -2246,8 +3310,8 @@ void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
     if(nth == last)
         return;
     while(last - first > 3) {
-        auto cut = mystl::unchecked_partition(first, last,
-            mystl::median(*first, *(first + (last - first) / 2), *(last - 1)));
+        auto mid = mystl::median(*first, *(first + (last - first) / 2), *(last - 1));
+        auto cut = mystl::unchecked_partition(first, last, mid);
         if(cut <= nth)
             first = cut;    // 第cut个元素左边都小于*cut 
         else    
@@ -2262,8 +3326,8 @@ void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compared com
     if(nth == last)
         return;
     while(last - first > 3) {
-        auto cut = mystl::unchecked_partition(first, last,
-            mystl::median(*first, *(first + (last - first) / 2), *(last - 1)), comp);
+        auto mid = mystl::median(*first, *(first + (last - first) / 2), *(last - 1), comp);
+        auto cut = mystl::unchecked_partition(first, last, mid, comp);
         if(cut <= nth)
             first = cut;    // 第cut个元素左边都小于*cut 
         else    
@@ -2298,18 +3362,36 @@ OutputIter unique_copy_dispatch(InputIter first, InputIter last,
     *result = value;
     while(++first != last) {
         if(*first != value) {
-            *++result = value;
             value = *first;
+            *++result = value;
         }
     }
     return ++result;
 }
 
+template <class InputIter, class OutputIter>
+OutputIter unchecked_unique_copy(InputIter first, InputIter last, OutputIter result) {
+    return mystl::unique_copy_dispatch(first, last, result, iterator_category(result));
+}
+
+// 为连续算术区间提供特化版本，使用 SIMD 流压缩
+template <class Tp, class Up>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Up>::value &&
+    is_unique_simd_type<Up>::value, Up*>
+    unchecked_unique_copy(Tp* first, Tp* last, Up* result) {
+#ifdef MYSTL_SIMD_X86
+        if(mystl::simd_level() >= simd_avx2)
+            return result + mystl::unique_avx2<Up>(first, static_cast<size_t>(last - first), result);
+#endif // MYSTL_SIMD_X86
+        return mystl::unique_copy_dispatch(first, last, result, random_access_iterator_tag());
+}
+
 template <class InputIter, class OutputIter>
 OutputIter unique_copy(InputIter first, InputIter last, OutputIter result) {
     if (first == last)
         return result;
-    return mystl::unique_copy_dispatch(first, last, result, iterator_category(result));
+    return mystl::unchecked_unique_copy(first, last, result);
 }
 
 
@@ -2320,7 +3402,7 @@ ForwardIter unique_copy_dispatch(InputIter first, InputIter last,
         ForwardIter result, forward_iterator_tag, Compared comp) {
     *result = *first;
     while(++first != last) {
-        if(*first != *result)
+        if(!comp(*result, *first))
             *++result = *first;
     }
     return ++result;
@@ -2334,9 +3416,9 @@ OutputIter unique_copy_dispatch(InputIter first, InputIter last,
     auto value = *first;
     *result = value;
     while(++first != last) {
-        if(*first != value) {
-            *++result = value;
+        if(!comp(value, *first)) {
             value = *first;
+            *++result = value;
         }
     }
     return ++result;
@@ -2357,9 +3439,33 @@ OutputIter unique_copy(InputIter first, InputIter last,
 // 移除[first, last)内重复的元素，序列必须有序，和 remove 类似，它也不能真正的删除重复元素
 /*****************************************************************************************/
 template <class ForwardIter>
-ForwardIter unique(ForwardIter first, ForwardIter last) {
+ForwardIter unchecked_unique(ForwardIter first, ForwardIter last) {
     first = mystl::adjacent_find(first, last);
-    return unique_copy(first, last, first);
+    return mystl::unique_copy(first, last, first);
+}
+
+// 为连续算术区间提供特化版本
+// 先用 SIMD 跳过没有重复的前缀，再原地压缩剩余部分
+template <class Tp>
+typename std::enable_if_t<
+    is_neighbor_simd_type<Tp>::value && !std::is_const<Tp>::value, Tp*>
+    unchecked_unique(Tp* first, Tp* last) {
+        first = mystl::unchecked_adjacent_find(first, last);
+        if(first == last)
+            return last;
+        const auto n = static_cast<size_t>(last - first);
+#ifdef MYSTL_SIMD_X86
+        if constexpr(sizeof(Tp) == 4 || sizeof(Tp) == 8) {
+            if(mystl::simd_level() >= simd_avx2)
+                return first + mystl::unique_avx2<Tp>(first, n, first);
+        }
+#endif // MYSTL_SIMD_X86
+        return first + mystl::unique_branchless(first, n);
+}
+
+template <class ForwardIter>
+ForwardIter unique(ForwardIter first, ForwardIter last) {
+    return mystl::unchecked_unique(first, last);
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -3,7 +3,9 @@
 
 #include <cstring>
 
+#include "functional.h"
 #include "iterator.h"
+#include "simd.h"
 #include "util.h"
 
 namespace mystl {
@@ -54,6 +56,119 @@ void iter_swap(Iter1 lhs, Iter2 rhs) {
     mystl::swap(*lhs, *rhs);
 }
 
+/*****************************************************************************************/
+// 逐字节复制
+// 两个迭代器都指向连续内存，元素类型相同 (源区间可以为 const) 且可平凡复制时，
+// 逐个赋值或构造与复制字节的效果相同，copy / move / uninitialized_* 等改用 memmove
+// Trait 为对应操作 (复制赋值、移动赋值、复制构造、移动构造) 的平凡性检查
+/*****************************************************************************************/
+template <class Iter>
+using contiguous_element_t =
+    typename std::remove_pointer<decltype(mystl::to_address(std::declval<const Iter&>()))>::type;
+
+template <class Iter1, class Iter2, template <class> class Trait,
+          bool = is_contiguous_iterator<Iter1>::value && is_contiguous_iterator<Iter2>::value>
+struct is_bitwise_transfer : public m_false_type {};
+
+template <class Iter1, class Iter2, template <class> class Trait>
+struct is_bitwise_transfer<Iter1, Iter2, Trait, true> : public m_bool_constant<
+    std::is_same<typename std::remove_const<contiguous_element_t<Iter1>>::type,
+                 contiguous_element_t<Iter2>>::value &&
+    !std::is_volatile<contiguous_element_t<Iter2>>::value &&
+    std::is_trivially_copyable<contiguous_element_t<Iter2>>::value &&
+    Trait<contiguous_element_t<Iter2>>::value> {};
+
+template <class Iter1, class Iter2>
+struct is_bitwise_copy : public is_bitwise_transfer<Iter1, Iter2, std::is_trivially_copy_assignable> {};
+
+template <class Iter1, class Iter2>
+struct is_bitwise_move : public is_bitwise_transfer<Iter1, Iter2, std::is_trivially_move_assignable> {};
+
+// 非临时复制
+// 复制超过 kNonTemporalBytes 字节且两段内存不重叠时，目标以 stream 指令写入，
+// 大块复制不再读入目标缓存行，也不会挤出调用方和其它线程的工作集
+// 源数据是顺序读取的，交给硬件预取器；显式的 prefetchnta 会打断硬件预取，实测吞吐量下降约一半
+// 重叠的区间仍交给 memmove，保持 copy / copy_backward 对重叠区间的语义
+#ifdef MYSTL_SIMD_X86
+// 要求 bytes >= 32 且两段内存不重叠
+MYSTL_TARGET_AVX2
+inline void stream_copy_avx2(unsigned char* dst, const unsigned char* src, size_t bytes) noexcept {
+    // 先写入未对齐的头部，再从目标 32 字节对齐处开始使用 stream 存储
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+    const size_t head = 32 - (reinterpret_cast<uintptr_t>(dst) & 31);
+    unsigned char* d = dst + head;
+    const unsigned char* s = src + head;
+    unsigned char* const end = dst + bytes;
+    for(; d + 128 <= end; d += 128, s += 128) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+        const __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v0);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), v1);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), v2);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), v3);
+    }
+    for(; d + 32 <= end; d += 32, s += 32)
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+    _mm_sfence();
+    // 不足 32 字节的尾部与前面的写入重叠
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + bytes - 32)));
+}
+#endif // MYSTL_SIMD_X86
+
+// 两段内存是否重叠
+inline bool bytes_overlap(const void* dst, const void* src, size_t bytes) noexcept {
+    const uintptr_t d = reinterpret_cast<uintptr_t>(dst);
+    const uintptr_t s = reinterpret_cast<uintptr_t>(src);
+    return d < s + bytes && s < d + bytes;
+}
+
+// 总是使用非临时存储 (不支持 AVX2、区间太短或重叠时退回 memmove)
+inline void stream_copy_bytes(void* dst, const void* src, size_t bytes) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(bytes >= 32 && mystl::simd_level() >= simd_avx2 && !mystl::bytes_overlap(dst, src, bytes)) {
+        mystl::stream_copy_avx2(static_cast<unsigned char*>(dst),
+                                static_cast<const unsigned char*>(src), bytes);
+        return;
+    }
+#endif
+    if(bytes != 0)
+        std::memmove(dst, src, bytes);
+}
+
+// 超过 kNonTemporalBytes 时自动使用非临时存储
+inline void copy_bytes(void* dst, const void* src, size_t bytes) noexcept {
+    if(bytes >= kNonTemporalBytes)
+        mystl::stream_copy_bytes(dst, src, bytes);
+    else if(bytes != 0)
+        std::memmove(dst, src, bytes);
+}
+
+// 把 [first, first + n) 的字节复制到 [result, result + n)，返回 result + n
+template <class Iter1, class Iter2>
+Iter2 bitwise_copy_n(Iter1 first, size_t n, Iter2 result) {
+    typedef typename iterator_traits<Iter2>::difference_type difference_type;
+    if(n != 0)
+        mystl::copy_bytes(mystl::to_address(result), mystl::to_address(first),
+                          n * sizeof(contiguous_element_t<Iter2>));
+    return result + static_cast<difference_type>(n);
+}
+
+// 把 [first, first + n) 的字节复制到 [result - n, result)，返回 result - n
+template <class Iter1, class Iter2>
+Iter2 bitwise_copy_backward_n(Iter1 first, size_t n, Iter2 result) {
+    typedef typename iterator_traits<Iter2>::difference_type difference_type;
+    result -= static_cast<difference_type>(n);
+    if(n != 0)
+        mystl::copy_bytes(mystl::to_address(result), mystl::to_address(first),
+                          n * sizeof(contiguous_element_t<Iter2>));
+    return result;
+}
+
 /******************************************************************/
 // copy
 // 把 [first, last)区间内的元素拷贝到 [result, result + (last - first))内
@@ -78,21 +193,20 @@ OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter resu
     return result;
 }
 
+// 连续区间的可平凡复制类型使用 memmove
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
+OutputIter unchecked_copy_aux(InputIter first, InputIter last, OutputIter result, m_true_type) {
+    return mystl::bitwise_copy_n(first, static_cast<size_t>(last - first), result);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter unchecked_copy_aux(InputIter first, InputIter last, OutputIter result, m_false_type) {
     return unchecked_copy_cat(first, last, result, iterator_category(first));
 }
 
-// 为 trivially_copy_assignable 类型提供特化版本
-template <class Tp, class Up>
-typename std::enable_if_t< 
-    std::is_same<typename std::remove_const_t<Tp>, Up>::value && 
-    std::is_trivially_copy_assignable<Up>::value, Up*>
-    unchecked_copy(Tp* first, Tp* last, Up* result) {
-        const auto n = static_cast<size_t>(last - first);
-        if(n != 0)
-            std::memmove(result, first, n*sizeof(Up));
-        return result + n;
+template <class InputIter, class OutputIter>
+OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
+    return mystl::unchecked_copy_aux(first, last, result, is_bitwise_copy<InputIter, OutputIter>{});
 }
 
 template <class InputIter, class OutputIter>
@@ -122,23 +236,21 @@ BiIter2 unchecked_copy_backward_cat(RandomIter1 first, RandomIter1 last,
     return result;
 }
 
+// 连续区间的可平凡复制类型使用 memmove
 template <class BiIter1, class BiIter2>
-BiIter2 unchecked_copy_backward(BiIter1 first, BiIter1 last, BiIter2 result) {
-    return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
+BiIter2 unchecked_copy_backward_aux(BiIter1 first, BiIter1 last, BiIter2 result, m_true_type) {
+    return mystl::bitwise_copy_backward_n(first, static_cast<size_t>(last - first), result);
 }
 
+template <class BiIter1, class BiIter2>
+BiIter2 unchecked_copy_backward_aux(BiIter1 first, BiIter1 last, BiIter2 result, m_false_type) {
+    return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
+}
 
-// 为 trivially_copy_assignable 类型提供特化版本
-template <class Tp, class Up>
-typename std::enable_if_t< 
-    std::is_same<typename std::remove_const_t<Tp>, Up>::value && 
-    std::is_trivially_copy_assignable<Up>::value, Up*>
-    unchecked_copy_backward(Tp* first, Tp* last, Up* result) {
-        const szie_t n = static_cast<size_t>(last - first);
-        if(n != 0)
-            result -= n;
-            std::memmove(result, first, n*sizeof(Up));
-        return result;
+template <class BiIter1, class BiIter2>
+BiIter2 unchecked_copy_backward(BiIter1 first, BiIter1 last, BiIter2 result) {
+    return mystl::unchecked_copy_backward_aux(first, last, result,
+                                              is_bitwise_copy<BiIter1, BiIter2>{});
 }
 
 template <class InputIter, class OutputIter>
@@ -147,14 +259,315 @@ OutputIter copy_backward(InputIter first, InputIter last, OutputIter result) {
 }
 
 /*****************************************************************************************/
-// move
-// 把 [first, last)区间内的元素移动到 [result, result + (last - first))内
+// 连续区间的流压缩
+// 按谓词把元素压缩到输出区间，供 copy_if、remove_if、remove_copy_if、partition_copy 使用
+// 标量版本每个元素都写入，只用谓词结果移动写位置，避免 50% 选择率时的分支预测失败
+// 谓词是与常量比较的 binder2nd (如 bind2nd(less<int>(), 0)) 且元素为 4 / 8 字节算术类型时，
+// 使用 AVX-512 的压缩存储或 AVX2 的 permutevar8x32 一次处理一个向量
 /*****************************************************************************************/
-// input_iterator_tag 版本
+constexpr static size_t kCompactBlock = 256;    // 标量版本写到另一块内存时，栈上缓冲区的元素个数
+
+// 可以逐字节复制的小型类型
+template <class T>
+struct is_compact_type : public m_bool_constant<
+    std::is_trivially_copyable<T>::value && !std::is_volatile<T>::value && sizeof(T) <= 16> {};
+
+// 向量压缩支持的元素类型
+template <class T>
+struct is_compress_simd_type : public m_bool_constant<
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+    (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+enum compare_op_t {
+    cmp_none = -1,
+    cmp_eq, cmp_ne, cmp_lt, cmp_le, cmp_gt, cmp_ge
+};
+
+// 比较函数对象对应的比较操作
+template <class Op>
+struct compare_op_code { constexpr static int value = cmp_none; };
+template <class T>
+struct compare_op_code<equal_to<T>> { constexpr static int value = cmp_eq; };
+template <class T>
+struct compare_op_code<not_equal_to<T>> { constexpr static int value = cmp_ne; };
+template <class T>
+struct compare_op_code<less<T>> { constexpr static int value = cmp_lt; };
+template <class T>
+struct compare_op_code<less_equal<T>> { constexpr static int value = cmp_le; };
+template <class T>
+struct compare_op_code<greater<T>> { constexpr static int value = cmp_gt; };
+template <class T>
+struct compare_op_code<greater_equal<T>> { constexpr static int value = cmp_ge; };
+
+// 判断谓词能否展开为元素与常量的向量比较
+template <class Pred, class T>
+struct is_simd_predicate : public m_false_type {};
+
+template <class Op, class T>
+struct is_simd_predicate<binder2nd<Op>, T> : public m_bool_constant<
+    compare_op_code<Op>::value != cmp_none && is_compress_simd_type<T>::value &&
+    std::is_same<typename Op::first_argument_type, T>::value> {};
+
+template <int Op, class T>
+bool compare_with(const T& x, const T& c) {
+    if constexpr(Op == cmp_eq) return x == c;
+    else if constexpr(Op == cmp_ne) return x != c;
+    else if constexpr(Op == cmp_lt) return x < c;
+    else if constexpr(Op == cmp_le) return x <= c;
+    else if constexpr(Op == cmp_gt) return x > c;
+    else return x >= c;
+}
+
+#ifdef MYSTL_SIMD_X86
+template <class T>
+MYSTL_TARGET_AVX2
+__m256i compact_broadcast_avx2(const T& v) {
+    if constexpr(sizeof(T) == 4) {
+        int32_t bits;
+        std::memcpy(&bits, &v, 4);
+        return _mm256_set1_epi32(bits);
+    }
+    else {
+        int64_t bits;
+        std::memcpy(&bits, &v, 8);
+        return _mm256_set1_epi64x(bits);
+    }
+}
+
+// 返回 x Op c 的 8 位掩码，每个 32 位通道一位，64 位元素占两位
+template <class T, int Op>
+MYSTL_TARGET_AVX2
+unsigned compare_mask_avx2(__m256i x, __m256i c) {
+    if constexpr(std::is_floating_point<T>::value) {
+        constexpr int imm = Op == cmp_eq ? _CMP_EQ_OQ : Op == cmp_ne ? _CMP_NEQ_UQ :
+                            Op == cmp_lt ? _CMP_LT_OQ : Op == cmp_le ? _CMP_LE_OQ :
+                            Op == cmp_gt ? _CMP_GT_OQ : _CMP_GE_OQ;
+        if constexpr(sizeof(T) == 4)
+            return static_cast<unsigned>(_mm256_movemask_ps(
+                _mm256_cmp_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(c), imm)));
+        else
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castpd_ps(
+                _mm256_cmp_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(c), imm))));
+    }
+    else {
+        // 只有有符号的 eq / gt 比较，无符号整型先翻转最高位
+        if constexpr(!std::is_signed<T>::value && Op != cmp_eq && Op != cmp_ne) {
+            const __m256i bias = sizeof(T) == 4
+                ? _mm256_set1_epi32(static_cast<int>(0x80000000u))
+                : _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+            x = _mm256_xor_si256(x, bias);
+            c = _mm256_xor_si256(c, bias);
+        }
+        __m256i m;
+        if constexpr(Op == cmp_eq || Op == cmp_ne)
+            m = sizeof(T) == 4 ? _mm256_cmpeq_epi32(x, c) : _mm256_cmpeq_epi64(x, c);
+        else if constexpr(Op == cmp_gt || Op == cmp_le)
+            m = sizeof(T) == 4 ? _mm256_cmpgt_epi32(x, c) : _mm256_cmpgt_epi64(x, c);
+        else
+            m = sizeof(T) == 4 ? _mm256_cmpgt_epi32(c, x) : _mm256_cmpgt_epi64(c, x);
+        const unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+        return (Op == cmp_ne || Op == cmp_le || Op == cmp_ge) ? (~bits & 0xffu) : bits;
+    }
+}
+
+// 把令 a[i] Op c 为 true 的元素压缩到 out_true，其余压缩到 out_false，为 nullptr 的输出被跳过
+// in_place 表示输出位于同一数组中 a 或 a 之前的位置，此时整块写回，写入位置不会超过已读取的位置；
+// 否则使用 maskstore 只写入选中的元素
+template <class T, int Op>
+MYSTL_TARGET_AVX2
+mystl::pair<size_t, size_t> compress_avx2(const T* a, size_t n, const T& c,
+        T* out_true, T* out_false, bool in_place) {
+    constexpr size_t L = 32 / sizeof(T);
+    constexpr unsigned W = sizeof(T) / 4;
+    const __m256i vc = mystl::compact_broadcast_avx2(c);
+    size_t nt = 0, nf = 0, i = 0;
+    for(; i + L <= n; i += L) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const unsigned m = mystl::compare_mask_avx2<T, Op>(x, vc);
+        if(out_true) {
+            const __m256i v = mystl::compress_epi32(x, m);
+            const unsigned cnt = mystl::popcount32(m);
+            if(in_place)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_true + nt), v);
+            else
+                _mm256_maskstore_epi32(reinterpret_cast<int*>(out_true + nt),
+                                       mystl::prefix_mask_epi32(cnt), v);
+            nt += cnt / W;
+        }
+        if(out_false) {
+            const unsigned fm = ~m & 0xffu;
+            const __m256i v = mystl::compress_epi32(x, fm);
+            const unsigned cnt = mystl::popcount32(fm);
+            if(in_place)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_false + nf), v);
+            else
+                _mm256_maskstore_epi32(reinterpret_cast<int*>(out_false + nf),
+                                       mystl::prefix_mask_epi32(cnt), v);
+            nf += cnt / W;
+        }
+    }
+    for(; i < n; ++i) {
+        const T v = a[i];
+        if(mystl::compare_with<Op>(v, c)) {
+            if(out_true)
+                out_true[nt++] = v;
+        }
+        else if(out_false) {
+            out_false[nf++] = v;
+        }
+    }
+    return mystl::pair<size_t, size_t>(nt, nf);
+}
+
+// 返回 x Op c 的位掩码
+template <class T, int Op>
+MYSTL_TARGET_AVX512
+unsigned compare_mask_avx512(__m512i x, __m512i c) {
+    constexpr int iimm = Op == cmp_eq ? _MM_CMPINT_EQ : Op == cmp_ne ? _MM_CMPINT_NE :
+                         Op == cmp_lt ? _MM_CMPINT_LT : Op == cmp_le ? _MM_CMPINT_LE :
+                         Op == cmp_gt ? _MM_CMPINT_NLE : _MM_CMPINT_NLT;
+    constexpr int fimm = Op == cmp_eq ? _CMP_EQ_OQ : Op == cmp_ne ? _CMP_NEQ_UQ :
+                         Op == cmp_lt ? _CMP_LT_OQ : Op == cmp_le ? _CMP_LE_OQ :
+                         Op == cmp_gt ? _CMP_GT_OQ : _CMP_GE_OQ;
+    if constexpr(std::is_same<T, float>::value)
+        return _mm512_cmp_ps_mask(_mm512_castsi512_ps(x), _mm512_castsi512_ps(c), fimm);
+    else if constexpr(std::is_same<T, double>::value)
+        return _mm512_cmp_pd_mask(_mm512_castsi512_pd(x), _mm512_castsi512_pd(c), fimm);
+    else if constexpr(sizeof(T) == 4)
+        return std::is_signed<T>::value ? _mm512_cmp_epi32_mask(x, c, iimm)
+                                        : _mm512_cmp_epu32_mask(x, c, iimm);
+    else
+        return std::is_signed<T>::value ? _mm512_cmp_epi64_mask(x, c, iimm)
+                                        : _mm512_cmp_epu64_mask(x, c, iimm);
+}
+
+// 与 compress_avx2 相同，压缩存储指令只写入选中的元素
+template <class T, int Op>
+MYSTL_TARGET_AVX512
+mystl::pair<size_t, size_t> compress_avx512(const T* a, size_t n, const T& c,
+        T* out_true, T* out_false) {
+    constexpr size_t L = 64 / sizeof(T);
+    __m512i vc;
+    if constexpr(sizeof(T) == 4) {
+        int32_t bits;
+        std::memcpy(&bits, &c, 4);
+        vc = _mm512_set1_epi32(bits);
+    }
+    else {
+        int64_t bits;
+        std::memcpy(&bits, &c, 8);
+        vc = _mm512_set1_epi64(bits);
+    }
+    constexpr unsigned full = static_cast<unsigned>((1ull << L) - 1);
+    size_t nt = 0, nf = 0, i = 0;
+    for(; i + L <= n; i += L) {
+        const __m512i x = _mm512_loadu_si512(a + i);
+        const unsigned m = mystl::compare_mask_avx512<T, Op>(x, vc);
+        if(out_true) {
+            if constexpr(sizeof(T) == 4)
+                _mm512_mask_compressstoreu_epi32(out_true + nt, static_cast<__mmask16>(m), x);
+            else
+                _mm512_mask_compressstoreu_epi64(out_true + nt, static_cast<__mmask8>(m), x);
+            nt += mystl::popcount32(m);
+        }
+        if(out_false) {
+            const unsigned fm = ~m & full;
+            if constexpr(sizeof(T) == 4)
+                _mm512_mask_compressstoreu_epi32(out_false + nf, static_cast<__mmask16>(fm), x);
+            else
+                _mm512_mask_compressstoreu_epi64(out_false + nf, static_cast<__mmask8>(fm), x);
+            nf += mystl::popcount32(fm);
+        }
+    }
+    for(; i < n; ++i) {
+        const T v = a[i];
+        if(mystl::compare_with<Op>(v, c)) {
+            if(out_true)
+                out_true[nt++] = v;
+        }
+        else if(out_false) {
+            out_false[nf++] = v;
+        }
+    }
+    return mystl::pair<size_t, size_t>(nt, nf);
+}
+#endif // MYSTL_SIMD_X86
+
+// 选择向量内核，不支持时返回 false
+template <class T, class Pred>
+bool compress_simd(const T* a, size_t n, const Pred& pred, T* out_true, T* out_false,
+        bool in_place, mystl::pair<size_t, size_t>& result) {
+#ifdef MYSTL_SIMD_X86
+    if constexpr(is_simd_predicate<Pred, T>::value) {
+        constexpr int op = compare_op_code<typename std::decay_t<decltype(pred.op)>>::value;
+        const int level = mystl::simd_level();
+        if(level >= simd_avx512) {
+            result = mystl::compress_avx512<T, op>(a, n, pred.value, out_true, out_false);
+            return true;
+        }
+        if(level >= simd_avx2) {
+            result = mystl::compress_avx2<T, op>(a, n, pred.value, out_true, out_false, in_place);
+            return true;
+        }
+    }
+#endif // MYSTL_SIMD_X86
+    (void)a; (void)n; (void)pred; (void)out_true; (void)out_false; (void)in_place; (void)result;
+    return false;
+}
+
+// 把 [a, a + n) 中令 pred 为 Keep 的元素依次写到 out，返回保留的个数
+// out 位于同一数组中 a 或 a 之前的位置，每个元素只调用一次 pred
+template <bool Keep, class T, class Pred>
+size_t compact_in_place(T* out, const T* a, size_t n, Pred& pred) {
+    mystl::pair<size_t, size_t> r;
+    if(mystl::compress_simd(a, n, pred, Keep ? out : nullptr, Keep ? nullptr : out, true, r))
+        return Keep ? r.first : r.second;
+    size_t k = 0;
+    for(size_t i = 0; i < n; ++i) {
+        const T v = a[i];
+        out[k] = v;
+        k += static_cast<size_t>(static_cast<bool>(pred(v)) == Keep);
+    }
+    return k;
+}
+
+// 把令 pred 为 true / false 的元素分别复制到 out_true / out_false，不需要的输出传入 nullptr
+// 标量版本先压缩到栈上的缓冲区，再整块复制，不会写出输出区间
+template <bool WantTrue, bool WantFalse, class T, class Pred>
+mystl::pair<size_t, size_t> compact_copy(const T* a, size_t n, T* out_true, T* out_false, Pred& pred) {
+    mystl::pair<size_t, size_t> r(0, 0);
+    if(mystl::compress_simd(a, n, pred, out_true, out_false, false, r))
+        return r;
+    alignas(T) unsigned char buf_true[WantTrue ? kCompactBlock * sizeof(T) : 1];
+    alignas(T) unsigned char buf_false[WantFalse ? kCompactBlock * sizeof(T) : 1];
+    for(size_t base = 0; base < n; base += kCompactBlock) {
+        const size_t len = n - base < kCompactBlock ? n - base : kCompactBlock;
+        size_t t = 0, f = 0;
+        for(size_t i = 0; i < len; ++i) {
+            const bool p = static_cast<bool>(pred(a[base + i]));
+            if(WantTrue)
+                std::memcpy(buf_true + t * sizeof(T), a + base + i, sizeof(T));
+            if(WantFalse)
+                std::memcpy(buf_false + f * sizeof(T), a + base + i, sizeof(T));
+            t += static_cast<size_t>(p);
+            f += static_cast<size_t>(!p);
+        }
+        if(WantTrue && t != 0)
+            std::memmove(out_true + r.first, buf_true, t * sizeof(T));
+        if(WantFalse && f != 0)
+            std::memmove(out_false + r.second, buf_false, f * sizeof(T));
+        r.first += t;
+        r.second += f;
+    }
+    return r;
+}
+
+/*****************************************************************************************/
+// copy_if
 // 把[first, last)内满足一元操作 unary_pred 的元素拷贝到以 result 为起始的位置上
 /*****************************************************************************************/
 template <class InIter, class OutIter, class UnaryPredicate>
-OutIter copy_if(InIter first, InIter last, OutIter result, UnaryPredicate unary_pred) {
+OutIter unchecked_copy_if(InIter first, InIter last, OutIter result, UnaryPredicate unary_pred) {
     for(; first != last; ++first) {
         if(unary_pred(*first)) 
             *result++ = *first;
@@ -162,6 +575,22 @@ OutIter copy_if(InIter first, InIter last, OutIter result, UnaryPredicate unary_
     return result;
 }
 
+// 为可以逐字节复制的类型提供特化版本
+template <class Tp, class Up, class UnaryPredicate>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Up>::value &&
+    is_compact_type<Up>::value, Up*>
+    unchecked_copy_if(Tp* first, Tp* last, Up* result, UnaryPredicate unary_pred) {
+        const auto n = static_cast<size_t>(last - first);
+        return result + mystl::compact_copy<true, false>(first, n, result,
+            static_cast<Up*>(nullptr), unary_pred).first;
+}
+
+template <class InIter, class OutIter, class UnaryPredicate>
+OutIter copy_if(InIter first, InIter last, OutIter result, UnaryPredicate unary_pred) {
+    return mystl::unchecked_copy_if(first, last, result, unary_pred);
+}
+
 /*****************************************************************************************/
 // copy_n
 // 把 [first, first + n)区间上的元素拷贝到 [result, result + n)上
@@ -175,19 +604,50 @@ mystl::pair<InputIter, OutputIter> unchecked_copy_n
         return mystl::pair<InputIter, OutputIter>(first, result);
 }
 
+// 随机访问版本交给 copy，连续区间的可平凡复制类型在 copy 中使用 memmove
 template <class RandomIter, class Size, class OutputIter>
 mystl::pair<RandomIter, OutputIter> unchecked_copy_n
     (RandomIter first, Size n, OutputIter result, mystl::random_access_iterator_tag) {
         auto last = first + n;
-        return mystl::pair<InputIter, OutputIter>(last, mystl::copy(first, last, result));
+        return mystl::pair<RandomIter, OutputIter>(last, mystl::copy(first, last, result));
 }
 
-template <class RandomIter, class Size, class OutputIter>
-mystl::pair<RandomIter, OutputIter> unchecked_copy_n
-    (RandomIter first, Size n, OutputIter result) {
+template <class InputIter, class Size, class OutputIter>
+mystl::pair<InputIter, OutputIter> unchecked_copy_n
+    (InputIter first, Size n, OutputIter result) {
         return unchecked_copy_n(first, n, result, iterator_category(first));
 }
 
+template <class InputIter, class Size, class OutputIter>
+mystl::pair<InputIter, OutputIter> copy_n(InputIter first, Size n, OutputIter result) {
+    return mystl::unchecked_copy_n(first, n, result);
+}
+
+/*****************************************************************************************/
+// large_copy
+// 与 copy 相同，但连续区间的可平凡复制类型不论长短都使用非临时存储 (见 stream_copy_bytes)
+// 用于复制后短期内不会再读取的大块数据，两个区间不能重叠
+/*****************************************************************************************/
+template <class InputIter, class OutputIter>
+OutputIter unchecked_large_copy_aux(InputIter first, InputIter last, OutputIter result, m_true_type) {
+    typedef typename iterator_traits<OutputIter>::difference_type difference_type;
+    const size_t n = static_cast<size_t>(last - first);
+    mystl::stream_copy_bytes(mystl::to_address(result), mystl::to_address(first),
+                             n * sizeof(contiguous_element_t<OutputIter>));
+    return result + static_cast<difference_type>(n);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter unchecked_large_copy_aux(InputIter first, InputIter last, OutputIter result, m_false_type) {
+    return mystl::unchecked_copy(first, last, result);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter large_copy(InputIter first, InputIter last, OutputIter result) {
+    return mystl::unchecked_large_copy_aux(first, last, result,
+                                           is_bitwise_copy<InputIter, OutputIter>{});
+}
+
 /*****************************************************************************************/
 // move
 // 把 [first, last)区间内的元素移动到 [result, result + (last - first))内
@@ -210,21 +670,20 @@ OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter resu
         return result;
 }
 
+// 连续区间的可平凡移动类型使用 memmove
 template <class InputIter, class OutputIter>
-OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
-       return unchecked_move_cat(first, last, result, iterator_category(first));
+OutputIter unchecked_move_aux(InputIter first, InputIter last, OutputIter result, m_true_type) {
+    return mystl::bitwise_copy_n(first, static_cast<size_t>(last - first), result);
 }
 
-// 为 trivially_copy_assignable 类型提供特化版本
-template <class Up, class Tp>
-typename std::enable_if_t<
-    std::is_same<typename std::remove_const_t<Tp>, Up>::value &&
-    std::is_trivially_move_assignable<Up>::value, Up*>
-    unchecked_move(Tp* first, Tp* last, Up* result) {
-        const size_t n = static_cast<size_t>(last - first);
-        if(n != 0)
-            std::memmove(result, first, n * sizeof(Up));
-        return result + n;
+template <class InputIter, class OutputIter>
+OutputIter unchecked_move_aux(InputIter first, InputIter last, OutputIter result, m_false_type) {
+    return unchecked_move_cat(first, last, result, iterator_category(first));
+}
+
+template <class InputIter, class OutputIter>
+OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
+       return mystl::unchecked_move_aux(first, last, result, is_bitwise_move<InputIter, OutputIter>{});
 }
 
 template <class InputIter, class OutputIter>
@@ -254,22 +713,21 @@ BiIter2 unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last,
     return result;
 }
 
+// 连续区间的可平凡移动类型使用 memmove
 template <class BiIter1, class BiIter2>
-BiIter2 unchecked_move_backward(BiIter1 first, BiIter1 last, BiIter2 result) {
+BiIter2 unchecked_move_backward_aux(BiIter1 first, BiIter1 last, BiIter2 result, m_true_type) {
+    return mystl::bitwise_copy_backward_n(first, static_cast<size_t>(last - first), result);
+}
+
+template <class BiIter1, class BiIter2>
+BiIter2 unchecked_move_backward_aux(BiIter1 first, BiIter1 last, BiIter2 result, m_false_type) {
     return unchecked_move_backward_cat(first, last, result, iterator_category(first));
 }
 
-// 为 trivially_move_assignable 类型提供特化版本
-template <class Tp, class Up>
-typename std::enable_if_t< 
-    std::is_same<typename std::remove_const_t<Tp>, Up>::value && 
-    std::is_trivially_copy_assignable<Up>::value, Up*>
-    unchecked_move_backward(Tp* first, Tp* last, Up* result) {
-        const size_t n = static_cast<size_t>(last - first);
-        if(n != 0)
-            result -= n;
-            std::memmove(result, first, n*sizeof(Up));
-        return result;
+template <class BiIter1, class BiIter2>
+BiIter2 unchecked_move_backward(BiIter1 first, BiIter1 last, BiIter2 result) {
+    return mystl::unchecked_move_backward_aux(first, last, result,
+                                              is_bitwise_move<BiIter1, BiIter2>{});
 }
 
 template <class InputIter, class OutputIter>
@@ -277,12 +735,77 @@ OutputIter move_backward(InputIter first, InputIter last, OutputIter result) {
     return unchecked_move_backward(first, last, result);
 }
 
+/*****************************************************************************************/
+// mismatch_bytes
+// 返回两段长度为 n 的内存中第一个不同字节的偏移，完全相同时返回 n
+// 先按 32 / 16 字节向量比较，再按 8 字节的字比较
+/*****************************************************************************************/
+inline size_t mismatch_bytes_word(const unsigned char* a, const unsigned char* b, size_t n) {
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if(x != y)
+            break;
+    }
+    for(; i < n && a[i] == b[i]; ++i) {}
+    return i;
+}
+
+#ifdef MYSTL_SIMD_X86
+MYSTL_TARGET_AVX2
+inline size_t mismatch_bytes_avx2(const unsigned char* a, const unsigned char* b, size_t n) {
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        const uint32_t m = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if(m != 0)
+            return i + mystl::ctz32(m);
+    }
+    return i + mystl::mismatch_bytes_word(a + i, b + i, n - i);
+}
+
+MYSTL_TARGET_SSE42
+inline size_t mismatch_bytes_sse42(const unsigned char* a, const unsigned char* b, size_t n) {
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const uint32_t m = 0xffffu & ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+        if(m != 0)
+            return i + mystl::ctz32(m);
+    }
+    return i + mystl::mismatch_bytes_word(a + i, b + i, n - i);
+}
+#endif // MYSTL_SIMD_X86
+
+inline size_t mismatch_bytes(const void* lhs, const void* rhs, size_t n) {
+    const unsigned char* a = static_cast<const unsigned char*>(lhs);
+    const unsigned char* b = static_cast<const unsigned char*>(rhs);
+#ifdef MYSTL_SIMD_X86
+    const int level = mystl::simd_level();
+    if(level >= simd_avx2)
+        return mystl::mismatch_bytes_avx2(a, b, n);
+    if(level >= simd_sse42)
+        return mystl::mismatch_bytes_sse42(a, b, n);
+#endif // MYSTL_SIMD_X86
+    return mystl::mismatch_bytes_word(a, b, n);
+}
+
+// 两个指针区间的元素类型相同且可以逐字节比较
+template <class Tp, class Up>
+struct is_bitwise_comparable_pair : public m_bool_constant<
+    std::is_same<typename std::remove_const_t<Tp>, typename std::remove_const_t<Up>>::value &&
+    is_bitwise_comparable<typename std::remove_const_t<Tp>>::value> {};
+
 /*****************************************************************************************/
 // equal
 // 比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
     for(; first1 != last1; ++first1, ++first2) {
         if(*first1 != *first2)
             return false;
@@ -290,6 +813,19 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
     return true;
 }
 
+// 为可以逐字节比较的类型提供特化版本
+template <class Tp, class Up>
+typename std::enable_if_t<is_bitwise_comparable_pair<Tp, Up>::value, bool>
+    unchecked_equal(Tp* first1, Tp* last1, Up* first2) {
+        const auto n = static_cast<size_t>(last1 - first1);
+        return n == 0 || std::memcmp(first1, first2, n * sizeof(Tp)) == 0;
+}
+
+template <class InputIter1, class InputIter2>
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    return mystl::unchecked_equal(first1, last1, first2);
+}
+
 // 使用自定义compare
 template <class InputIter1, class InputIter2, class Compare>
 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compare comp) {
@@ -303,7 +839,50 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compare comp)
 /*****************************************************************************************/
 // fill_n
 // 从 first 位置开始填充 n 个值
+// 连续的可平凡复制类型: 值的每个字节都相同时 (如 0、-1) 使用 memset，
+// 否则把值的字节模式重复到 32 字节，以 AVX2 整块写入，超过 kNonTemporalBytes 时使用非临时存储
 /*****************************************************************************************/
+// pat 为以 sizeof(T) 为周期重复的 64 字节模式，周期整除 32，因此 pat + k 处开始的 32 字节
+// 正是目标区间中偏移为 k (0 <= k < 32) 处应写入的内容
+#ifdef MYSTL_SIMD_X86
+MYSTL_TARGET_AVX2
+inline void fill_pattern_avx2(unsigned char* p, size_t bytes, const unsigned char* pat) noexcept {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pat));
+    unsigned char* const end = p + bytes;
+    if(bytes >= kNonTemporalBytes) {
+        // 先写入未对齐的头部，再从 32 字节对齐处开始使用 stream 存储
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+        unsigned char* q = reinterpret_cast<unsigned char*>(
+            (reinterpret_cast<uintptr_t>(p) + 32) & ~static_cast<uintptr_t>(31));
+        const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pat + (q - p) % 32));
+        for(; q + 128 <= end; q += 128) {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(q), w);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(q + 32), w);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(q + 64), w);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(q + 96), w);
+        }
+        for(; q + 32 <= end; q += 32)
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(q), w);
+        _mm_sfence();
+    }
+    else {
+        unsigned char* q = p;
+        for(; q + 128 <= end; q += 128) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + 32), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + 64), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + 96), v);
+        }
+        for(; q + 32 <= end; q += 32)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(q), v);
+    }
+    // 不足 32 字节的尾部与前面的写入重叠
+    const size_t tail = bytes - 32;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + tail),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pat + tail % 32)));
+}
+#endif // MYSTL_SIMD_X86
+
 template <class OutputIter, class Size, class T>
 OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
     for(; n > 0; --n, ++first)
@@ -323,6 +902,49 @@ typename std::enable_if_t<
         return first + n;
 }
 
+// 为其它可平凡复制类型提供特化版本，值的类型相同或都为算术类型时，赋值等价于复制字节
+// 可平凡复制的类型仍可能删除了复制赋值 (例如含 const 成员)，这时不能绕过赋值直接写入字节
+template <class Tp, class Up>
+struct is_wide_fill : public m_bool_constant<
+    std::is_trivially_copyable<Tp>::value && !std::is_volatile<Tp>::value &&
+    std::is_copy_assignable<Tp>::value && std::is_assignable<Tp&, const Up&>::value &&
+    (std::is_same<Tp, Up>::value ||
+     (std::is_arithmetic<Tp>::value && std::is_arithmetic<Up>::value)) &&
+    !(std::is_integral<Tp>::value && sizeof(Tp) == 1 && !std::is_same<Tp, bool>::value &&
+      std::is_integral<Up>::value && sizeof(Up) == 1)> {};
+
+template <class Tp, class Size, class Up>
+typename std::enable_if_t<is_wide_fill<Tp, typename std::remove_cv<Up>::type>::value, Tp*>
+    unchecked_fill_n(Tp* first, Size n, const Up& value) {
+        if(n <= 0)
+            return first;
+        const Tp v = static_cast<Tp>(value);
+        const size_t count = static_cast<size_t>(n);
+        unsigned char bytes[sizeof(Tp)];
+        std::memcpy(bytes, &v, sizeof(Tp));
+        size_t k = 1;
+        while(k < sizeof(Tp) && bytes[k] == bytes[0])
+            ++k;
+        if(k == sizeof(Tp)) {
+            std::memset(static_cast<void*>(first), bytes[0], count * sizeof(Tp));
+            return first + count;
+        }
+#ifdef MYSTL_SIMD_X86
+        if(32 % sizeof(Tp) == 0 && count * sizeof(Tp) >= 32 &&
+           mystl::simd_level() >= simd_avx2) {
+            unsigned char pat[64];
+            for(size_t i = 0; i < 64; ++i)
+                pat[i] = bytes[i % sizeof(Tp)];
+            mystl::fill_pattern_avx2(reinterpret_cast<unsigned char*>(first),
+                                     count * sizeof(Tp), pat);
+            return first + count;
+        }
+#endif
+        for(size_t i = 0; i < count; ++i)
+            first[i] = v;
+        return first + count;
+}
+
 template <class OutputIter, class Size, class T>
 OutputIter fill_n(OutputIter first, Size n, const T& value) {
     return unchecked_fill_n(first, n, value);
@@ -361,37 +983,96 @@ void fill(ForwardIter first, ForwardIter last, const T& value) {
 // (4)如果同时到达 last1 和 last2 返回 false
 /*****************************************************************************************/
 template <class InputIter1, class  InputIter2>
-bool lexicographical_compare(InputIter1 first1, InputIter2 last1,
+bool unchecked_lexicographical_compare(InputIter1 first1, InputIter1 last1,
         InputIter2 first2, InputIter2 last2) {
-    for(; first1 != last1, first2 != last2; ++first1, ++first2) {
+    for(; first1 != last1 && first2 != last2; ++first1, ++first2) {
         if(*first1 < *first2)
             return true;
         if(*first2 < *first1)
             return false;
     }
-    return first1 != last1 && frist2 == first2;
+    return first1 == last1 && first2 != last2;
+}
+
+// 1 字节整型: 每次取 8 个字节，翻转为大端序后作为一个整数比较，有符号类型先翻转每个字节的符号位
+// 返回值小于 0、等于 0、大于 0 分别表示小于、相等、大于
+template <class T>
+int lexicographical_compare_bytes(const T* a, const T* b, size_t n) {
+    const uint64_t bias = std::is_signed<T>::value ? 0x8080808080808080ull : 0;
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if(x != y) {
+            x ^= bias;
+            y ^= bias;
+#ifdef MYSTL_LITTLE_ENDIAN
+            x = mystl::byte_swap(x);
+            y = mystl::byte_swap(y);
+#endif
+            return x < y ? -1 : 1;
+        }
+    }
+    for(; i < n; ++i) {
+        if(a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// 为整型的指针区间提供特化版本
+// 无符号 1 字节类型直接使用 memcmp，其余类型先找到第一个不同的元素再比较
+template <class Tp, class Up>
+typename std::enable_if_t<
+    is_bitwise_comparable_pair<Tp, Up>::value &&
+    std::is_integral<typename std::remove_const_t<Tp>>::value, bool>
+    unchecked_lexicographical_compare(Tp* first1, Tp* last1, Up* first2, Up* last2) {
+        typedef typename std::remove_const_t<Tp> value_type;
+        const auto len1 = static_cast<size_t>(last1 - first1);
+        const auto len2 = static_cast<size_t>(last2 - first2);
+        const size_t n = len1 < len2 ? len1 : len2;
+        if constexpr(sizeof(value_type) == 1) {
+            int result = 0;
+            if constexpr(!std::is_signed<value_type>::value) {
+                result = n == 0 ? 0 : std::memcmp(first1, first2, n);
+            }
+            else {
+#ifdef MYSTL_SIMD_X86
+                if(mystl::simd_level() >= simd_sse42) {
+                    const size_t i = mystl::mismatch_bytes(first1, first2, n);
+                    return i != n ? first1[i] < first2[i] : len1 < len2;
+                }
+#endif // MYSTL_SIMD_X86
+                // 没有向量指令时按 8 字节的字比较
+                result = mystl::lexicographical_compare_bytes(first1, first2, n);
+            }
+            return result != 0 ? result < 0 : len1 < len2;
+        }
+        else {
+            const size_t i = mystl::mismatch_bytes(first1, first2, n * sizeof(value_type))
+                             / sizeof(value_type);
+            return i != n ? first1[i] < first2[i] : len1 < len2;
+        }
+}
+
+template <class InputIter1, class  InputIter2>
+bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
+        InputIter2 first2, InputIter2 last2) {
+    return mystl::unchecked_lexicographical_compare(first1, last1, first2, last2);
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class  InputIter2, class Compared>
-bool lexicographical_compare(InputIter1 first1, InputIter2 last1,
+bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
         InputIter2 first2, InputIter2 last2, Compared comp) {
-    for(; first1 != last1, first2 != last2; ++first1, ++first2) {
+    for(; first1 != last1 && first2 != last2; ++first1, ++first2) {
         if(comp(*first1, *first2))
             return true;
         if(comp(*first2, *first1))
             return false;
     }
-    return first1 != last1 && frist2 == first2;
-}
-
-// 针对 const unsigned char* 的特化版本
-bool lexicographical_compare(const unsigned char* first1, const unsigned char* last1,
-        const unsigned char* first2, const unsigned char* last2) {
-    auto len1 = last1 - first1;
-    auto len2 = last2 - first2;
-    const auto result = std::memcmp(first1, first2, mystl::min(len1, len2));
-    return result != 0 ? result < 0 : len1 < len2;
+    return first1 == last1 && first2 != last2;
 }
 
 
@@ -400,22 +1081,37 @@ bool lexicographical_compare(const unsigned char* first1, const unsigned char* l
 // 平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2>
-mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 firts1, InputIter1 last1,
+mystl::pair<InputIter1, InputIter2> unchecked_mismatch(InputIter1 first1, InputIter1 last1,
         InputIter2 first2) {
     while(first1 != last1 && *first1 == *first2) {
         ++first1; ++first2;
     }
-    return mystl::pair<InputIter1, InputIter2>(frist1, first2);
+    return mystl::pair<InputIter1, InputIter2>(first1, first2);
+}
+
+// 为可以逐字节比较的类型提供特化版本，使用 SIMD 查找第一个不同的字节
+template <class Tp, class Up>
+typename std::enable_if_t<is_bitwise_comparable_pair<Tp, Up>::value, mystl::pair<Tp*, Up*>>
+    unchecked_mismatch(Tp* first1, Tp* last1, Up* first2) {
+        const auto n = static_cast<size_t>(last1 - first1);
+        const size_t i = mystl::mismatch_bytes(first1, first2, n * sizeof(Tp)) / sizeof(Tp);
+        return mystl::pair<Tp*, Up*>(first1 + i, first2 + i);
+}
+
+template <class InputIter1, class InputIter2>
+mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1,
+        InputIter2 first2) {
+    return mystl::unchecked_mismatch(first1, last1, first2);
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compared>
-mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 firts1, InputIter1 last1,
+mystl::pair<InputIter1, InputIter2> mismatch(InputIter1 first1, InputIter1 last1,
         InputIter2 first2, Compared comp) {
     while(first1 != last1 && comp(*first1, *first2)) {
         ++first1; ++first2;
     }
-    return mystl::pair<InputIter1, InputIter2>(frist1, first2);
+    return mystl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
 
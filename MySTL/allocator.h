@@ -1,4 +1,4 @@
-#ifndef MYSTL_ALLOCATOR_H
+#ifndef MYSTL_ALLOCATOR_H_
 #define MYSTL_ALLOCATOR_H_
 
 // 这个头文件包含一个模板类 allocator，用于管理内存的分配、释放，对象的构造、析构
@@ -19,7 +19,7 @@ public:
     typedef T&              reference;
     typedef const T&        const_reference;
     typedef size_t          size_type;
-    typedef ptridiff_t      difference_type;
+    typedef ptrdiff_t       difference_type;
 
 public:
     static T*   allocate();    
@@ -88,7 +88,7 @@ void allocator<T>::construct(T* ptr, Args&& ...args) {
 
 template <class T>
 void allocator<T>::destory(T* ptr) {
-    mystl::destory(ptr);
+    mystl::destory_one(ptr);
 }
 
 template <class T>
@@ -5,6 +5,7 @@
 
 #include "type_traits.h"
 #include "iterator.h"
+#include "util.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -26,12 +27,12 @@ void construct(Ty* ptr) {
 
 template <class Ty1, class Ty2>
 void construct(Ty1* ptr, const Ty2& value) {
-    ::new((void*)ptr) Ty(value);
+    ::new((void*)ptr) Ty1(value);
 }
 
 template <class Ty1, class... Args>
 void construct(Ty1* ptr, Args&&... args) {
-    ::new((void*)ptr) Ty(mystl::forward<Args>(args)...);
+    ::new((void*)ptr) Ty1(mystl::forward<Args>(args)...);
 }
 
 // destory 析构
@@ -44,18 +45,18 @@ void destory_one(Ty* pointer, std::false_type) {
         pointer -> ~Ty();
 }
 
+template <class Ty>
+void destory_one(Ty* pointer) {
+    destory_one(pointer, std::is_trivially_destructible<Ty>{});
+}
+
 template <class ForwardIter>
 void destory_cat(ForwardIter first, ForwardIter last, std::true_type) {}
 
 template <class ForwardIter>
 void destory_cat(ForwardIter first, ForwardIter last, std::false_type) {
     for(; first != last; ++first)
-        destory(&*first);
-}
-
-template <class Ty>
-void destory_one(Ty* pointer) {
-    destory_one(pointer, std::is_trivially_destructible<Ty>{});
+        destory_one(&*first);
 }
 
 template <class ForwardIter>
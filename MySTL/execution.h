@@ -0,0 +1,944 @@
+#ifndef MYSTL_EXECUTION_H_
+#define MYSTL_EXECUTION_H_
+
+// 这个头文件包含执行策略 seq / par / par_unseq，以及以执行策略为第一个参数的算法重载
+// for_each, transform, count, count_if, find, find_if, fill, copy, large_copy, accumulate, reduce,
+// transform_reduce, compensated_reduce, compensated_transform_reduce,
+// inclusive_scan, exclusive_scan, transform_inclusive_scan, transform_exclusive_scan, sort
+
+// par 与 par_unseq 把区间分块交给 parallel.h 的线程池，各块内部调用串行版本，
+// 因此连续区间上的快速路径在块内仍然有效
+// 只有随机访问迭代器的区间会被并行处理，其它情况以及较短的区间退回串行版本
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "algo.h"
+#include "numeric.h"
+#include "memory.h"
+#include "parallel.h"
+
+namespace mystl {
+
+/*****************************************************************************************/
+// 执行策略
+// seq: 串行执行
+// par: 允许多线程执行，元素访问函数在各线程内顺序调用
+// par_unseq: 允许多线程执行，并允许在线程内向量化
+/*****************************************************************************************/
+namespace execution {
+
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+constexpr static sequenced_policy            seq{};
+constexpr static parallel_policy             par{};
+constexpr static parallel_unsequenced_policy par_unseq{};
+
+} // namespace execution
+
+template <class T>
+struct is_execution_policy : public m_false_type {};
+
+template <>
+struct is_execution_policy<execution::sequenced_policy> : public m_true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_policy> : public m_true_type {};
+
+template <>
+struct is_execution_policy<execution::parallel_unsequenced_policy> : public m_true_type {};
+
+// 允许多线程执行的策略
+template <class T>
+struct is_parallel_policy : public m_bool_constant<
+    std::is_same<T, execution::parallel_policy>::value ||
+    std::is_same<T, execution::parallel_unsequenced_policy>::value> {};
+
+// 只有第一个参数是执行策略时才参与重载决议，避免与串行版本冲突
+template <class ExecutionPolicy, class T>
+using enable_if_execution_policy_t =
+    std::enable_if_t<is_execution_policy<std::decay_t<ExecutionPolicy>>::value, T>;
+
+// 策略允许多线程执行，且所有迭代器都可以随机访问时使用并行版本
+template <class ExecutionPolicy, class... Iters>
+struct is_parallel_execution : public m_bool_constant<
+    is_parallel_policy<std::decay_t<ExecutionPolicy>>::value &&
+    (is_random_access_iterator<Iters>::value && ...)> {};
+
+constexpr static size_t kParallelGrain     = 1 << 14;  // 每块至少处理的元素个数
+constexpr static size_t kParallelFindBlock = 1 << 12;  // 并行查找时检查是否已经找到的间隔
+constexpr static size_t kParallelSortGrain = 1 << 14;  // 并行排序每块至少处理的元素个数
+constexpr static size_t kParallelScanTile  = 1 << 14;  // 单趟前缀和每个分片的元素个数
+
+/*****************************************************************************************/
+// for_each
+// 对[first, last)区间内的每个元素执行 f，各元素的调用顺序不确定
+/*****************************************************************************************/
+template <class ExecutionPolicy, class ForwardIter, class Function>
+enable_if_execution_policy_t<ExecutionPolicy, void>
+for_each(ExecutionPolicy&&, ForwardIter first, ForwardIter last, Function f) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+                mystl::for_each(first + b, first + e, f);
+            });
+            return;
+        }
+    }
+    mystl::for_each(first, last, f);
+}
+
+/*****************************************************************************************/
+// transform
+// 第一个版本以 unary_op 作用于[first, last)中的每个元素，第二个版本以 binary_op 作用于两个序列的相同位置
+// 结果保存至 result 中，返回结果区间的尾部
+/*****************************************************************************************/
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class UnaryOperation>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+transform(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+          UnaryOperation unary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+                mystl::transform(first + b, first + e, result + b, unary_op);
+            });
+            return result + n;
+        }
+    }
+    return mystl::transform(first, last, result, unary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class OutputIter,
+          class BinaryOperation>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+transform(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+          ForwardIter2 last2, OutputIter result, BinaryOperation binary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2,
+                                       OutputIter>::value) {
+        const auto n = static_cast<size_t>(last1 - first1);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+                mystl::transform(first1 + b, first1 + e, first2 + b, first2 + e, result + b,
+                                 binary_op);
+            });
+            return result + n;
+        }
+    }
+    return mystl::transform(first1, last1, first2, last2, result, binary_op);
+}
+
+/*****************************************************************************************/
+// count / count_if
+// 各块分别计数后相加
+/*****************************************************************************************/
+// 块内计数由 count_block(b, e) 完成
+template <class CountBlock>
+size_t parallel_count_aux(size_t n, CountBlock count_block) {
+    std::atomic<size_t> total(0);
+    mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+        total.fetch_add(count_block(b, e), std::memory_order_relaxed);
+    });
+    return total.load(std::memory_order_relaxed);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, size_t>
+count(ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& value) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            return mystl::parallel_count_aux(n, [&](size_t b, size_t e) {
+                return mystl::count(first + b, first + e, value);
+            });
+        }
+    }
+    return mystl::count(first, last, value);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+enable_if_execution_policy_t<ExecutionPolicy, size_t>
+count_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            return mystl::parallel_count_aux(n, [&](size_t b, size_t e) {
+                return mystl::count_if(first + b, first + e, unary_pred);
+            });
+        }
+    }
+    return mystl::count_if(first, last, unary_pred);
+}
+
+/*****************************************************************************************/
+// find / find_if
+// 各块以 kParallelFindBlock 为单位查找，共享目前找到的最小下标
+// 起点已经超过该下标的块和子块直接跳过，结果与串行版本相同，总是第一个满足条件的元素
+/*****************************************************************************************/
+// 在 [b, e) 中查找由 find_block(b, e) 完成，返回找到的下标，没有找到时返回 e
+template <class FindBlock>
+size_t parallel_find_aux(size_t n, FindBlock find_block) {
+    std::atomic<size_t> found(n);
+    mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+        for(size_t sb = b; sb < e; sb += kParallelFindBlock) {
+            if(sb >= found.load(std::memory_order_relaxed))
+                return;
+            const size_t se = e - sb < kParallelFindBlock ? e : sb + kParallelFindBlock;
+            const size_t i = find_block(sb, se);
+            if(i != se) {
+                size_t cur = found.load(std::memory_order_relaxed);
+                while(i < cur && !found.compare_exchange_weak(cur, i, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    });
+    return found.load(std::memory_order_relaxed);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, ForwardIter>
+find(ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& value) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            return first + mystl::parallel_find_aux(n, [&](size_t b, size_t e) {
+                return static_cast<size_t>(mystl::find(first + b, first + e, value) - first);
+            });
+        }
+    }
+    return mystl::find(first, last, value);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+enable_if_execution_policy_t<ExecutionPolicy, ForwardIter>
+find_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            return first + mystl::parallel_find_aux(n, [&](size_t b, size_t e) {
+                return static_cast<size_t>(mystl::find_if(first + b, first + e, unary_pred) - first);
+            });
+        }
+    }
+    return mystl::find_if(first, last, unary_pred);
+}
+
+/*****************************************************************************************/
+// fill
+// 为[first, last)区间内的所有元素填充新值
+/*****************************************************************************************/
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, void>
+fill(ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& value) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_chunk_count(n, kParallelGrain) > 1) {
+            mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+                mystl::fill(first + b, first + e, value);
+            });
+            return;
+        }
+    }
+    mystl::fill(first, last, value);
+}
+
+/*****************************************************************************************/
+// copy / large_copy
+// 把[first, last)区间内的元素拷贝到[result, result + (last - first))内，两个区间不能重叠
+// 连续区间的可平凡复制类型: copy 的总字节数超过 kNonTemporalBytes 时，各块与串行版本一样使用非临时存储，
+// large_copy 则总是使用非临时存储
+/*****************************************************************************************/
+// 各块由 copy_block(b, e) 复制，区间太短时返回 false，由调用者使用串行版本
+template <class CopyBlock>
+bool parallel_copy_blocks(size_t n, CopyBlock copy_block) {
+    if(mystl::parallel_chunk_count(n, kParallelGrain) <= 1)
+        return false;
+    mystl::parallel_for_chunks(n, kParallelGrain, copy_block);
+    return true;
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+copy(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        const auto n = static_cast<size_t>(last - first);
+        const bool stream = is_bitwise_copy<ForwardIter, OutputIter>::value &&
+                            n >= kNonTemporalBytes / sizeof(value_type);
+        if(mystl::parallel_copy_blocks(n, [&](size_t b, size_t e) {
+               if(stream)
+                   mystl::large_copy(first + b, first + e, result + b);
+               else
+                   mystl::copy(first + b, first + e, result + b);
+           }))
+            return result + n;
+    }
+    return mystl::copy(first, last, result);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+large_copy(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if(mystl::parallel_copy_blocks(n, [&](size_t b, size_t e) {
+               mystl::large_copy(first + b, first + e, result + b);
+           }))
+            return result + n;
+    }
+    return mystl::large_copy(first, last, result);
+}
+
+/*****************************************************************************************/
+// accumulate
+// 版本1：以初值 init 对每个元素进行累加
+// 版本2：以初值 init 对每个元素进行二元操作
+// 并行时各块分别归约，再按块的顺序合并，要求运算满足结合律，不要求交换律
+// 第一块从 init 开始，其余各块从块内第一个元素开始
+/*****************************************************************************************/
+// 各块的部分结果，T 不要求可以默认构造
+template <class T>
+class parallel_partial_results {
+private:
+    T*     data;
+    bool*  built;
+    size_t count;
+
+public:
+    explicit parallel_partial_results(size_t n)
+        : data(static_cast<T*>(::operator new(n * sizeof(T)))), built(nullptr), count(n) {
+        try {
+            built = new bool[n]();
+        }
+        catch(...) {
+            ::operator delete(data);
+            throw;
+        }
+    }
+
+    ~parallel_partial_results() {
+        for(size_t i = 0; i < count; ++i) {
+            if(built[i])
+                mystl::destory(data + i, data + i + 1);
+        }
+        delete[] built;
+        ::operator delete(data);
+    }
+
+    void set(size_t i, const T& value) {
+        mystl::construct(data + i, value);
+        built[i] = true;
+    }
+
+    T& operator[](size_t i) noexcept { return data[i]; }
+
+private:
+    parallel_partial_results(const parallel_partial_results&);
+    void operator=(const parallel_partial_results&);
+};
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+accumulate(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T init) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            parallel_partial_results<T> partial(parts);
+            mystl::parallel_invoke_n(parts, [&](size_t p) {
+                const size_t b = mystl::parallel_chunk_begin(n, parts, p);
+                const size_t e = mystl::parallel_chunk_begin(n, parts, p + 1);
+                if(p == 0)
+                    partial.set(p, mystl::accumulate(first, first + e, init));
+                else
+                    partial.set(p, mystl::accumulate(first + (b + 1), first + e, T(first[b])));
+            });
+            for(size_t p = 1; p < parts; ++p)
+                partial[0] += partial[p];
+            return partial[0];
+        }
+    }
+    return mystl::accumulate(first, last, init);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+accumulate(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T init, BinaryOp binary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            parallel_partial_results<T> partial(parts);
+            mystl::parallel_invoke_n(parts, [&](size_t p) {
+                const size_t b = mystl::parallel_chunk_begin(n, parts, p);
+                const size_t e = mystl::parallel_chunk_begin(n, parts, p + 1);
+                if(p == 0)
+                    partial.set(p, mystl::accumulate(first, first + e, init, binary_op));
+                else
+                    partial.set(p, mystl::accumulate(first + (b + 1), first + e, T(first[b]),
+                                                     binary_op));
+            });
+            for(size_t p = 1; p < parts; ++p)
+                partial[0] = binary_op(partial[0], partial[p]);
+            return partial[0];
+        }
+    }
+    return mystl::accumulate(first, last, init, binary_op);
+}
+
+/*****************************************************************************************/
+// reduce / transform_reduce
+// 各块调用串行版本，连续浮点区间在块内仍然使用向量化内核，再按块的顺序合并
+// 第一块从 init 开始，其余各块从块内第一个元素开始
+/*****************************************************************************************/
+// reduce_block(b, e, p) 返回第 p 块 [b, e) 的归约值，块非空
+template <class T, class ReduceBlock, class BinaryOp>
+T parallel_reduce_blocks(size_t n, size_t parts, ReduceBlock reduce_block, BinaryOp binary_op) {
+    parallel_partial_results<T> partial(parts);
+    mystl::parallel_invoke_n(parts, [&](size_t p) {
+        partial.set(p, reduce_block(mystl::parallel_chunk_begin(n, parts, p),
+                                    mystl::parallel_chunk_begin(n, parts, p + 1), p));
+    });
+    for(size_t p = 1; p < parts; ++p)
+        partial[0] = binary_op(partial[0], partial[p]);
+    return partial[0];
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+reduce(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T init, BinaryOp binary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            return mystl::parallel_reduce_blocks<T>(n, parts, [&](size_t b, size_t e, size_t p) {
+                if(p == 0)
+                    return mystl::reduce(first, first + e, init, binary_op);
+                return mystl::reduce(first + (b + 1), first + e, T(first[b]), binary_op);
+            }, binary_op);
+        }
+    }
+    return mystl::reduce(first, last, init, binary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T init) {
+    return mystl::reduce(policy, first, last, init, mystl::plus<T>());
+}
+
+template <class ExecutionPolicy, class ForwardIter>
+enable_if_execution_policy_t<ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>
+reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last) {
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::reduce(policy, first, last, value_type(), mystl::plus<value_type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T,
+          class BinaryOp1, class BinaryOp2>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+                 T init, BinaryOp1 binary_op1, BinaryOp2 binary_op2) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>::value) {
+        const auto n = static_cast<size_t>(last1 - first1);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            return mystl::parallel_reduce_blocks<T>(n, parts, [&](size_t b, size_t e, size_t p) {
+                if(p == 0)
+                    return mystl::transform_reduce(first1, first1 + e, first2, init,
+                                                   binary_op1, binary_op2);
+                return mystl::transform_reduce(first1 + (b + 1), first1 + e, first2 + (b + 1),
+                                               T(binary_op2(first1[b], first2[b])),
+                                               binary_op1, binary_op2);
+            }, binary_op1);
+        }
+    }
+    return mystl::transform_reduce(first1, last1, first2, init, binary_op1, binary_op2);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1,
+                 ForwardIter2 first2, T init) {
+    return mystl::transform_reduce(policy, first1, last1, first2, init,
+                                   mystl::plus<T>(), mystl::multiplies<T>());
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T, class BinaryOp, class UnaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T init,
+                 BinaryOp binary_op, UnaryOp unary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            return mystl::parallel_reduce_blocks<T>(n, parts, [&](size_t b, size_t e, size_t p) {
+                if(p == 0)
+                    return mystl::transform_reduce(first, first + e, init, binary_op, unary_op);
+                return mystl::transform_reduce(first + (b + 1), first + e, T(unary_op(first[b])),
+                                               binary_op, unary_op);
+            }, binary_op);
+        }
+    }
+    return mystl::transform_reduce(first, last, init, binary_op, unary_op);
+}
+
+/*****************************************************************************************/
+// compensated_reduce / compensated_transform_reduce
+// 各块从零开始得到各自的和与误差，再按块的顺序以 TwoSum 合并，合并本身也不丢失精度
+/*****************************************************************************************/
+template <class ExecutionPolicy, class ForwardIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+compensated_reduce(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T init) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            compensated_sum<T> acc(init);
+            acc.merge(mystl::parallel_reduce_blocks<compensated_sum<T>>(n, parts,
+                [&](size_t b, size_t e, size_t) {
+                    compensated_sum<T> block;
+                    mystl::compensated_reduce_aux(first + b, first + e, block);
+                    return block;
+                },
+                [](compensated_sum<T> x, const compensated_sum<T>& y) {
+                    x.merge(y);
+                    return x;
+                }));
+            return acc.value();
+        }
+    }
+    return mystl::compensated_reduce(first, last, init);
+}
+
+template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class T>
+enable_if_execution_policy_t<ExecutionPolicy, T>
+compensated_transform_reduce(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1,
+                             ForwardIter2 first2, T init) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter1, ForwardIter2>::value) {
+        const auto n = static_cast<size_t>(last1 - first1);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            compensated_sum<T> acc(init);
+            acc.merge(mystl::parallel_reduce_blocks<compensated_sum<T>>(n, parts,
+                [&](size_t b, size_t e, size_t) {
+                    compensated_sum<T> block;
+                    mystl::compensated_transform_reduce_aux(first1 + b, first1 + e, first2 + b,
+                                                            block);
+                    return block;
+                },
+                [](compensated_sum<T> x, const compensated_sum<T>& y) {
+                    x.merge(y);
+                    return x;
+                }));
+            return acc.value();
+        }
+    }
+    return mystl::compensated_transform_reduce(first1, last1, first2, init);
+}
+
+/*****************************************************************************************/
+// inclusive_scan / exclusive_scan / transform_inclusive_scan / transform_exclusive_scan
+// 要求运算满足结合律，不要求交换律，result 可以等于 first
+// 一般情况分两趟: 先并行求各块的归约值，串行算出每块的进位，再并行地从进位开始扫描各块
+// 连续整型区间的加法使用单趟的 decoupled look-back: 每个分片先公布自己的总和，
+// 再向前查看已公布的总和或前缀，直到遇到已经公布前缀的分片，只读写一次区间
+/*****************************************************************************************/
+// reduce(b, e) 返回块 [b, e) 的归约值，块非空
+// scan(b, e, carry) 从 *carry 开始扫描块 [b, e)，carry 为空指针时从块内第一个元素开始
+// init 为空指针时第一块没有初值
+template <class T, class Reduce, class Scan, class Combine>
+void parallel_scan_aux(size_t n, size_t parts, const T* init,
+                       Reduce reduce, Scan scan, Combine combine) {
+    parallel_partial_results<T> sum(parts - 1);
+    mystl::parallel_invoke_n(parts - 1, [&](size_t p) {
+        sum.set(p, reduce(mystl::parallel_chunk_begin(n, parts, p),
+                          mystl::parallel_chunk_begin(n, parts, p + 1)));
+    });
+    parallel_partial_results<T> carry(parts);
+    carry.set(1, init ? combine(*init, sum[0]) : sum[0]);
+    for(size_t p = 2; p < parts; ++p)
+        carry.set(p, combine(carry[p - 1], sum[p - 1]));
+    mystl::parallel_invoke_n(parts, [&](size_t p) {
+        scan(mystl::parallel_chunk_begin(n, parts, p), mystl::parallel_chunk_begin(n, parts, p + 1),
+             p == 0 ? init : &carry[p]);
+    });
+}
+
+// 可以使用单趟前缀和的情形: 两个迭代器都是指针，元素为 4 或 8 字节的整数，运算为加法
+template <class Iter, class OutputIter, class BinaryOp, class T>
+struct is_parallel_prefix_sum : public m_false_type {};
+
+template <class Tp, class T>
+struct is_parallel_prefix_sum<Tp*, T*, mystl::plus<T>, T> : public m_bool_constant<
+    is_scan_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value> {};
+
+// 分片由 parallel_invoke_n 按下标递增的顺序领取，每个分片只等待更早领取的分片，
+// 而后者公布总和前不等待任何分片，因此不会死锁
+template <bool Exclusive, class T>
+void parallel_prefix_sum(const T* a, size_t n, T* out, T init) {
+    const size_t tiles = (n + kParallelScanTile - 1) / kParallelScanTile;
+    enum : unsigned char { tile_empty = 0, tile_aggregate = 1, tile_prefix = 2 };
+    std::atomic<unsigned char>* status = new std::atomic<unsigned char>[tiles]();
+    T* aggregate = nullptr;
+    T* inclusive = nullptr;
+    try {
+        aggregate = new T[tiles];
+        inclusive = new T[tiles];
+        mystl::parallel_invoke_n(tiles, [&](size_t i) {
+            const size_t b = i * kParallelScanTile;
+            const size_t len = n - b < kParallelScanTile ? n - b : kParallelScanTile;
+            const T sum = mystl::wrapping_sum(a + b, len);
+            T prefix = init;
+            if(i == 0) {
+                inclusive[0] = mystl::wrapping_add(init, sum);
+                status[0].store(tile_prefix, std::memory_order_release);
+            }
+            else {
+                aggregate[i] = sum;
+                status[i].store(tile_aggregate, std::memory_order_release);
+                T look = T();
+                for(size_t j = i; j-- > 0; ) {
+                    unsigned char st;
+                    size_t idle = 0;
+                    while((st = status[j].load(std::memory_order_acquire)) == tile_empty) {
+                        if(++idle < kPoolSpinRounds)
+                            mystl::cpu_relax();
+                        else
+                            std::this_thread::yield();
+                    }
+                    if(st == tile_prefix) {
+                        look = mystl::wrapping_add(look, inclusive[j]);
+                        break;
+                    }
+                    look = mystl::wrapping_add(look, aggregate[j]);
+                }
+                prefix = look;
+                inclusive[i] = mystl::wrapping_add(prefix, sum);
+                status[i].store(tile_prefix, std::memory_order_release);
+            }
+            mystl::prefix_sum<Exclusive>(a + b, len, out + b, prefix);
+        });
+    }
+    catch(...) {
+        delete[] inclusive;
+        delete[] aggregate;
+        delete[] status;
+        throw;
+    }
+    delete[] inclusive;
+    delete[] aggregate;
+    delete[] status;
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class BinaryOp, class T>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+               BinaryOp binary_op, T init) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if constexpr(is_parallel_prefix_sum<ForwardIter, OutputIter, BinaryOp, T>::value) {
+            if(n >= 2 * kParallelScanTile) {
+                mystl::parallel_prefix_sum<false>(first, n, result, init);
+                return result + n;
+            }
+        }
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            mystl::parallel_scan_aux(n, parts, &init,
+                [&](size_t b, size_t e) {
+                    return mystl::accumulate(first + (b + 1), first + e, T(first[b]), binary_op);
+                },
+                [&](size_t b, size_t e, const T* carry) {
+                    mystl::unchecked_inclusive_scan(first + b, first + e, result + b,
+                                                    binary_op, *carry);
+                },
+                binary_op);
+            return result + n;
+        }
+    }
+    return mystl::inclusive_scan(first, last, result, binary_op, init);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class BinaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+               BinaryOp binary_op) {
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if constexpr(is_parallel_prefix_sum<ForwardIter, OutputIter, BinaryOp, value_type>::value) {
+            if(n >= 2 * kParallelScanTile) {
+                mystl::parallel_prefix_sum<false>(first, n, result, value_type(0));
+                return result + n;
+            }
+        }
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            mystl::parallel_scan_aux<value_type>(n, parts, nullptr,
+                [&](size_t b, size_t e) {
+                    return mystl::accumulate(first + (b + 1), first + e, value_type(first[b]),
+                                             binary_op);
+                },
+                [&](size_t b, size_t e, const value_type* carry) {
+                    if(carry)
+                        mystl::unchecked_inclusive_scan(first + b, first + e, result + b,
+                                                        binary_op, *carry);
+                    else
+                        mystl::inclusive_scan(first + b, first + e, result + b, binary_op);
+                },
+                binary_op);
+            return result + n;
+        }
+    }
+    return mystl::inclusive_scan(first, last, result, binary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+inclusive_scan(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, OutputIter result) {
+    typedef typename iterator_traits<ForwardIter>::value_type value_type;
+    return mystl::inclusive_scan(policy, first, last, result, mystl::plus<value_type>());
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class T, class BinaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+exclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+               T init, BinaryOp binary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        if constexpr(is_parallel_prefix_sum<ForwardIter, OutputIter, BinaryOp, T>::value) {
+            if(n >= 2 * kParallelScanTile) {
+                mystl::parallel_prefix_sum<true>(first, n, result, init);
+                return result + n;
+            }
+        }
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            mystl::parallel_scan_aux(n, parts, &init,
+                [&](size_t b, size_t e) {
+                    return mystl::accumulate(first + (b + 1), first + e, T(first[b]), binary_op);
+                },
+                [&](size_t b, size_t e, const T* carry) {
+                    mystl::unchecked_exclusive_scan(first + b, first + e, result + b,
+                                                    *carry, binary_op);
+                },
+                binary_op);
+            return result + n;
+        }
+    }
+    return mystl::exclusive_scan(first, last, result, init, binary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class T>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+exclusive_scan(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, OutputIter result,
+               T init) {
+    return mystl::exclusive_scan(policy, first, last, result, init, mystl::plus<T>());
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class BinaryOp,
+          class UnaryOp, class T>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+transform_inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+                         BinaryOp binary_op, UnaryOp unary_op, T init) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            mystl::parallel_scan_aux(n, parts, &init,
+                [&](size_t b, size_t e) {
+                    T value = unary_op(first[b]);
+                    for(++b; b != e; ++b)
+                        value = binary_op(value, unary_op(first[b]));
+                    return value;
+                },
+                [&](size_t b, size_t e, const T* carry) {
+                    mystl::transform_inclusive_scan(first + b, first + e, result + b,
+                                                    binary_op, unary_op, *carry);
+                },
+                binary_op);
+            return result + n;
+        }
+    }
+    return mystl::transform_inclusive_scan(first, last, result, binary_op, unary_op, init);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class BinaryOp, class UnaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+transform_inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+                         BinaryOp binary_op, UnaryOp unary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        typedef std::decay_t<decltype(unary_op(*first))> value_type;
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            mystl::parallel_scan_aux<value_type>(n, parts, nullptr,
+                [&](size_t b, size_t e) {
+                    value_type value = unary_op(first[b]);
+                    for(++b; b != e; ++b)
+                        value = binary_op(value, unary_op(first[b]));
+                    return value;
+                },
+                [&](size_t b, size_t e, const value_type* carry) {
+                    if(carry)
+                        mystl::transform_inclusive_scan(first + b, first + e, result + b,
+                                                        binary_op, unary_op, *carry);
+                    else
+                        mystl::transform_inclusive_scan(first + b, first + e, result + b,
+                                                        binary_op, unary_op);
+                },
+                binary_op);
+            return result + n;
+        }
+    }
+    return mystl::transform_inclusive_scan(first, last, result, binary_op, unary_op);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class OutputIter, class T, class BinaryOp,
+          class UnaryOp>
+enable_if_execution_policy_t<ExecutionPolicy, OutputIter>
+transform_exclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+                         T init, BinaryOp binary_op, UnaryOp unary_op) {
+    if constexpr(is_parallel_execution<ExecutionPolicy, ForwardIter, OutputIter>::value) {
+        const auto n = static_cast<size_t>(last - first);
+        const size_t parts = mystl::parallel_chunk_count(n, kParallelGrain);
+        if(parts > 1) {
+            mystl::parallel_scan_aux(n, parts, &init,
+                [&](size_t b, size_t e) {
+                    T value = unary_op(first[b]);
+                    for(++b; b != e; ++b)
+                        value = binary_op(value, unary_op(first[b]));
+                    return value;
+                },
+                [&](size_t b, size_t e, const T* carry) {
+                    mystl::transform_exclusive_scan(first + b, first + e, result + b,
+                                                    *carry, binary_op, unary_op);
+                },
+                binary_op);
+            return result + n;
+        }
+    }
+    return mystl::transform_exclusive_scan(first, last, result, init, binary_op, unary_op);
+}
+
+/*****************************************************************************************/
+// sort
+// 将[first, last)内的元素以递增的方式排序，不保证相等元素的相对位置
+// 并行时先对各块分别排序，再逐轮两两归并，元素在原区间和缓冲区之间交替存放
+// 归并的对数少于块数时，每对按输出位置再切分(merge path)，使每轮都有足够的任务
+// 无法申请到足够的缓冲区时退回串行版本
+/*****************************************************************************************/
+// 归并 a[0, la) 与 b[0, lb) 时，输出的前 k 个元素中来自 a 的个数
+template <class Iter1, class Iter2, class Compared>
+size_t merge_path_split(Iter1 a, size_t la, Iter2 b, size_t lb, size_t k, Compared& comp) {
+    size_t lo = k > lb ? k - lb : 0;
+    size_t hi = k < la ? k : la;
+    while(lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        if(comp(a[i], b[k - i - 1]))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+// 一轮归并: src 中相邻的两个有序块 [bound[j], bound[j + width]) 与 [bound[j + width], bound[j + 2 * width])
+// 归并到 dst 的相同位置，落单的块直接拷贝
+template <class Iter1, class Iter2, class Compared>
+void parallel_merge_round(Iter1 src, Iter2 dst, const size_t* bound, size_t parts,
+                          size_t width, Compared& comp) {
+    const size_t pairs = (parts + 2 * width - 1) / (2 * width);
+    const size_t pieces = (parts + pairs - 1) / pairs;
+    mystl::parallel_invoke_n(pairs * pieces, [&](size_t t) {
+        const size_t j = t / pieces * 2 * width;
+        const size_t piece = t % pieces;
+        const size_t mid_part = j + width < parts ? j + width : parts;
+        const size_t end_part = j + 2 * width < parts ? j + 2 * width : parts;
+        const size_t lo = bound[j], mid = bound[mid_part], hi = bound[end_part];
+        const size_t len = hi - lo;
+        const size_t k0 = len / pieces * piece + (piece < len % pieces ? piece : len % pieces);
+        const size_t k1 = len / pieces * (piece + 1) +
+                          (piece + 1 < len % pieces ? piece + 1 : len % pieces);
+        if(k0 == k1)
+            return;
+        const size_t la = mid - lo, lb = hi - mid;
+        const size_t i0 = mystl::merge_path_split(src + lo, la, src + mid, lb, k0, comp);
+        const size_t i1 = mystl::merge_path_split(src + lo, la, src + mid, lb, k1, comp);
+        mystl::merge(src + (lo + i0), src + (lo + i1), src + (mid + (k0 - i0)),
+                     src + (mid + (k1 - i1)), dst + (lo + k0), comp);
+    });
+}
+
+template <class RandomIter, class Compared>
+void parallel_sort_aux(RandomIter first, RandomIter last, Compared comp) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const auto n = static_cast<size_t>(last - first);
+    const size_t parts = mystl::parallel_chunk_count(n, kParallelSortGrain);
+    if(parts <= 1) {
+        mystl::sort(first, last, comp);
+        return;
+    }
+    temporary_buffer<RandomIter, value_type> buf(first, last);
+    if(static_cast<size_t>(buf.size()) != n) {
+        mystl::sort(first, last, comp);
+        return;
+    }
+    size_t* bound = new size_t[parts + 1];
+    try {
+        for(size_t p = 0; p <= parts; ++p)
+            bound[p] = mystl::parallel_chunk_begin(n, parts, p);
+        mystl::parallel_invoke_n(parts, [&](size_t p) {
+            mystl::sort(first + bound[p], first + bound[p + 1], comp);
+        });
+        bool in_buffer = false;
+        for(size_t width = 1; width < parts; width *= 2) {
+            if(in_buffer)
+                mystl::parallel_merge_round(buf.begin(), first, bound, parts, width, comp);
+            else
+                mystl::parallel_merge_round(first, buf.begin(), bound, parts, width, comp);
+            in_buffer = !in_buffer;
+        }
+        if(in_buffer) {
+            value_type* data = buf.begin();
+            mystl::parallel_for_chunks(n, kParallelGrain, [&](size_t b, size_t e) {
+                mystl::copy(data + b, data + e, first + b);
+            });
+        }
+    }
+    catch(...) {
+        delete[] bound;
+        throw;
+    }
+    delete[] bound;
+}
+
+template <class ExecutionPolicy, class RandomIter>
+enable_if_execution_policy_t<ExecutionPolicy, void>
+sort(ExecutionPolicy&&, RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    if constexpr(is_parallel_policy<std::decay_t<ExecutionPolicy>>::value)
+        mystl::parallel_sort_aux(first, last, mystl::less<value_type>());
+    else
+        mystl::sort(first, last);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class ExecutionPolicy, class RandomIter, class Compared>
+enable_if_execution_policy_t<ExecutionPolicy, void>
+sort(ExecutionPolicy&&, RandomIter first, RandomIter last, Compared comp) {
+    if constexpr(is_parallel_policy<std::decay_t<ExecutionPolicy>>::value)
+        mystl::parallel_sort_aux(first, last, comp);
+    else
+        mystl::sort(first, last, comp);
+}
+
+} // namespace mystl
+
+#endif // MYSTL_EXECUTION_H_
@@ -149,6 +149,27 @@ struct projectsecond : public binary_function<Arg1, Arg2, Arg2> {
     Arg2 operator()(const Arg1& x, const Arg2& y)const {return y;}
 };
 
+// **** 函数对象适配器 **** //
+// 绑定二元函数对象的第二个参数，得到一元函数对象
+// examples: remove_if(first, last, bind2nd(less<int>(), 0)); 移除所有负数
+// 绑定 equal_to、less 等比较函数对象时，连续算术区间上的算法可以把它展开为向量比较
+template <class Operation>
+struct binder2nd : public unarg_function<typename Operation::first_argument_type,
+                                         typename Operation::result_type> {
+    Operation op;
+    typename Operation::second_argument_type value;
+
+    binder2nd(const Operation& x, const typename Operation::second_argument_type& y)
+        : op(x), value(y) {}
+    typename Operation::result_type
+    operator()(const typename Operation::first_argument_type& x)const {return op(x, value);}
+};
+
+template <class Operation, class T>
+binder2nd<Operation> bind2nd(const Operation& op, const T& x) {
+    return binder2nd<Operation>(op, typename Operation::second_argument_type(x));
+}
+
 //哈希函数对象
 template <class Key>
 struct hash {};
@@ -2,8 +2,14 @@
 #define MYSTL_HEAP_ALGO_H_
 
 // 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及它们的 d 叉堆版本 : push_dary_heap, pop_dary_heap, sort_dary_heap, make_dary_heap, is_dary_heap
 
+#include <cstddef>
+
+#include "functional.h"
 #include "iterator.h"
+#include "simd.h"
+#include "util.h"
 
 namespace mystl {
 
@@ -11,21 +17,22 @@ namespace mystl {
 // push_heap
 // 该函数接受两个迭代器，表示一个 heap 容器的首尾，并且新元素已经插入到底部容器的最尾端，调整 heap
 /*****************************************************************************************/
+// 空位上移时移动而不是复制元素，字符串等类型不会在每层分配内存
 template <class RandomIter, class Distance, class T>
 void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, T value) {
-    auto parent = (holeIndex / 2) - 1;
+    auto parent = (holeIndex - 1) / 2;
     while(holeIndex > topIndex && *(first + parent) < value) {
-        *(first + holeIndex) = *(first + parent);
+        *(first + holeIndex) = mystl::move(*(first + parent));
         holeIndex = parent;
-        parent = (holeIndex / 2) - 1;
+        parent = (holeIndex - 1) / 2;
     }
-    *(first + holeIndex) = value;
+    *(first + holeIndex) = mystl::move(value);
 }
 
 template <class RandomIter, class Distance>
 void push_heap_d(RandomIter first, RandomIter last, Distance*) {
     // <Distance>(0), （0）在这里无意义
-    mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1));
+    mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), mystl::move(*(last - 1)));
 }
 
 template <class RandomIter>
@@ -40,18 +47,18 @@ void push_heap(RandomIter first, RandomIter last) {
 template <class RandomIter, class Distance, class T, class Compared>
 void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex, 
                     T value, Compared comp) {
-    auto parent = (holeIndex / 2) - 1;
+    auto parent = (holeIndex - 1) / 2;
     while(holeIndex > topIndex && comp(*(first + parent), value)) {
-        *(first + holeIndex) = *(first + parent);
+        *(first + holeIndex) = mystl::move(*(first + parent));
         holeIndex = parent;
-        parent = (holeIndex / 2) - 1;
+        parent = (holeIndex - 1) / 2;
     }
-    *(first + holeIndex) = value;
+    *(first + holeIndex) = mystl::move(value);
 }
 
 template <class RandomIter, class Distance, class Compared>
 void push_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp) {
-    mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1), comp);
+    mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), mystl::move(*(last - 1)), comp);
 }
 
 template <class RandomIter, class Compared>
@@ -64,6 +71,10 @@ void push_heap(RandomIter first, RandomIter last, Compared comp) {
 /*****************************************************************************************/
 // pop_heap
 // 该函数接受两个迭代器，表示 heap 容器的首尾，将 heap 的根节点取出放到容器尾部，调整 heap
+// adjust_heap 使用自底向上 (Floyd) 的调整: 空位沿较大的子节点一直下移到叶节点，每层只比较两个子节点，
+// 再把 value 从叶节点上溯。pop 时 value 取自堆的尾部，通常属于底层，上溯一般只需一两次比较，
+// 总比较次数约为 log2(n) + O(1)，而逐层同时与 value 比较的自顶向下调整约为 2 log2(n)
+// 沿途的元素都是移动而不是复制
 /*****************************************************************************************/
 template <class RandomIter, class T, class Distance>
 void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value) {
@@ -73,30 +84,30 @@ void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value) {
     while(child < len) {
         if(*(first + child) < *(first + child - 1))
             --child;                        // 找到较大的子节点 
-        *(first + holeIndex) = *(first + child);
+        *(first + holeIndex) = mystl::move(*(first + child));
         holeIndex = child;
         child = 2 * child + 2;
     }
     if(child == len) {
         // 没有右节点
-        *(first + holeIndex) = *(first + child - 1);
+        *(first + holeIndex) = mystl::move(*(first + child - 1));
         holeIndex = child - 1;
     }
     // 此时，有一个空位
     // 再执行一次上溯(percolate up)过程
-    mystl::push_heap_aux(first, holeIndex, topIndex, value);
+    mystl::push_heap_aux(first, holeIndex, topIndex, mystl::move(value));
 }
 
 template <class RandomIter, class T, class Distance>
 void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result,
     T value, Distance*) {
-    *result = *first;
-    mystl::adjust_heap(first, static_cast<Distance>(0), last - first, value);
+    *result = mystl::move(*first);
+    mystl::adjust_heap(first, static_cast<Distance>(0), last - first, mystl::move(value));
 }
 
 template <class RandomIter>
 void pop_heap(RandomIter first, RandomIter last) {
-    mystl::pop_heap_aux(first, last - 1, last - 1, *(last - 1), distance_type(first));
+    mystl::pop_heap_aux(first, last - 1, last - 1, mystl::move(*(last - 1)), distance_type(first));
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -108,28 +119,28 @@ void adjust_heap(RandomIter first, Distance holeIndex, Distance len,
     while(child < len) {
         if(comp(*(first + child), *(first + child - 1)))
             --child;                        // 找到较大的子节点 
-        *(first + holeIndex) = *(first + child);
+        *(first + holeIndex) = mystl::move(*(first + child));
         holeIndex = child;
         child = 2 * child + 2;
     }
     if(child == len) {
         // 没有右节点
-        *(first + holeIndex) = *(first + child - 1);
+        *(first + holeIndex) = mystl::move(*(first + child - 1));
         holeIndex = child - 1;
     }
-    mystl::push_heap_aux(first, holeIndex, topIndex, value, comp);
+    mystl::push_heap_aux(first, holeIndex, topIndex, mystl::move(value), comp);
 }
 
 template <class RandomIter, class T, class Distance, class Compared>
 void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result,
     T value, Distance*, Compared comp) {
-    *result = *first;
-    mystl::adjust_heap(first, static_cast<Distance>(0), last - first, value, comp);
+    *result = mystl::move(*first);
+    mystl::adjust_heap(first, static_cast<Distance>(0), last - first, mystl::move(value), comp);
 }
 
 template <class RandomIter, class Compared>
 void pop_heap(RandomIter first, RandomIter last, Compared comp) {
-    mystl::pop_heap_aux(first, last - 1, last - 1, *(last - 1), distance_type(first), comp);
+    mystl::pop_heap_aux(first, last - 1, last - 1, mystl::move(*(last - 1)), distance_type(first), comp);
 }
 
 
@@ -164,13 +175,18 @@ void make_heap_aux(RandomIter first, RandomIter last, Distance*) {
     auto holeIndex = (len - 2) / 2;
     // 从倒数第二层开始，重排以 holeIndex 为根的子树 
     while(true) {
-        mystl::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+        mystl::adjust_heap(first, holeIndex, len, mystl::move(*(first + holeIndex)));
         if(holeIndex == 0)
             return;
         --holeIndex;
     }
 }
 
+template <class RandomIter>
+void make_heap(RandomIter first, RandomIter last) {
+    mystl::make_heap_aux(first, last, distance_type(first));
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class RandomIter, class Distance, class Compared>
 void make_heap_aux(RandomIter first, RandomIter last, Distance*, Compared comp) {
@@ -180,7 +196,7 @@ void make_heap_aux(RandomIter first, RandomIter last, Distance*, Compared comp)
     auto holeIndex = (len - 2) / 2;
     // 从倒数第二层开始，重排以 holeIndex 为根的子树 
     while(true) {
-        mystl::adjust_heap(first, holeIndex, len, *(first + holeIndex), comp);
+        mystl::adjust_heap(first, holeIndex, len, mystl::move(*(first + holeIndex)), comp);
         if(holeIndex == 0)
             return;
         --holeIndex;
@@ -193,6 +209,195 @@ void make_heap(RandomIter first, RandomIter last, Compared comp) {
 }
 
 
+/*****************************************************************************************/
+// d 叉堆
+// 接口与二叉堆的版本相同，模板参数 D (>= 2) 为每个节点的子节点数，D == 2 时与二叉堆的布局相同
+// 节点 i 的子节点为 D * i + 1 ... D * i + D，父节点为 (i - 1) / D
+// 堆的高度为 log_D(n)，下溯时每层在 D 个相邻的子节点中选出最大者，层数 (即大堆上的缓存缺失次数)
+// 比二叉堆少 log2(D) 倍，代价是每层多 D - 2 次比较
+// D * sizeof(T) 为缓存行大小 (如 4 x 16 字节、8 x 8 字节)，并且 first + 1 按该大小对齐时，
+// 每个节点的全部子节点位于同一缓存行中
+// pop 下溯时下一层的位置取决于本层的比较结果，连续区间上先预取所有孙节点，使各层的缓存缺失可以重叠
+/*****************************************************************************************/
+// 预取 [g, len) 中从 g 开始、间隔为 D 的 D 个节点，即各子节点的第一个子节点
+template <size_t D, class RandomIter, class Distance>
+void dary_heap_prefetch(RandomIter first, Distance g, Distance len, m_true_type) {
+    for(size_t i = 0; i < D && g < len; ++i, g += static_cast<Distance>(D))
+        mystl::prefetch_read(mystl::to_address(first + g));
+}
+
+template <size_t D, class RandomIter, class Distance>
+void dary_heap_prefetch(RandomIter, Distance, Distance, m_false_type) {}
+
+// 上溯: 把 value 放入 holeIndex 处的空位，沿父节点上移直到 topIndex
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_heap_sift_up(RandomIter first, Distance holeIndex, Distance topIndex,
+                       T value, Compared& comp) {
+    while(holeIndex > topIndex) {
+        const Distance parent = (holeIndex - 1) / static_cast<Distance>(D);
+        if(!comp(*(first + parent), value))
+            break;
+        *(first + holeIndex) = mystl::move(*(first + parent));
+        holeIndex = parent;
+    }
+    *(first + holeIndex) = mystl::move(value);
+}
+
+// 在 [child, child + D) 中找到最大的子节点，最后一个节点的子节点可能不足 D 个
+// 用条件赋值代替分支，结果相当于随机时避免分支预测失败
+template <size_t D, class RandomIter, class Distance, class Compared>
+Distance dary_heap_max_child(RandomIter first, Distance child, Distance len, Compared& comp) {
+    Distance best = child;
+    if(len - child >= static_cast<Distance>(D)) {
+        for(size_t i = 1; i < D; ++i) {
+            const Distance c = child + static_cast<Distance>(i);
+            best = comp(*(first + best), *(first + c)) ? c : best;
+        }
+    }
+    else {
+        for(Distance c = child + 1; c < len; ++c)
+            best = comp(*(first + best), *(first + c)) ? c : best;
+    }
+    return best;
+}
+
+// 下溯: 把 value 放入 holeIndex 处的空位，每层与最大的子节点比较，不小于它时停止
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_heap_sift_down(RandomIter first, Distance holeIndex, Distance len,
+                         T value, Compared& comp) {
+    static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+    for(Distance child = static_cast<Distance>(D) * holeIndex + 1; child < len;
+        child = static_cast<Distance>(D) * holeIndex + 1) {
+        const Distance best = mystl::dary_heap_max_child<D>(first, child, len, comp);
+        if(!comp(value, *(first + best)))
+            break;
+        *(first + holeIndex) = mystl::move(*(first + best));
+        holeIndex = best;
+    }
+    *(first + holeIndex) = mystl::move(value);
+}
+
+// 先沿最大的子节点把空位下移到叶节点，再从叶节点上溯放入 value
+// 与二叉堆的 adjust_heap 相同，用于 pop: 从尾部取来的 value 通常属于底层，省去每层与 value 的比较
+template <size_t D, class RandomIter, class Distance, class T, class Compared>
+void dary_heap_adjust(RandomIter first, Distance holeIndex, Distance len,
+                      T value, Compared& comp) {
+    static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+    const Distance topIndex = holeIndex;
+    for(Distance child = static_cast<Distance>(D) * holeIndex + 1; child < len;
+        child = static_cast<Distance>(D) * holeIndex + 1) {
+        mystl::dary_heap_prefetch<D>(first, static_cast<Distance>(D) * child + 1, len,
+                                     m_bool_constant<is_contiguous_iterator<RandomIter>::value>{});
+        const Distance best = mystl::dary_heap_max_child<D>(first, child, len, comp);
+        *(first + holeIndex) = mystl::move(*(first + best));
+        holeIndex = best;
+    }
+    mystl::dary_heap_sift_up<D>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+/*****************************************************************************************/
+// push_dary_heap
+// 新元素已经插入到容器的最尾端，调整 d 叉堆
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Compared>
+void push_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    if(last - first < 2)
+        return;
+    const Distance hole = (last - first) - 1;
+    auto value = mystl::move(*(first + hole));
+    mystl::dary_heap_sift_up<D>(first, hole, static_cast<Distance>(0), mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter>
+void push_dary_heap(RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::push_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// pop_dary_heap
+// 将 d 叉堆的根节点取出放到容器尾部，调整 [first, last - 1) 为 d 叉堆
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Compared>
+void pop_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    if(last - first < 2)
+        return;
+    --last;
+    auto value = mystl::move(*last);
+    *last = mystl::move(*first);
+    mystl::dary_heap_adjust<D>(first, static_cast<Distance>(0), Distance(last - first),
+                               mystl::move(value), comp);
+}
+
+template <size_t D, class RandomIter>
+void pop_dary_heap(RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::pop_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// sort_dary_heap
+// 不断执行 pop_dary_heap，直到首尾最多相差1
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Compared>
+void sort_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+    while(last - first > 1)
+        mystl::pop_dary_heap<D>(first, last--, comp);
+}
+
+template <size_t D, class RandomIter>
+void sort_dary_heap(RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::sort_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// make_dary_heap
+// 从最后一个有子节点的节点开始，依次下溯，把容器内的数据变为一个 d 叉堆
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Compared>
+void make_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    if(len < 2)
+        return;
+    for(Distance hole = (len - 2) / static_cast<Distance>(D) + 1; hole > 0; ) {
+        --hole;
+        auto value = mystl::move(*(first + hole));
+        mystl::dary_heap_sift_down<D>(first, hole, len, mystl::move(value), comp);
+    }
+}
+
+template <size_t D, class RandomIter>
+void make_dary_heap(RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::make_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+/*****************************************************************************************/
+// is_dary_heap
+// 检查[first, last)内的元素是否为一个 d 叉堆
+/*****************************************************************************************/
+template <size_t D, class RandomIter, class Compared>
+bool is_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type Distance;
+    const Distance len = last - first;
+    for(Distance child = 1; child < len; ++child) {
+        if(comp(*(first + (child - 1) / static_cast<Distance>(D)), *(first + child)))
+            return false;
+    }
+    return true;
+}
+
+template <size_t D, class RandomIter>
+bool is_dary_heap(RandomIter first, RandomIter last) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    return mystl::is_dary_heap<D>(first, last, mystl::less<value_type>());
+}
+
+
 } // namespace mystl
 
 #endif // MYSTL_HEAP_ALGO_H_
\ No newline at end of file
@@ -0,0 +1,357 @@
+#ifndef MYSTL_INDEXED_PRIORITY_QUEUE_H_
+#define MYSTL_INDEXED_PRIORITY_QUEUE_H_
+
+// 这个头文件包含一个模板类 indexed_priority_queue
+// indexed_priority_queue : 带位置表的优先队列，push 返回句柄，可以通过句柄原地修改或删除元素
+
+#include <cstddef>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl {
+
+/*****************************************************************************************/
+// indexed_priority_queue
+// 参数一代表元素类型，参数二代表比较方式，缺省使用 mystl::less (堆顶为最大元素)，参数三为堆的叉数
+// 元素按 heap_algo.h 中 d 叉堆的布局存放，节点 i 的子节点为 D * i + 1 ... D * i + D
+// 另有两张表: ids_[i] 为堆中位置 i 上元素的句柄，pos_[h] 为句柄 h 的元素在堆中的位置
+// 元素每次移动都同步更新两张表，因此可以由句柄在 O(1) 时间内找到元素，在 O(log n) 时间内修改或删除
+//
+// 句柄在元素被 pop / erase 后回收，之后 push 的元素可能得到相同的句柄
+// increase_key / decrease_key 以 Compare 定义的优先级为准: increase_key 令元素向堆顶移动，
+// decrease_key 令元素向堆底移动。以 mystl::greater 作为最小堆时 (如 Dijkstra 的距离)，
+// 把键改小对应 increase_key。不确定方向时使用 update，多一次比较
+/*****************************************************************************************/
+template <class T, class Compare = mystl::less<T>, size_t D = 2>
+class indexed_priority_queue {
+    static_assert(D >= 2, "a d-ary heap needs at least two children per node");
+
+public:
+    typedef T                                   value_type;
+    typedef Compare                             value_compare;
+    typedef size_t                              size_type;
+    typedef size_t                              handle_type;
+    typedef T&                                  reference;
+    typedef const T&                            const_reference;
+
+    typedef mystl::allocator<T>                 data_allocator;
+    typedef mystl::allocator<size_type>         index_allocator;
+
+    static constexpr handle_type npos = static_cast<handle_type>(-1);
+
+private:
+    // 空闲句柄在 pos_ 中以最高位标记，其余位为空闲链表的下一个句柄，kFreeEnd 表示链表结束
+    static constexpr size_type kFreeBit = ~(static_cast<size_type>(-1) >> 1);
+    static constexpr size_type kFreeEnd = ~kFreeBit;
+    static constexpr size_type kMinCapacity = 16;
+
+    T*          keys_;      // 按堆的顺序存放的元素，[0, size_) 已构造
+    size_type*  ids_;       // 堆中各位置的句柄
+    size_type*  pos_;       // 各句柄在堆中的位置，或空闲标记
+    size_type   size_;      // 元素个数
+    size_type   handles_;   // 已分配过的句柄数，[0, handles_) 中不在堆里的句柄位于空闲链表
+    size_type   cap_;       // 三张表的容量
+    size_type   free_;      // 空闲链表的表头，为 kFreeEnd 时没有空闲句柄
+    Compare     comp_;
+
+public:
+    // 构造、复制、移动、析构函数
+    indexed_priority_queue()
+        : keys_(nullptr), ids_(nullptr), pos_(nullptr), size_(0), handles_(0), cap_(0),
+          free_(kFreeEnd), comp_() {}
+
+    explicit indexed_priority_queue(const Compare& comp)
+        : keys_(nullptr), ids_(nullptr), pos_(nullptr), size_(0), handles_(0), cap_(0),
+          free_(kFreeEnd), comp_(comp) {}
+
+    indexed_priority_queue(const indexed_priority_queue& rhs)
+        : keys_(nullptr), ids_(nullptr), pos_(nullptr), size_(0), handles_(0), cap_(0),
+          free_(kFreeEnd), comp_(rhs.comp_) {
+        if(rhs.handles_ == 0)
+            return;
+        allocate_tables(rhs.handles_);
+        try {
+            mystl::uninitialized_copy(rhs.keys_, rhs.keys_ + rhs.size_, keys_);
+        }
+        catch(...) {
+            deallocate_tables();
+            throw;
+        }
+        mystl::copy(rhs.ids_, rhs.ids_ + rhs.size_, ids_);
+        mystl::copy(rhs.pos_, rhs.pos_ + rhs.handles_, pos_);
+        size_ = rhs.size_;
+        handles_ = rhs.handles_;
+        free_ = rhs.free_;
+    }
+
+    indexed_priority_queue(indexed_priority_queue&& rhs) noexcept
+        : keys_(rhs.keys_), ids_(rhs.ids_), pos_(rhs.pos_), size_(rhs.size_),
+          handles_(rhs.handles_), cap_(rhs.cap_), free_(rhs.free_), comp_(rhs.comp_) {
+        rhs.keys_ = nullptr;
+        rhs.ids_ = nullptr;
+        rhs.pos_ = nullptr;
+        rhs.size_ = rhs.handles_ = rhs.cap_ = 0;
+        rhs.free_ = kFreeEnd;
+    }
+
+    indexed_priority_queue& operator=(const indexed_priority_queue& rhs) {
+        if(this != &rhs) {
+            indexed_priority_queue tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    indexed_priority_queue& operator=(indexed_priority_queue&& rhs) noexcept {
+        indexed_priority_queue tmp(mystl::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~indexed_priority_queue() {
+        mystl::destory(keys_, keys_ + size_);
+        deallocate_tables();
+    }
+
+public:
+    // 访问元素相关操作
+    const_reference top()        const { MYSTL_DEBUG(!empty()); return keys_[0]; }
+    handle_type     top_handle() const { MYSTL_DEBUG(!empty()); return ids_[0]; }
+
+    // 句柄 h 对应的元素，h 必须在队列中
+    const_reference value(handle_type h) const {
+        MYSTL_DEBUG(contains(h));
+        return keys_[pos_[h]];
+    }
+
+    // 容量相关操作
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return cap_; }
+
+    bool contains(handle_type h) const noexcept {
+        return h < handles_ && (pos_[h] & kFreeBit) == 0;
+    }
+
+    // 预留 n 个句柄的空间
+    void reserve(size_type n) {
+        if(n > cap_)
+            reallocate(n);
+    }
+
+    // 修改容器相关操作
+    handle_type push(const value_type& value) { return emplace(value); }
+    handle_type push(value_type&& value)      { return emplace(mystl::move(value)); }
+
+    template <class... Args>
+    handle_type emplace(Args&&... args) {
+        const handle_type h = acquire_handle();
+        try {
+            data_allocator::construct(keys_ + size_, mystl::forward<Args>(args)...);
+        }
+        catch(...) {
+            release_handle(h);
+            throw;
+        }
+        const size_type i = size_++;
+        value_type value(mystl::move(keys_[i]));
+        sift_up(i, mystl::move(value), h);
+        return h;
+    }
+
+    void pop() {
+        MYSTL_DEBUG(!empty());
+        erase_at(0);
+    }
+
+    // 删除句柄 h 对应的元素
+    void erase(handle_type h) {
+        MYSTL_DEBUG(contains(h));
+        erase_at(pos_[h]);
+    }
+
+    // 修改句柄 h 对应的元素，由新旧值的比较决定上溯或下溯
+    void update(handle_type h, value_type value) {
+        MYSTL_DEBUG(contains(h));
+        const size_type i = pos_[h];
+        if(comp_(keys_[i], value))
+            sift_up(i, mystl::move(value), h);
+        else
+            sift_down(i, mystl::move(value), h);
+    }
+
+    // 新值的优先级不低于旧值，元素向堆顶移动
+    void increase_key(handle_type h, value_type value) {
+        MYSTL_DEBUG(contains(h) && !comp_(value, keys_[pos_[h]]));
+        sift_up(pos_[h], mystl::move(value), h);
+    }
+
+    // 新值的优先级不高于旧值，元素向堆底移动
+    void decrease_key(handle_type h, value_type value) {
+        MYSTL_DEBUG(contains(h) && !comp_(keys_[pos_[h]], value));
+        sift_down(pos_[h], mystl::move(value), h);
+    }
+
+    // 清空元素并回收所有句柄，保留容量
+    void clear() noexcept {
+        mystl::destory(keys_, keys_ + size_);
+        size_ = handles_ = 0;
+        free_ = kFreeEnd;
+    }
+
+    void swap(indexed_priority_queue& rhs) noexcept {
+        mystl::swap(keys_, rhs.keys_);
+        mystl::swap(ids_, rhs.ids_);
+        mystl::swap(pos_, rhs.pos_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(handles_, rhs.handles_);
+        mystl::swap(cap_, rhs.cap_);
+        mystl::swap(free_, rhs.free_);
+        mystl::swap(comp_, rhs.comp_);
+    }
+
+private:
+    // helper functions
+
+    // 把句柄为 id 的 value 放入位置 i
+    void place(size_type i, value_type&& value, size_type id) {
+        keys_[i] = mystl::move(value);
+        ids_[i] = id;
+        pos_[id] = i;
+    }
+
+    // 把位置 from 的元素移动到位置 to
+    void move_node(size_type from, size_type to) {
+        keys_[to] = mystl::move(keys_[from]);
+        ids_[to] = ids_[from];
+        pos_[ids_[to]] = to;
+    }
+
+    // 位置 i 为空位，沿父节点上移直到 value 不比父节点优先
+    void sift_up(size_type i, value_type value, size_type id) {
+        while(i > 0) {
+            const size_type parent = (i - 1) / D;
+            if(!comp_(keys_[parent], value))
+                break;
+            move_node(parent, i);
+            i = parent;
+        }
+        place(i, mystl::move(value), id);
+    }
+
+    // 位置 i 为空位，每层与最优先的子节点比较，不低于它时停止
+    void sift_down(size_type i, value_type value, size_type id) {
+        for(size_type child = D * i + 1; child < size_; child = D * i + 1) {
+            const size_type best = mystl::dary_heap_max_child<D>(keys_, child, size_, comp_);
+            if(!comp_(value, keys_[best]))
+                break;
+            move_node(best, i);
+            i = best;
+        }
+        place(i, mystl::move(value), id);
+    }
+
+    // 与 pop_dary_heap 相同，先把空位沿最优先的子节点下移到叶节点，再上溯放入 value
+    void adjust_from_top(value_type value, size_type id) {
+        size_type i = 0;
+        for(size_type child = 1; child < size_; child = D * i + 1) {
+            mystl::dary_heap_prefetch<D>(keys_, D * child + 1, size_, m_true_type());
+            const size_type best = mystl::dary_heap_max_child<D>(keys_, child, size_, comp_);
+            move_node(best, i);
+            i = best;
+        }
+        sift_up(i, mystl::move(value), id);
+    }
+
+    // 删除位置 i 的元素，用最后一个元素填补空位
+    void erase_at(size_type i) {
+        release_handle(ids_[i]);
+        const size_type last = --size_;
+        if(i == last) {
+            data_allocator::destory(keys_ + last);
+            return;
+        }
+        value_type value(mystl::move(keys_[last]));
+        const size_type id = ids_[last];
+        data_allocator::destory(keys_ + last);
+        if(i == 0)
+            adjust_from_top(mystl::move(value), id);
+        else if(comp_(keys_[(i - 1) / D], value))
+            sift_up(i, mystl::move(value), id);
+        else
+            sift_down(i, mystl::move(value), id);
+    }
+
+    handle_type acquire_handle() {
+        if(free_ != kFreeEnd) {
+            const handle_type h = free_;
+            free_ = pos_[h] & ~kFreeBit;
+            return h;
+        }
+        if(handles_ == cap_) {
+            THROW_LENGTH_ERROR_IF(cap_ > (kFreeBit >> 1),
+                                  "indexed_priority_queue<T>'s size too big");
+            reallocate(cap_ < kMinCapacity ? kMinCapacity : cap_ * 2);
+        }
+        return handles_++;
+    }
+
+    void release_handle(handle_type h) noexcept {
+        pos_[h] = kFreeBit | free_;
+        free_ = h;
+    }
+
+    void allocate_tables(size_type n) {
+        keys_ = data_allocator::allocate(n);
+        try {
+            ids_ = index_allocator::allocate(n);
+            pos_ = index_allocator::allocate(n);
+        }
+        catch(...) {
+            index_allocator::deallocate(ids_);
+            data_allocator::deallocate(keys_);
+            keys_ = nullptr;
+            ids_ = nullptr;
+            throw;
+        }
+        cap_ = n;
+    }
+
+    void deallocate_tables() noexcept {
+        data_allocator::deallocate(keys_, cap_);
+        index_allocator::deallocate(ids_, cap_);
+        index_allocator::deallocate(pos_, cap_);
+        keys_ = nullptr;
+        ids_ = nullptr;
+        pos_ = nullptr;
+        cap_ = 0;
+    }
+
+    // 重新分配三张表，元素移动到新空间
+    void reallocate(size_type n) {
+        indexed_priority_queue tmp(comp_);
+        tmp.allocate_tables(n);
+        mystl::uninitialized_move(keys_, keys_ + size_, tmp.keys_);
+        tmp.size_ = size_;
+        mystl::copy(ids_, ids_ + size_, tmp.ids_);
+        mystl::copy(pos_, pos_ + handles_, tmp.pos_);
+        tmp.handles_ = handles_;
+        tmp.free_ = free_;
+        swap(tmp);
+    }
+};
+
+// 重载 mystl 的 swap
+template <class T, class Compare, size_t D>
+void swap(indexed_priority_queue<T, Compare, D>& lhs, indexed_priority_queue<T, Compare, D>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif // MYSTL_INDEXED_PRIORITY_QUEUE_H_
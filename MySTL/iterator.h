@@ -14,6 +14,7 @@ struct output_iterator_tag {};
 struct forward_iterator_tag : public input_iterator_tag {};
 struct bidirectional_iterator_tag : public forward_iterator_tag {};
 struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
 // iterator 模板
 template <class Category, class T, class Distance = ptrdiff_t,
@@ -111,6 +112,25 @@ struct is_iterator :
   public m_bool_constant<is_input_iterator<Iterator>::value ||
     is_output_iterator<Iterator>::value> {};
 
+// 元素在内存中连续存放的迭代器: 指针，以及 iterator_category 为 contiguous_iterator_tag 的迭代器
+// 包装指针的迭代器还需要提供 const 的 operator->，由 to_address 取得元素地址
+template <class Iter>
+struct is_contiguous_iterator : public has_iterator_cat_of<Iter, contiguous_iterator_tag> {};
+
+template <class T>
+struct is_contiguous_iterator<T*> : public m_true_type {};
+
+// 取得迭代器所指元素的地址，不解引用迭代器，因此也可以用于尾后迭代器
+template <class T>
+constexpr T* to_address(T* p) noexcept {
+    return p;
+}
+
+template <class Iter>
+constexpr auto to_address(const Iter& iter) noexcept -> decltype(iter.operator->()) {
+    return iter.operator->();
+}
+
 // 提取迭代器的元素
 // category
 template <class Iterator>
@@ -130,7 +150,7 @@ typename iterator_traits<Iterator>::difference_type*
 //value_type
 template <class Iterator>
 typename iterator_traits<Iterator>::value_type* 
-    vlaue_type(const Iterator&) {
+    value_type(const Iterator&) {
         return static_cast<typename iterator_traits<Iterator>::value_type*>(0);
 }
 
@@ -185,7 +205,19 @@ void advance_dispatch(RandomIterator& iter, Distance n,random_access_iterator_ta
 
 template <class InputIterator, class Distance>
 void advance_dispatch(InputIterator& iter, Distance n) {
-    distance_dispatch(iter, n, iterator_category(iter));
+    advance_dispatch(iter, n, iterator_category(iter));
+}
+
+// 对外接口，供各算法使用
+template <class InputIterator>
+typename iterator_traits<InputIterator>::difference_type
+    distance(InputIterator first, InputIterator last) {
+        return distance_dispatch(first, last, iterator_category(first));
+}
+
+template <class InputIterator, class Distance>
+void advance(InputIterator& iter, Distance n) {
+    advance_dispatch(iter, n, iterator_category(iter));
 }
 
 // <<<<< 反向迭代器 <<<<< //
@@ -1,5 +1,5 @@
 #ifndef MYSTL_MEMORY_H_
-#define MYSTL_MEMORY_H
+#define MYSTL_MEMORY_H_
 
 // 这个头文件负责更高级的动态内存管理
 // 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr
@@ -68,7 +68,7 @@ public:
     temporary_buffer(ForwardIterator first, ForwardIterator last);
 
     ~temporary_buffer() {
-    mystl::destroy(buffer, buffer + len);
+    mystl::destory(buffer, buffer + len);
     free(buffer);
     }
 
@@ -166,10 +166,10 @@ public:
     T* operator->() const {return m_ptr;}
 
     // 获取指针
-    T* get() const {return m_ptr};
+    T* get() const {return m_ptr;}
 
     // 释放指针
-    void release() {
+    T* release() {
         T* tmp = m_ptr;
         m_ptr = nullptr;
         return tmp;
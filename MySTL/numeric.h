@@ -1,7 +1,14 @@
 #ifndef MYSTL_NUMERIC_H_
 #define MYSTL_NUMERIC_H_
 
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "functional.h"
 #include "iterator.h"
+#include "simd.h"
 
 namespace mystl {
 
@@ -24,13 +31,251 @@ T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op) {
     return init;
 }
 
+/*****************************************************************************************/
+// 连续区间的等差序列与相邻差
+// iota 与 adjacent_difference 的标量循环带有跨迭代的依赖，这里直接由下标计算每个元素:
+// iota 的第 i 个元素为 value + i，相邻差由当前向量与上一个向量拼出错开一个元素的向量，
+// 每个元素只读一次，result 等于 first 时也不会读到已写入的值
+// 整数按模运算，与逐个计算的结果相同
+/*****************************************************************************************/
+template <class T>
+struct is_sequence_simd_type : public m_bool_constant<
+    (std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+     (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+    std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+// value + i 与 x - y，整数溢出时回绕
+template <class T>
+T sequence_value(T value, size_t i) noexcept {
+    if constexpr(std::is_integral<T>::value) {
+        typedef std::make_unsigned_t<T> U;
+        return static_cast<T>(static_cast<U>(value) + static_cast<U>(i));
+    }
+    else {
+        return value + static_cast<T>(i);
+    }
+}
+
+template <class T>
+T difference_value(T x, T y) noexcept {
+    if constexpr(std::is_integral<T>::value) {
+        typedef std::make_unsigned_t<T> U;
+        return static_cast<T>(static_cast<U>(x) - static_cast<U>(y));
+    }
+    else {
+        return x - y;
+    }
+}
+
+// x + y，整数溢出时回绕，是 difference_value 的逆运算
+template <class T>
+T sum_value(T x, T y) noexcept {
+    if constexpr(std::is_integral<T>::value) {
+        typedef std::make_unsigned_t<T> U;
+        return static_cast<T>(static_cast<U>(x) + static_cast<U>(y));
+    }
+    else {
+        return x + y;
+    }
+}
+
+// 浮点数只有在每个元素都是可以精确表示的整数时，value + i 才与逐个 ++value 的结果相同
+template <class T>
+bool iota_exact(T value, size_t n) noexcept {
+    if constexpr(std::is_integral<T>::value) {
+        return true;
+    }
+    else {
+        const T limit = static_cast<T>(1ull << std::numeric_limits<T>::digits);
+        return value == std::trunc(value) && std::fabs(value) <= limit &&
+               static_cast<T>(n) <= limit - std::fabs(value);
+    }
+}
+
+template <class T>
+void iota_scalar(T* out, size_t n, T value) noexcept {
+    for(size_t i = 0; i < n; ++i)
+        out[i] = mystl::sequence_value(value, i);
+}
+
+// out[0] = a[0] - base，out[i] = a[i] - a[i - 1]，返回最后一个元素
+template <class T>
+T adjacent_difference_scalar(const T* a, size_t n, T* out, T base) noexcept {
+    for(size_t i = 0; i < n; ++i) {
+        const T x = a[i];
+        out[i] = mystl::difference_value(x, base);
+        base = x;
+    }
+    return base;
+}
+
+#ifdef MYSTL_SIMD_X86
+template <class T, bool = std::is_integral<T>::value, size_t Size = sizeof(T)>
+struct avx2_sequence_ops;
+
+template <class T, size_t Size>
+struct avx2_sequence_ops<T, true, Size> {
+    typedef __m256i vec;
+    static constexpr size_t lanes = 32 / Size;
+    MYSTL_TARGET_AVX2 static vec load(const T* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    MYSTL_TARGET_AVX2 static void store(T* p, vec x) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x);
+    }
+    MYSTL_TARGET_AVX2 static vec set1(T x) {
+        if constexpr(Size == 1)
+            return _mm256_set1_epi8(static_cast<char>(x));
+        else if constexpr(Size == 2)
+            return _mm256_set1_epi16(static_cast<short>(x));
+        else if constexpr(Size == 4)
+            return _mm256_set1_epi32(static_cast<int>(x));
+        else
+            return _mm256_set1_epi64x(static_cast<long long>(x));
+    }
+    // 0, 1, 2, ..., lanes - 1
+    MYSTL_TARGET_AVX2 static vec ramp() {
+        if constexpr(Size == 1)
+            return _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+        else if constexpr(Size == 2)
+            return _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        else if constexpr(Size == 4)
+            return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        else
+            return _mm256_setr_epi64x(0, 1, 2, 3);
+    }
+    MYSTL_TARGET_AVX2 static vec add(vec x, vec y) {
+        if constexpr(Size == 1)
+            return _mm256_add_epi8(x, y);
+        else if constexpr(Size == 2)
+            return _mm256_add_epi16(x, y);
+        else if constexpr(Size == 4)
+            return _mm256_add_epi32(x, y);
+        else
+            return _mm256_add_epi64(x, y);
+    }
+    MYSTL_TARGET_AVX2 static vec sub(vec x, vec y) {
+        if constexpr(Size == 1)
+            return _mm256_sub_epi8(x, y);
+        else if constexpr(Size == 2)
+            return _mm256_sub_epi16(x, y);
+        else if constexpr(Size == 4)
+            return _mm256_sub_epi32(x, y);
+        else
+            return _mm256_sub_epi64(x, y);
+    }
+    // x 整体后移一个元素，空出的位置填入 prev 的最后一个元素
+    MYSTL_TARGET_AVX2 static vec shift_in(vec prev, vec x) {
+        return _mm256_alignr_epi8(x, _mm256_permute2x128_si256(prev, x, 0x21), 16 - Size);
+    }
+};
+
+template <>
+struct avx2_sequence_ops<float, false, 4> {
+    typedef __m256 vec;
+    static constexpr size_t lanes = 8;
+    MYSTL_TARGET_AVX2 static vec load(const float* p) { return _mm256_loadu_ps(p); }
+    MYSTL_TARGET_AVX2 static void store(float* p, vec x) { _mm256_storeu_ps(p, x); }
+    MYSTL_TARGET_AVX2 static vec set1(float x) { return _mm256_set1_ps(x); }
+    MYSTL_TARGET_AVX2 static vec ramp() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+    MYSTL_TARGET_AVX2 static vec add(vec x, vec y) { return _mm256_add_ps(x, y); }
+    MYSTL_TARGET_AVX2 static vec sub(vec x, vec y) { return _mm256_sub_ps(x, y); }
+    MYSTL_TARGET_AVX2 static vec shift_in(vec prev, vec x) {
+        return _mm256_castsi256_ps(avx2_sequence_ops<int32_t>::shift_in(
+            _mm256_castps_si256(prev), _mm256_castps_si256(x)));
+    }
+};
+
+template <>
+struct avx2_sequence_ops<double, false, 8> {
+    typedef __m256d vec;
+    static constexpr size_t lanes = 4;
+    MYSTL_TARGET_AVX2 static vec load(const double* p) { return _mm256_loadu_pd(p); }
+    MYSTL_TARGET_AVX2 static void store(double* p, vec x) { _mm256_storeu_pd(p, x); }
+    MYSTL_TARGET_AVX2 static vec set1(double x) { return _mm256_set1_pd(x); }
+    MYSTL_TARGET_AVX2 static vec ramp() { return _mm256_setr_pd(0, 1, 2, 3); }
+    MYSTL_TARGET_AVX2 static vec add(vec x, vec y) { return _mm256_add_pd(x, y); }
+    MYSTL_TARGET_AVX2 static vec sub(vec x, vec y) { return _mm256_sub_pd(x, y); }
+    MYSTL_TARGET_AVX2 static vec shift_in(vec prev, vec x) {
+        return _mm256_castsi256_pd(avx2_sequence_ops<int64_t>::shift_in(
+            _mm256_castpd_si256(prev), _mm256_castpd_si256(x)));
+    }
+};
+
+template <class T>
+MYSTL_TARGET_AVX2
+void iota_avx2(T* out, size_t n, T value) noexcept {
+    typedef avx2_sequence_ops<T> ops;
+    constexpr size_t L = ops::lanes;
+    typename ops::vec v = ops::add(ops::set1(value), ops::ramp());
+    const typename ops::vec step = ops::set1(mystl::sequence_value(T(), L));
+    size_t i = 0;
+    for(; i + L <= n; i += L) {
+        ops::store(out + i, v);
+        v = ops::add(v, step);
+    }
+    mystl::iota_scalar(out + i, n - i, mystl::sequence_value(value, i));
+}
+
+template <class T>
+MYSTL_TARGET_AVX2
+void adjacent_difference_avx2(const T* a, size_t n, T* out, T base) noexcept {
+    typedef avx2_sequence_ops<T> ops;
+    constexpr size_t L = ops::lanes;
+    typename ops::vec prev = ops::set1(base);
+    size_t i = 0;
+    for(; i + L <= n; i += L) {
+        const typename ops::vec x = ops::load(a + i);
+        ops::store(out + i, ops::sub(x, ops::shift_in(prev, x)));
+        prev = x;
+    }
+    if(i != 0) {
+        // result 等于 first 时 a[i - 1] 已被覆盖，从寄存器中取回
+        T lane[L];
+        ops::store(lane, prev);
+        base = lane[L - 1];
+    }
+    mystl::adjacent_difference_scalar(a + i, n - i, out + i, base);
+}
+#endif // MYSTL_SIMD_X86
+
+// 根据 CPU 特性选择内核
+// 内核按 value + i 计算，value 为 -0.0 时 value + 0 得到 +0.0，第一个元素直接写入 value
+template <class T>
+void iota_n(T* out, size_t n, T value) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2)
+        mystl::iota_avx2(out, n, value);
+    else
+        mystl::iota_scalar(out, n, value);
+#else
+    mystl::iota_scalar(out, n, value);
+#endif
+    if(n != 0)
+        out[0] = value;
+}
+
+template <class T>
+void adjacent_difference_n(const T* a, size_t n, T* out, T base) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2) {
+        mystl::adjacent_difference_avx2(a, n, out, base);
+        return;
+    }
+#endif
+    mystl::adjacent_difference_scalar(a, n, out, base);
+}
+
 /*****************************************************************************************/
 // adjacent_difference
 // 版本1：计算相邻元素的差值，结果保存到以 result 为起始的区间上
 // 版本2：自定义相邻元素的二元操作
+// result 可以等于 first，连续的整型与浮点区间使用向量化版本
+// adjacent_diffrence 为旧的拼写，保留以兼容已有代码
 /*****************************************************************************************/
 template <class InputIter, class OutputIter>
-OutputIter adjacent_diffrence(InputIter first, InputIter last, OutputIter result) {
+OutputIter unchecked_adjacent_difference(InputIter first, InputIter last, OutputIter result) {
     if(first == last)
         return result;
     *result = *first;
@@ -43,8 +288,24 @@ OutputIter adjacent_diffrence(InputIter first, InputIter last, OutputIter result
     return ++result;
 }
 
+// 为连续区间提供特化版本
+template <class Tp, class Up>
+std::enable_if_t<
+    is_sequence_simd_type<Up>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, Up>::value, Up*>
+unchecked_adjacent_difference(Tp* first, Tp* last, Up* result) {
+    const auto n = static_cast<size_t>(last - first);
+    mystl::adjacent_difference_n(first, n, result, Up());
+    return result + n;
+}
+
+template <class InputIter, class OutputIter>
+OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result) {
+    return mystl::unchecked_adjacent_difference(first, last, result);
+}
+
 template <class InputIter, class OutputIter, class BinaryOp>
-OutputIter adjacent_diffrence(InputIter first, InputIter last, 
+OutputIter adjacent_difference(InputIter first, InputIter last, 
     OutputIter result, BinaryOp binary_op) {
     if(first == last)
         return result;
@@ -58,6 +319,17 @@ OutputIter adjacent_diffrence(InputIter first, InputIter last,
     return ++result;
 }
 
+template <class InputIter, class OutputIter>
+OutputIter adjacent_diffrence(InputIter first, InputIter last, OutputIter result) {
+    return mystl::adjacent_difference(first, last, result);
+}
+
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter adjacent_diffrence(InputIter first, InputIter last, 
+    OutputIter result, BinaryOp binary_op) {
+    return mystl::adjacent_difference(first, last, result, binary_op);
+}
+
 /*****************************************************************************************/
 // inner_product
 // 版本1：以 init 为初值，计算两个区间的内积   
@@ -83,45 +355,843 @@ T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
 // 填充[first, last)，以 value 为初值开始递增
 /*****************************************************************************************/
 template <class ForwardIter, class T>
-void iota(ForwardIter first, ForwardIter last, T value) {
+void unchecked_iota(ForwardIter first, ForwardIter last, T value) {
     while(first != last) {
         *first++ = value;
         ++value;
     }
 }
-        
+
+// 为连续区间提供特化版本，浮点数无法保证结果相同时使用通用版本
+template <class Tp, class T>
+std::enable_if_t<is_sequence_simd_type<T>::value && std::is_same<Tp, T>::value>
+unchecked_iota(Tp* first, Tp* last, T value) {
+    const auto n = static_cast<size_t>(last - first);
+    if(mystl::iota_exact(value, n))
+        mystl::iota_n(first, n, value);
+    else
+        for(; first != last; ++first, ++value)
+            *first = value;
+}
+
+template <class ForwardIter, class T>
+void iota(ForwardIter first, ForwardIter last, T value) {
+    mystl::unchecked_iota(first, last, value);
+}
+
+/*****************************************************************************************/
+// 连续整型区间的前缀和
+// AVX2 在寄存器内做对数步的移位相加: 先在每个 128 位通道内求前缀和，再把低通道的总和加到高通道，
+// 最后加上前一个向量的最后一个元素
+// 整数加法按模运算满足结合律，结果与逐个相加相同；浮点数会改变舍入，不使用这条路径
+/*****************************************************************************************/
+template <class T>
+struct is_scan_simd_type : public m_bool_constant<
+    std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+    (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+// 按无符号数相加，溢出时回绕而不是未定义行为
+template <class T>
+T wrapping_add(T x, T y) noexcept {
+    typedef std::make_unsigned_t<T> U;
+    return static_cast<T>(static_cast<U>(x) + static_cast<U>(y));
+}
+
+// 区间总和，四个累加器打破依赖链
+template <class T>
+T wrapping_sum(const T* a, size_t n) noexcept {
+    typedef std::make_unsigned_t<T> U;
+    U s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        s0 += static_cast<U>(a[i]);
+        s1 += static_cast<U>(a[i + 1]);
+        s2 += static_cast<U>(a[i + 2]);
+        s3 += static_cast<U>(a[i + 3]);
+    }
+    for(; i < n; ++i)
+        s0 += static_cast<U>(a[i]);
+    return static_cast<T>(s0 + s1 + s2 + s3);
+}
+
+// out[i] 为 carry 与 a[0, i] (Exclusive 时为 a[0, i)) 之和，out 可以等于 a，返回 carry 与全部元素之和
+template <bool Exclusive, class T>
+T prefix_sum_scalar(const T* a, size_t n, T* out, T carry) noexcept {
+    for(size_t i = 0; i < n; ++i) {
+        const T x = a[i];
+        if(Exclusive) {
+            out[i] = carry;
+            carry = mystl::wrapping_add(carry, x);
+        }
+        else {
+            carry = mystl::wrapping_add(carry, x);
+            out[i] = carry;
+        }
+    }
+    return carry;
+}
+
+#ifdef MYSTL_SIMD_X86
+template <class T, size_t Size = sizeof(T)>
+struct avx2_scan_ops;
+
+template <class T>
+struct avx2_scan_ops<T, 4> {
+    MYSTL_TARGET_AVX2 static __m256i broadcast(T x) {
+        return _mm256_set1_epi32(static_cast<int>(x));
+    }
+    MYSTL_TARGET_AVX2 static __m256i add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+    MYSTL_TARGET_AVX2 static __m256i sub(__m256i x, __m256i y) { return _mm256_sub_epi32(x, y); }
+    // 寄存器内的前缀和
+    MYSTL_TARGET_AVX2 static __m256i prefix(__m256i x) {
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        const __m256i low = _mm256_permute2x128_si256(x, x, 0x08);
+        return _mm256_add_epi32(x, _mm256_shuffle_epi32(low, 0xff));
+    }
+    // 把最后一个元素广播到所有通道
+    MYSTL_TARGET_AVX2 static __m256i last(__m256i x) {
+        return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+    }
+    MYSTL_TARGET_AVX2 static T first(__m256i x) {
+        return static_cast<T>(_mm_cvtsi128_si32(_mm256_castsi256_si128(x)));
+    }
+};
+
+template <class T>
+struct avx2_scan_ops<T, 8> {
+    MYSTL_TARGET_AVX2 static __m256i broadcast(T x) {
+        return _mm256_set1_epi64x(static_cast<long long>(x));
+    }
+    MYSTL_TARGET_AVX2 static __m256i add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+    MYSTL_TARGET_AVX2 static __m256i sub(__m256i x, __m256i y) { return _mm256_sub_epi64(x, y); }
+    MYSTL_TARGET_AVX2 static __m256i prefix(__m256i x) {
+        x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+        const __m256i low = _mm256_permute2x128_si256(x, x, 0x08);
+        return _mm256_add_epi64(x, _mm256_shuffle_epi32(low, 0xee));
+    }
+    MYSTL_TARGET_AVX2 static __m256i last(__m256i x) {
+        return _mm256_permute4x64_epi64(x, 0xff);
+    }
+    MYSTL_TARGET_AVX2 static T first(__m256i x) {
+        return static_cast<T>(_mm_cvtsi128_si64(_mm256_castsi256_si128(x)));
+    }
+};
+
+template <bool Exclusive, class T>
+MYSTL_TARGET_AVX2
+T prefix_sum_avx2(const T* a, size_t n, T* out, T carry) noexcept {
+    typedef avx2_scan_ops<T> ops;
+    constexpr size_t L = 32 / sizeof(T);
+    __m256i c = ops::broadcast(carry);
+    size_t i = 0;
+    for(; i + L <= n; i += L) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i s = ops::add(ops::prefix(x), c);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Exclusive ? ops::sub(s, x) : s);
+        c = ops::last(s);
+    }
+    return mystl::prefix_sum_scalar<Exclusive>(a + i, n - i, out + i, ops::first(c));
+}
+#endif // MYSTL_SIMD_X86
+
+// 根据 CPU 特性选择内核
+template <bool Exclusive, class T>
+T prefix_sum(const T* a, size_t n, T* out, T carry) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2)
+        return mystl::prefix_sum_avx2<Exclusive>(a, n, out, carry);
+#endif
+    return mystl::prefix_sum_scalar<Exclusive>(a, n, out, carry);
+}
+
+/*****************************************************************************************/
+// inclusive_scan
+// 版本1：计算前缀和，out[i] = x[0] + ... + x[i]
+// 版本2：以二元操作 binary_op 代替加法
+// 版本3：以 init 为初值，out[i] = init op x[0] op ... op x[i]
+// 与 partial_sum 相同，但允许并行版本以任意顺序结合，binary_op 需要满足结合律
+// result 可以等于 first
+/*****************************************************************************************/
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter unchecked_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    BinaryOp binary_op, T init) {
+    for(; first != last; ++first, ++result) {
+        init = binary_op(init, *first);
+        *result = init;
+    }
+    return result;
+}
+
+// 为连续整型区间的加法提供特化版本
+template <class Tp, class Up, class T>
+std::enable_if_t<
+    is_scan_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+    std::is_same<Up, T>::value, Up*>
+unchecked_inclusive_scan(Tp* first, Tp* last, Up* result, mystl::plus<T>, T init) {
+    const auto n = static_cast<size_t>(last - first);
+    mystl::prefix_sum<false>(first, n, result, init);
+    return result + n;
+}
+
+template <class InputIter, class OutputIter, class BinaryOp, class T>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          BinaryOp binary_op, T init) {
+    return mystl::unchecked_inclusive_scan(first, last, result, binary_op, init);
+}
+
+template <class InputIter, class OutputIter, class BinaryOp>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op) {
+    if(first == last)
+        return result;
+    typename iterator_traits<InputIter>::value_type init = *first;
+    *result = init;
+    return mystl::unchecked_inclusive_scan(++first, last, ++result, binary_op, init);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::inclusive_scan(first, last, result, mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// exclusive_scan
+// 版本1：以 init 为初值计算不含当前元素的前缀和，out[i] = init + x[0] + ... + x[i - 1]
+// 版本2：以二元操作 binary_op 代替加法
+// result 可以等于 first
+/*****************************************************************************************/
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter unchecked_exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    T init, BinaryOp binary_op) {
+    for(; first != last; ++first, ++result) {
+        T value = binary_op(init, *first);
+        *result = init;
+        init = value;
+    }
+    return result;
+}
+
+// 为连续整型区间的加法提供特化版本
+template <class Tp, class Up, class T>
+std::enable_if_t<
+    is_scan_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+    std::is_same<Up, T>::value, Up*>
+unchecked_exclusive_scan(Tp* first, Tp* last, Up* result, T init, mystl::plus<T>) {
+    const auto n = static_cast<size_t>(last - first);
+    mystl::prefix_sum<true>(first, n, result, init);
+    return result + n;
+}
+
+template <class InputIter, class OutputIter, class T, class BinaryOp>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                          T init, BinaryOp binary_op) {
+    return mystl::unchecked_exclusive_scan(first, last, result, init, binary_op);
+}
+
+template <class InputIter, class OutputIter, class T>
+OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init) {
+    return mystl::unchecked_exclusive_scan(first, last, result, init, mystl::plus<T>());
+}
+
+/*****************************************************************************************/
+// transform_inclusive_scan
+// 先以 unary_op 变换每个元素，再以 binary_op 计算包含当前元素的前缀，可以指定初值 init
+/*****************************************************************************************/
+template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp, class T>
+OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    BinaryOp binary_op, UnaryOp unary_op, T init) {
+    for(; first != last; ++first, ++result) {
+        init = binary_op(init, unary_op(*first));
+        *result = init;
+    }
+    return result;
+}
+
+template <class InputIter, class OutputIter, class BinaryOp, class UnaryOp>
+OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    BinaryOp binary_op, UnaryOp unary_op) {
+    if(first == last)
+        return result;
+    auto init = unary_op(*first);
+    *result = init;
+    return mystl::transform_inclusive_scan(++first, last, ++result, binary_op, unary_op, init);
+}
+
+/*****************************************************************************************/
+// transform_exclusive_scan
+// 先以 unary_op 变换每个元素，再以 init 为初值、binary_op 计算不含当前元素的前缀
+/*****************************************************************************************/
+template <class InputIter, class OutputIter, class T, class BinaryOp, class UnaryOp>
+OutputIter transform_exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                                    T init, BinaryOp binary_op, UnaryOp unary_op) {
+    for(; first != last; ++first, ++result) {
+        T value = binary_op(init, unary_op(*first));
+        *result = init;
+        init = value;
+    }
+    return result;
+}
+
 /*****************************************************************************************/
 // partial_sum
 // 版本1：计算局部累计求和，结果保存到以 result 为起始的区间上
 // 版本2：进行局部进行自定义二元操作
+// 与 inclusive_scan 相同，连续整型区间的求和使用向量化版本
 /*****************************************************************************************/
 template <class InputIter, class OutputIter>
 OutputIter partial_sum(InputIter first, InputIter last, OutputIter result) {
-    if(frist == last)
-        return result;
-    *result = *first;
-    auto value = *first;
-    while(++first != last) {
-        value += *first;
-        *(++result) = value;
-    }
-    return = ++result;
+    return mystl::inclusive_scan(first, last, result);
 }
 
 template <class InputIter, class OutputIter, class BinaryOp>
 OutputIter partial_sum(InputIter first, InputIter last, 
             OutputIter result, BinaryOp binary_op) {
-    if(frist == last)
-        return result;
-    *result = *first;
-    auto value = *first;
-    while(++first != last) {
-        value = binary_op(value, *first);
-        *(++result) = value;
+    return mystl::inclusive_scan(first, last, result, binary_op);
+}
+
+
+/*****************************************************************************************/
+// delta_encode / delta_decode
+// delta_encode: 把区间编码为相邻元素之差，第一个元素减去 base，result[i] = x[i] - x[i - 1]
+// delta_decode: delta_encode 的逆运算，以 base 为初值求前缀和
+// 整型按模运算，编码后再解码总能得到原值，适合压缩单调的时间戳等序列
+// result 可以等于 first，连续区间使用向量化版本
+/*****************************************************************************************/
+template <class InputIter, class OutputIter, class T>
+OutputIter unchecked_delta_encode(InputIter first, InputIter last, OutputIter result, T base) {
+    for(; first != last; ++first, ++result) {
+        T value = *first;
+        *result = mystl::difference_value(value, base);
+        base = value;
+    }
+    return result;
+}
+
+// 为连续区间提供特化版本
+template <class Tp, class Up, class T>
+std::enable_if_t<
+    is_sequence_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+    std::is_same<Up, T>::value, Up*>
+unchecked_delta_encode(Tp* first, Tp* last, Up* result, T base) {
+    const auto n = static_cast<size_t>(last - first);
+    mystl::adjacent_difference_n(first, n, result, base);
+    return result + n;
+}
+
+template <class InputIter, class OutputIter, class T>
+OutputIter delta_encode(InputIter first, InputIter last, OutputIter result, T base) {
+    return mystl::unchecked_delta_encode(first, last, result, base);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter delta_encode(InputIter first, InputIter last, OutputIter result) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::unchecked_delta_encode(first, last, result, value_type());
+}
+
+// 整型按无符号数累加，与编码时的减法一样回绕，不会产生有符号溢出
+template <class InputIter, class OutputIter, class T>
+OutputIter unchecked_delta_decode(InputIter first, InputIter last, OutputIter result, T base) {
+    for(; first != last; ++first, ++result) {
+        base = mystl::sum_value(base, static_cast<T>(*first));
+        *result = base;
+    }
+    return result;
+}
+
+// 为连续区间提供特化版本，前缀和的向量化版本同样按模运算
+template <class Tp, class Up, class T>
+std::enable_if_t<
+    is_scan_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+    std::is_same<Up, T>::value, Up*>
+unchecked_delta_decode(Tp* first, Tp* last, Up* result, T base) {
+    const auto n = static_cast<size_t>(last - first);
+    mystl::prefix_sum<false>(first, n, result, base);
+    return result + n;
+}
+
+template <class InputIter, class OutputIter, class T>
+OutputIter delta_decode(InputIter first, InputIter last, OutputIter result, T base) {
+    return mystl::unchecked_delta_decode(first, last, result, base);
+}
+
+template <class InputIter, class OutputIter>
+OutputIter delta_decode(InputIter first, InputIter last, OutputIter result) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::unchecked_delta_decode(first, last, result, value_type());
+}
+
+/*****************************************************************************************/
+// 连续浮点区间的求和与点积
+// 使用多个累加器打破加法的依赖链，点积使用 FMA
+// compensated_sum 以 TwoSum 精确记录每次加法的舍入误差 (Ogita-Rump-Oishi 的 Sum2 / Dot2)，
+// 结果与以两倍精度计算后再舍入相当
+/*****************************************************************************************/
+template <class T>
+struct is_reduce_simd_type : public m_bool_constant<
+    std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+// 带误差补偿的累加器
+template <class T>
+struct compensated_sum {
+    T sum;
+    T err;
+
+    compensated_sum() : sum(), err() {}
+    explicit compensated_sum(T init) : sum(init), err() {}
+
+    // TwoSum: sum + x 的舍入误差记入 err
+    void add(T x) noexcept {
+        const T s = sum + x;
+        const T bb = s - sum;
+        err += (sum - (s - bb)) + (x - bb);
+        sum = s;
+    }
+
+    void merge(const compensated_sum& rhs) noexcept {
+        add(rhs.sum);
+        err += rhs.err;
+    }
+
+    T value() const noexcept { return sum + err; }
+};
+
+template <class T>
+T sum_scalar(const T* a, size_t n) noexcept {
+    T s0 = T(), s1 = T(), s2 = T(), s3 = T();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        s0 += a[i];
+        s1 += a[i + 1];
+        s2 += a[i + 2];
+        s3 += a[i + 3];
+    }
+    for(; i < n; ++i)
+        s0 += a[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+template <class T>
+T dot_scalar(const T* a, const T* b, size_t n) noexcept {
+    T s0 = T(), s1 = T(), s2 = T(), s3 = T();
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for(; i < n; ++i)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+template <class T>
+void compensated_sum_scalar(const T* a, size_t n, compensated_sum<T>& acc) noexcept {
+    for(size_t i = 0; i < n; ++i)
+        acc.add(a[i]);
+}
+
+// 乘积的舍入误差由 fma 精确求出
+template <class T>
+void compensated_dot_scalar(const T* a, const T* b, size_t n, compensated_sum<T>& acc) noexcept {
+    for(size_t i = 0; i < n; ++i) {
+        const T p = a[i] * b[i];
+        acc.add(p);
+        acc.err += std::fma(a[i], b[i], -p);
+    }
+}
+
+#ifdef MYSTL_SIMD_X86
+template <class T>
+struct avx2_float_ops;
+
+template <>
+struct avx2_float_ops<float> {
+    typedef __m256 vec;
+    static constexpr size_t lanes = 8;
+    MYSTL_TARGET_AVX2 static vec zero() { return _mm256_setzero_ps(); }
+    MYSTL_TARGET_AVX2 static vec load(const float* p) { return _mm256_loadu_ps(p); }
+    MYSTL_TARGET_AVX2 static void store(float* p, vec x) { _mm256_storeu_ps(p, x); }
+    MYSTL_TARGET_AVX2 static vec add(vec x, vec y) { return _mm256_add_ps(x, y); }
+    MYSTL_TARGET_AVX2 static vec sub(vec x, vec y) { return _mm256_sub_ps(x, y); }
+    MYSTL_TARGET_AVX2 static vec mul(vec x, vec y) { return _mm256_mul_ps(x, y); }
+    // x * y + z 与 x * y - z，只舍入一次
+    MYSTL_TARGET_FMA static vec fmadd(vec x, vec y, vec z) { return _mm256_fmadd_ps(x, y, z); }
+    MYSTL_TARGET_FMA static vec fmsub(vec x, vec y, vec z) { return _mm256_fmsub_ps(x, y, z); }
+};
+
+template <>
+struct avx2_float_ops<double> {
+    typedef __m256d vec;
+    static constexpr size_t lanes = 4;
+    MYSTL_TARGET_AVX2 static vec zero() { return _mm256_setzero_pd(); }
+    MYSTL_TARGET_AVX2 static vec load(const double* p) { return _mm256_loadu_pd(p); }
+    MYSTL_TARGET_AVX2 static void store(double* p, vec x) { _mm256_storeu_pd(p, x); }
+    MYSTL_TARGET_AVX2 static vec add(vec x, vec y) { return _mm256_add_pd(x, y); }
+    MYSTL_TARGET_AVX2 static vec sub(vec x, vec y) { return _mm256_sub_pd(x, y); }
+    MYSTL_TARGET_AVX2 static vec mul(vec x, vec y) { return _mm256_mul_pd(x, y); }
+    MYSTL_TARGET_FMA static vec fmadd(vec x, vec y, vec z) { return _mm256_fmadd_pd(x, y, z); }
+    MYSTL_TARGET_FMA static vec fmsub(vec x, vec y, vec z) { return _mm256_fmsub_pd(x, y, z); }
+};
+
+// 逐通道的 TwoSum
+template <class Ops>
+MYSTL_TARGET_AVX2
+void two_sum_avx2(typename Ops::vec& s, typename Ops::vec& e, typename Ops::vec x) {
+    const typename Ops::vec t = Ops::add(s, x);
+    const typename Ops::vec bb = Ops::sub(t, s);
+    e = Ops::add(e, Ops::add(Ops::sub(s, Ops::sub(t, bb)), Ops::sub(x, bb)));
+    s = t;
+}
+
+template <class T>
+MYSTL_TARGET_AVX2
+T sum_avx2(const T* a, size_t n) noexcept {
+    typedef avx2_float_ops<T> ops;
+    constexpr size_t L = ops::lanes;
+    typename ops::vec s0 = ops::zero(), s1 = ops::zero(), s2 = ops::zero(), s3 = ops::zero();
+    size_t i = 0;
+    for(; i + 4 * L <= n; i += 4 * L) {
+        s0 = ops::add(s0, ops::load(a + i));
+        s1 = ops::add(s1, ops::load(a + i + L));
+        s2 = ops::add(s2, ops::load(a + i + 2 * L));
+        s3 = ops::add(s3, ops::load(a + i + 3 * L));
+    }
+    for(; i + L <= n; i += L)
+        s0 = ops::add(s0, ops::load(a + i));
+    T lane[L];
+    ops::store(lane, ops::add(ops::add(s0, s1), ops::add(s2, s3)));
+    T s = mystl::sum_scalar(a + i, n - i);
+    for(size_t k = 0; k < L; ++k)
+        s += lane[k];
+    return s;
+}
+
+template <class T>
+MYSTL_TARGET_FMA
+T dot_fma(const T* a, const T* b, size_t n) noexcept {
+    typedef avx2_float_ops<T> ops;
+    constexpr size_t L = ops::lanes;
+    typename ops::vec s0 = ops::zero(), s1 = ops::zero(), s2 = ops::zero(), s3 = ops::zero();
+    size_t i = 0;
+    for(; i + 4 * L <= n; i += 4 * L) {
+        s0 = ops::fmadd(ops::load(a + i), ops::load(b + i), s0);
+        s1 = ops::fmadd(ops::load(a + i + L), ops::load(b + i + L), s1);
+        s2 = ops::fmadd(ops::load(a + i + 2 * L), ops::load(b + i + 2 * L), s2);
+        s3 = ops::fmadd(ops::load(a + i + 3 * L), ops::load(b + i + 3 * L), s3);
+    }
+    for(; i + L <= n; i += L)
+        s0 = ops::fmadd(ops::load(a + i), ops::load(b + i), s0);
+    T lane[L];
+    ops::store(lane, ops::add(ops::add(s0, s1), ops::add(s2, s3)));
+    T s = mystl::dot_scalar(a + i, b + i, n - i);
+    for(size_t k = 0; k < L; ++k)
+        s += lane[k];
+    return s;
+}
+
+// 两组 (和, 误差) 累加器交替使用，最后把各通道依次并入 acc
+template <class T>
+MYSTL_TARGET_AVX2
+void compensated_sum_avx2(const T* a, size_t n, compensated_sum<T>& acc) noexcept {
+    typedef avx2_float_ops<T> ops;
+    constexpr size_t L = ops::lanes;
+    typename ops::vec s0 = ops::zero(), e0 = ops::zero(), s1 = ops::zero(), e1 = ops::zero();
+    size_t i = 0;
+    for(; i + 2 * L <= n; i += 2 * L) {
+        mystl::two_sum_avx2<ops>(s0, e0, ops::load(a + i));
+        mystl::two_sum_avx2<ops>(s1, e1, ops::load(a + i + L));
+    }
+    T sl[2 * L], el[2 * L];
+    ops::store(sl, s0);
+    ops::store(sl + L, s1);
+    ops::store(el, e0);
+    ops::store(el + L, e1);
+    for(size_t k = 0; k < 2 * L; ++k) {
+        acc.add(sl[k]);
+        acc.err += el[k];
+    }
+    mystl::compensated_sum_scalar(a + i, n - i, acc);
+}
+
+template <class T>
+MYSTL_TARGET_FMA
+void compensated_dot_fma(const T* a, const T* b, size_t n, compensated_sum<T>& acc) noexcept {
+    typedef avx2_float_ops<T> ops;
+    constexpr size_t L = ops::lanes;
+    typename ops::vec s0 = ops::zero(), e0 = ops::zero(), s1 = ops::zero(), e1 = ops::zero();
+    size_t i = 0;
+    for(; i + 2 * L <= n; i += 2 * L) {
+        const typename ops::vec x0 = ops::load(a + i), y0 = ops::load(b + i);
+        const typename ops::vec x1 = ops::load(a + i + L), y1 = ops::load(b + i + L);
+        const typename ops::vec p0 = ops::mul(x0, y0), p1 = ops::mul(x1, y1);
+        mystl::two_sum_avx2<ops>(s0, e0, p0);
+        mystl::two_sum_avx2<ops>(s1, e1, p1);
+        e0 = ops::add(e0, ops::fmsub(x0, y0, p0));
+        e1 = ops::add(e1, ops::fmsub(x1, y1, p1));
+    }
+    T sl[2 * L], el[2 * L];
+    ops::store(sl, s0);
+    ops::store(sl + L, s1);
+    ops::store(el, e0);
+    ops::store(el + L, e1);
+    for(size_t k = 0; k < 2 * L; ++k) {
+        acc.add(sl[k]);
+        acc.err += el[k];
+    }
+    mystl::compensated_dot_scalar(a + i, b + i, n - i, acc);
+}
+#endif // MYSTL_SIMD_X86
+
+// 根据 CPU 特性选择内核
+template <class T>
+T sum_n(const T* a, size_t n) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2)
+        return mystl::sum_avx2(a, n);
+#endif
+    return mystl::sum_scalar(a, n);
+}
+
+template <class T>
+T dot_n(const T* a, const T* b, size_t n) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2 && mystl::simd_has_fma())
+        return mystl::dot_fma(a, b, n);
+#endif
+    return mystl::dot_scalar(a, b, n);
+}
+
+template <class T>
+void compensated_sum_n(const T* a, size_t n, compensated_sum<T>& acc) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2) {
+        mystl::compensated_sum_avx2(a, n, acc);
+        return;
+    }
+#endif
+    mystl::compensated_sum_scalar(a, n, acc);
+}
+
+template <class T>
+void compensated_dot_n(const T* a, const T* b, size_t n, compensated_sum<T>& acc) noexcept {
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= simd_avx2 && mystl::simd_has_fma()) {
+        mystl::compensated_dot_fma(a, b, n, acc);
+        return;
+    }
+#endif
+    mystl::compensated_dot_scalar(a, b, n, acc);
+}
+
+/*****************************************************************************************/
+// reduce
+// 版本1：以 value_type() 为初值对区间求和
+// 版本2：以 init 为初值对区间求和
+// 版本3：以二元操作 binary_op 代替加法
+// 与 accumulate 不同，元素可以按任意顺序结合，binary_op 需要满足结合律与交换律
+// 随机访问迭代器使用四个累加器，连续的 float / double 区间求和使用向量化版本
+/*****************************************************************************************/
+template <class InputIter, class T, class BinaryOp>
+T reduce_dispatch(InputIter first, InputIter last, T init, BinaryOp binary_op,
+                  input_iterator_tag) {
+    for(; first != last; ++first)
+        init = binary_op(init, *first);
+    return init;
+}
+
+template <class RandomIter, class T, class BinaryOp>
+T reduce_dispatch(RandomIter first, RandomIter last, T init, BinaryOp binary_op,
+                  random_access_iterator_tag) {
+    const auto n = last - first;
+    if(n < 8)
+        return mystl::reduce_dispatch(first, last, init, binary_op, input_iterator_tag());
+    T s0 = first[0], s1 = first[1], s2 = first[2], s3 = first[3];
+    auto i = static_cast<decltype(n)>(4);
+    for(; i + 4 <= n; i += 4) {
+        s0 = binary_op(s0, first[i]);
+        s1 = binary_op(s1, first[i + 1]);
+        s2 = binary_op(s2, first[i + 2]);
+        s3 = binary_op(s3, first[i + 3]);
+    }
+    for(; i < n; ++i)
+        s0 = binary_op(s0, first[i]);
+    return binary_op(init, binary_op(binary_op(s0, s1), binary_op(s2, s3)));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T unchecked_reduce(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    return mystl::reduce_dispatch(first, last, init, binary_op, iterator_category(first));
+}
+
+// 为连续浮点区间的加法提供特化版本
+template <class Tp, class T>
+std::enable_if_t<
+    is_reduce_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value, T>
+unchecked_reduce(Tp* first, Tp* last, T init, mystl::plus<T>) {
+    return init + mystl::sum_n(first, static_cast<size_t>(last - first));
+}
+
+template <class InputIter, class T, class BinaryOp>
+T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    return mystl::unchecked_reduce(first, last, init, binary_op);
+}
+
+template <class InputIter, class T>
+T reduce(InputIter first, InputIter last, T init) {
+    return mystl::unchecked_reduce(first, last, init, mystl::plus<T>());
+}
+
+template <class InputIter>
+typename iterator_traits<InputIter>::value_type
+reduce(InputIter first, InputIter last) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::unchecked_reduce(first, last, value_type(), mystl::plus<value_type>());
+}
+
+/*****************************************************************************************/
+// transform_reduce
+// 版本1：以 init 为初值计算两个区间的内积
+// 版本2：以 binary_op2 代替乘法，以 binary_op1 代替加法
+// 版本3：以 unary_op 变换每个元素，再以 binary_op 归约
+// 与 inner_product 不同，元素可以按任意顺序结合，归约操作需要满足结合律与交换律
+// 连续的 float / double 区间的内积使用 FMA 向量化版本
+/*****************************************************************************************/
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T unchecked_transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                             BinaryOp1 binary_op1, BinaryOp2 binary_op2) {
+    if constexpr(is_random_access_iterator<InputIter1>::value &&
+                 is_random_access_iterator<InputIter2>::value) {
+        const auto n = last1 - first1;
+        if(n >= 8) {
+            T s0 = binary_op2(first1[0], first2[0]), s1 = binary_op2(first1[1], first2[1]);
+            T s2 = binary_op2(first1[2], first2[2]), s3 = binary_op2(first1[3], first2[3]);
+            auto i = static_cast<decltype(n)>(4);
+            for(; i + 4 <= n; i += 4) {
+                s0 = binary_op1(s0, binary_op2(first1[i], first2[i]));
+                s1 = binary_op1(s1, binary_op2(first1[i + 1], first2[i + 1]));
+                s2 = binary_op1(s2, binary_op2(first1[i + 2], first2[i + 2]));
+                s3 = binary_op1(s3, binary_op2(first1[i + 3], first2[i + 3]));
+            }
+            for(; i < n; ++i)
+                s0 = binary_op1(s0, binary_op2(first1[i], first2[i]));
+            return binary_op1(init, binary_op1(binary_op1(s0, s1), binary_op1(s2, s3)));
+        }
+    }
+    for(; first1 != last1; ++first1, ++first2)
+        init = binary_op1(init, binary_op2(*first1, *first2));
+    return init;
+}
+
+// 为连续浮点区间的内积提供特化版本
+template <class Tp, class Up, class T>
+std::enable_if_t<
+    is_reduce_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+    std::is_same<typename std::remove_const<Up>::type, T>::value, T>
+unchecked_transform_reduce(Tp* first1, Tp* last1, Up* first2, T init,
+                           mystl::plus<T>, mystl::multiplies<T>) {
+    return init + mystl::dot_n(first1, first2, static_cast<size_t>(last1 - first1));
+}
+
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                   BinaryOp1 binary_op1, BinaryOp2 binary_op2) {
+    return mystl::unchecked_transform_reduce(first1, last1, first2, init, binary_op1, binary_op2);
+}
+
+template <class InputIter1, class InputIter2, class T>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+    return mystl::unchecked_transform_reduce(first1, last1, first2, init,
+                                             mystl::plus<T>(), mystl::multiplies<T>());
+}
+
+template <class InputIter, class T, class BinaryOp, class UnaryOp>
+T transform_reduce(InputIter first, InputIter last, T init, BinaryOp binary_op, UnaryOp unary_op) {
+    if constexpr(is_random_access_iterator<InputIter>::value) {
+        const auto n = last - first;
+        if(n >= 8) {
+            T s0 = unary_op(first[0]), s1 = unary_op(first[1]);
+            T s2 = unary_op(first[2]), s3 = unary_op(first[3]);
+            auto i = static_cast<decltype(n)>(4);
+            for(; i + 4 <= n; i += 4) {
+                s0 = binary_op(s0, unary_op(first[i]));
+                s1 = binary_op(s1, unary_op(first[i + 1]));
+                s2 = binary_op(s2, unary_op(first[i + 2]));
+                s3 = binary_op(s3, unary_op(first[i + 3]));
+            }
+            for(; i < n; ++i)
+                s0 = binary_op(s0, unary_op(first[i]));
+            return binary_op(init, binary_op(binary_op(s0, s1), binary_op(s2, s3)));
+        }
+    }
+    for(; first != last; ++first)
+        init = binary_op(init, unary_op(*first));
+    return init;
+}
+
+/*****************************************************************************************/
+// compensated_reduce / compensated_transform_reduce
+// 以 init 为初值对浮点区间求和 / 计算两个浮点区间的内积，并补偿每次加法和乘法的舍入误差
+// 长区间上的误差与条件数无关地保持在几个 ulp 以内，代价约为普通版本的两到三倍
+/*****************************************************************************************/
+template <class InputIter, class T>
+void compensated_reduce_aux(InputIter first, InputIter last, compensated_sum<T>& acc) {
+    for(; first != last; ++first)
+        acc.add(static_cast<T>(*first));
+}
+
+template <class Tp, class T>
+std::enable_if_t<
+    is_reduce_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value>
+compensated_reduce_aux(Tp* first, Tp* last, compensated_sum<T>& acc) {
+    mystl::compensated_sum_n(first, static_cast<size_t>(last - first), acc);
+}
+
+template <class InputIter1, class InputIter2, class T>
+void compensated_transform_reduce_aux(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                      compensated_sum<T>& acc) {
+    for(; first1 != last1; ++first1, ++first2) {
+        const T x = *first1, y = *first2;
+        const T p = x * y;
+        acc.add(p);
+        acc.err += std::fma(x, y, -p);
     }
-    return = ++result;
 }
 
+template <class Tp, class Up, class T>
+std::enable_if_t<
+    is_reduce_simd_type<T>::value &&
+    std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+    std::is_same<typename std::remove_const<Up>::type, T>::value>
+compensated_transform_reduce_aux(Tp* first1, Tp* last1, Up* first2, compensated_sum<T>& acc) {
+    mystl::compensated_dot_n(first1, first2, static_cast<size_t>(last1 - first1), acc);
+}
+
+template <class InputIter, class T>
+T compensated_reduce(InputIter first, InputIter last, T init) {
+    static_assert(std::is_floating_point<T>::value, "compensated_reduce requires a floating point type");
+    compensated_sum<T> acc(init);
+    mystl::compensated_reduce_aux(first, last, acc);
+    return acc.value();
+}
+
+template <class InputIter1, class InputIter2, class T>
+T compensated_transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+    static_assert(std::is_floating_point<T>::value,
+                  "compensated_transform_reduce requires a floating point type");
+    compensated_sum<T> acc(init);
+    mystl::compensated_transform_reduce_aux(first1, last1, first2, acc);
+    return acc.value();
+}
 
 } // namespace mystl 
 
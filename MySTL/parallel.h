@@ -0,0 +1,611 @@
+#ifndef MYSTL_PARALLEL_H_
+#define MYSTL_PARALLEL_H_
+
+// 这个头文件包含并行算法共用的运行时: 工作窃取线程池、fork / join 任务组，
+// 以及 parallel_invoke_n / parallel_for / parallel_reduce 等辅助函数
+
+// 每个工作线程有一个 Chase-Lev 双端队列，自己从底部压入、弹出任务，空闲时从其他线程的队列顶部窃取
+// 非工作线程提交的任务放入全局队列
+// 等待任务组的线程不会阻塞，而是继续执行其他任务，所以递归地创建任务组不会耗尽线程
+// 找不到任务的工作线程先自旋，再让出时间片，最后休眠，直到有新任务提交
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace mystl {
+
+// 硬件线程数，无法获取时为 1
+// 编译时定义 MYSTL_PARALLEL_THREADS 可以指定线程数，用于测试与测量不同线程数下的扩展性
+inline size_t hardware_threads() noexcept {
+#ifdef MYSTL_PARALLEL_THREADS
+    return MYSTL_PARALLEL_THREADS > 0 ? static_cast<size_t>(MYSTL_PARALLEL_THREADS) : 1;
+#else
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<size_t>(n);
+#endif
+}
+
+// 自旋等待时降低功耗，并让出超线程的执行资源
+inline void cpu_relax() noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/*****************************************************************************************/
+// work_stealing_deque
+// Chase-Lev 双端队列: 所有者在 bottom 端 push / pop，其他线程在 top 端 steal
+// 只有 pop 与 steal 争抢最后一个元素时需要 CAS
+// 容量不足时扩容为两倍，旧数组可能仍被窃取者读取，挂在新数组上直到析构时释放
+/*****************************************************************************************/
+template <class T>
+class work_stealing_deque {
+private:
+    struct ring {
+        int64_t         mask;
+        std::atomic<T>* slots;
+        ring*           retired;    // 扩容前的数组
+
+        explicit ring(int64_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<T>[capacity]), retired(nullptr) {}
+        ~ring() { delete[] slots; }
+
+        int64_t capacity() const noexcept { return mask + 1; }
+        T load(int64_t i) const noexcept { return slots[i & mask].load(std::memory_order_relaxed); }
+        void store(int64_t i, T x) noexcept { slots[i & mask].store(x, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<int64_t> top;       // 窃取端
+    alignas(64) std::atomic<int64_t> bottom;    // 所有者端
+    std::atomic<ring*>               array;
+
+public:
+    // capacity 必须是 2 的幂
+    explicit work_stealing_deque(int64_t capacity = 256)
+        : top(0), bottom(0), array(new ring(capacity)) {}
+
+    ~work_stealing_deque() {
+        ring* a = array.load(std::memory_order_relaxed);
+        while(a) {
+            ring* prev = a->retired;
+            delete a;
+            a = prev;
+        }
+    }
+
+    bool empty() const noexcept {
+        return bottom.load(std::memory_order_seq_cst) <= top.load(std::memory_order_seq_cst);
+    }
+
+    // 只能由所有者调用
+    void push(T x) {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        ring* a = array.load(std::memory_order_relaxed);
+        if(b - t >= a->capacity()) {
+            ring* bigger = new ring(a->capacity() * 2);
+            for(int64_t i = t; i < b; ++i)
+                bigger->store(i, a->load(i));
+            bigger->retired = a;
+            array.store(bigger, std::memory_order_release);
+            a = bigger;
+        }
+        a->store(b, x);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // 只能由所有者调用，队列为空时返回 T()
+    T pop() {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        ring* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_seq_cst);
+        if(t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return T();
+        }
+        T x = a->load(b);
+        if(t == b) {
+            // 最后一个元素，与窃取者竞争
+            if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed))
+                x = T();
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    // 可由任意线程调用，队列为空或竞争失败时返回 T()
+    T steal() {
+        int64_t t = top.load(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_seq_cst);
+        if(t >= b)
+            return T();
+        ring* a = array.load(std::memory_order_acquire);
+        T x = a->load(t);
+        if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+            return T();
+        return x;
+    }
+
+private:
+    work_stealing_deque(const work_stealing_deque&);
+    void operator=(const work_stealing_deque&);
+};
+
+/*****************************************************************************************/
+// thread_pool
+// 工作窃取线程池，任务是侵入式链表的节点，提交时不需要额外的类型擦除容器
+// 任务的 run 不能抛出异常，需要传递异常时使用 task_group
+/*****************************************************************************************/
+struct pool_task {
+    pool_task* next = nullptr;
+    virtual void run() = 0;
+    virtual ~pool_task() {}
+};
+
+template <class Function>
+struct pool_function_task : public pool_task {
+    Function f;
+    explicit pool_function_task(const Function& fn) : f(fn) {}
+    void run() override { f(); }
+};
+
+constexpr static size_t kPoolSpinRounds  = 64;   // 找不到任务时自旋的次数
+constexpr static size_t kPoolYieldRounds = 16;   // 自旋之后让出时间片的次数，之后休眠
+
+class thread_pool {
+private:
+    struct worker {
+        work_stealing_deque<pool_task*> deque;
+    };
+
+    // 当前线程所属的线程池及其下标
+    struct worker_slot {
+        const thread_pool* pool = nullptr;
+        size_t             index = 0;
+        uint32_t           seed = 0x9e3779b9u;  // 选择窃取对象的随机数
+    };
+
+    static worker_slot& current_slot() noexcept {
+        thread_local worker_slot slot;
+        return slot;
+    }
+
+    constexpr static size_t npos = static_cast<size_t>(-1);
+
+    worker*                 workers;
+    std::thread*            threads;
+    size_t                  capacity;    // 队列个数，工作线程只读取这个值
+    size_t                  count;       // 成功创建的工作线程数
+    pool_task*              head;        // 全局队列，存放非工作线程提交的任务
+    pool_task*              tail;
+    std::atomic<size_t>     queued;      // 全局队列中的任务数
+    std::atomic<size_t>     sleeping;    // 休眠中的工作线程数
+    std::atomic<bool>       stopping;
+    std::mutex              mutex;       // 保护全局队列和休眠
+    std::condition_variable cond;
+
+public:
+    // 创建 n 个工作线程，无法创建更多线程时保留已创建的线程
+    explicit thread_pool(size_t n)
+        : workers(nullptr), threads(nullptr), capacity(n), count(0), head(nullptr), tail(nullptr),
+          queued(0), sleeping(0), stopping(false) {
+        if(n == 0)
+            return;
+        workers = new worker[n];
+        threads = new std::thread[n];
+        try {
+            for(; count < n; ++count) {
+                const size_t index = count;
+                threads[count] = std::thread([this, index] { worker_loop(index); });
+            }
+        }
+        catch(...) {}
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping.store(true, std::memory_order_seq_cst);
+        }
+        cond.notify_all();
+        for(size_t i = 0; i < count; ++i)
+            threads[i].join();
+        for(size_t i = 0; i < capacity; ++i) {
+            while(pool_task* t = workers[i].deque.pop())
+                delete t;
+        }
+        while(head) {
+            pool_task* t = head;
+            head = head->next;
+            delete t;
+        }
+        delete[] threads;
+        delete[] workers;
+    }
+
+    size_t size() const noexcept { return count; }
+
+    // 提交一个任务，工作线程提交到自己的队列，其他线程提交到全局队列
+    // 没有工作线程时由调用线程直接执行
+    template <class Function>
+    void submit(const Function& f) {
+        if(count == 0) {
+            f();
+            return;
+        }
+        pool_task* t = new pool_function_task<Function>(f);
+        const worker_slot& slot = current_slot();
+        if(slot.pool == this) {
+            workers[slot.index].deque.push(t);
+        }
+        else {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(tail)
+                tail->next = t;
+            else
+                head = t;
+            tail = t;
+            queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        // 与 park 中先登记休眠再检查队列的顺序配合，保证新任务不会被休眠的线程漏掉
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(sleeping.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cond.notify_one();
+        }
+    }
+
+    // 执行其他任务直到 pred() 为 true，用于等待已提交的任务完成
+    template <class Predicate>
+    void wait_until(Predicate pred) {
+        const worker_slot& slot = current_slot();
+        const size_t self = slot.pool == this ? slot.index : npos;
+        size_t idle = 0;
+        while(!pred()) {
+            if(pool_task* t = find_task(self)) {
+                run_task(t);
+                idle = 0;
+            }
+            else if(++idle < kPoolSpinRounds) {
+                mystl::cpu_relax();
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    void worker_loop(size_t index) {
+        worker_slot& slot = current_slot();
+        slot.pool = this;
+        slot.index = index;
+        slot.seed = static_cast<uint32_t>(index + 1) * 2654435761u;
+        size_t idle = 0;
+        while(true) {
+            if(pool_task* t = find_task(index)) {
+                run_task(t);
+                idle = 0;
+                continue;
+            }
+            if(stopping.load(std::memory_order_acquire))
+                return;
+            if(++idle < kPoolSpinRounds) {
+                mystl::cpu_relax();
+            }
+            else if(idle < kPoolSpinRounds + kPoolYieldRounds) {
+                std::this_thread::yield();
+            }
+            else {
+                park();
+                idle = 0;
+            }
+        }
+    }
+
+    void run_task(pool_task* t) {
+        t->run();
+        delete t;
+    }
+
+    // 依次尝试自己的队列、从随机起点窃取其他线程的队列、全局队列
+    pool_task* find_task(size_t self) {
+        if(capacity == 0)
+            return nullptr;
+        if(self != npos) {
+            if(pool_task* t = workers[self].deque.pop())
+                return t;
+        }
+        worker_slot& slot = current_slot();
+        slot.seed ^= slot.seed << 13;
+        slot.seed ^= slot.seed >> 17;
+        slot.seed ^= slot.seed << 5;
+        const size_t start = slot.seed % capacity;
+        for(size_t k = 0; k < capacity; ++k) {
+            const size_t victim = start + k < capacity ? start + k : start + k - capacity;
+            if(victim == self)
+                continue;
+            if(pool_task* t = workers[victim].deque.steal())
+                return t;
+        }
+        if(queued.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(head) {
+                pool_task* t = head;
+                head = head->next;
+                if(head == nullptr)
+                    tail = nullptr;
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return t;
+            }
+        }
+        return nullptr;
+    }
+
+    bool has_task() const noexcept {
+        if(queued.load(std::memory_order_seq_cst) > 0)
+            return true;
+        for(size_t i = 0; i < capacity; ++i) {
+            if(!workers[i].deque.empty())
+                return true;
+        }
+        return false;
+    }
+
+    // 登记休眠后再检查一次队列，提交任务的线程看到登记后会唤醒一个线程
+    void park() {
+        std::unique_lock<std::mutex> lock(mutex);
+        sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if(!has_task() && !stopping.load(std::memory_order_seq_cst))
+            cond.wait(lock);
+        sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    thread_pool(const thread_pool&);
+    void operator=(const thread_pool&);
+};
+
+// 所有并行算法共用的线程池，调用线程也参与计算，所以工作线程比硬件线程少一个
+inline thread_pool& default_thread_pool() {
+    static thread_pool pool(hardware_threads() - 1);
+    return pool;
+}
+
+/*****************************************************************************************/
+// task_group
+// fork / join 任务组: run 提交任务，wait 等待组内全部任务结束
+// 等待时当前线程继续执行线程池中的任务，任务中可以再创建任务组
+// 任一任务抛出异常时，wait 在全部任务结束后重新抛出第一个异常
+/*****************************************************************************************/
+class task_group {
+private:
+    std::atomic<size_t> pending;    // 尚未结束的任务数
+    std::exception_ptr  error;
+    std::mutex          mutex;
+
+public:
+    task_group() : pending(0) {}
+
+    // 析构前没有 wait 时等待全部任务结束，丢弃异常
+    ~task_group() {
+        mystl::default_thread_pool().wait_until([this] {
+            return pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    template <class Function>
+    void run(const Function& f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        try {
+            mystl::default_thread_pool().submit([this, f] {
+                try {
+                    f();
+                }
+                catch(...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!error)
+                        error = std::current_exception();
+                }
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        catch(...) {
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void wait() {
+        mystl::default_thread_pool().wait_until([this] {
+            return pending.load(std::memory_order_acquire) == 0;
+        });
+        if(error) {
+            std::exception_ptr e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    task_group(const task_group&);
+    void operator=(const task_group&);
+};
+
+// 并行执行 f1 和 f2，f2 交给线程池，调用线程执行 f1
+template <class Function1, class Function2>
+void parallel_invoke(const Function1& f1, const Function2& f2) {
+    task_group group;
+    group.run(f2);
+    f1();
+    group.wait();
+}
+
+/*****************************************************************************************/
+// parallel_invoke_n
+// 并行执行 f(0), f(1), ..., f(n - 1)，调用线程也参与执行
+// 下标由调用线程和不超过工作线程数的辅助任务动态领取
+// 任一任务抛出异常时，等待全部任务结束后重新抛出第一个异常
+/*****************************************************************************************/
+template <class Function>
+void parallel_invoke_n(size_t n, Function f) {
+    if(n == 0)
+        return;
+    thread_pool& pool = mystl::default_thread_pool();
+    if(n == 1 || pool.size() == 0) {
+        for(size_t i = 0; i < n; ++i)
+            f(i);
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&] {
+        size_t i;
+        while((i = next.fetch_add(1, std::memory_order_relaxed)) < n) {
+            try {
+                f(i);
+            }
+            catch(...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+    {
+        task_group group;
+        const size_t helpers = n - 1 < pool.size() ? n - 1 : pool.size();
+        try {
+            for(size_t h = 0; h < helpers; ++h)
+                group.run(work);
+        }
+        catch(...) {
+            // 无法提交更多任务时，剩余的下标由调用线程执行
+        }
+        work();
+        group.wait();
+    }
+    if(error)
+        std::rethrow_exception(error);
+}
+
+/*****************************************************************************************/
+// parallel_for_chunks
+// 把 [0, n) 分成若干块并行执行 f(begin, end)
+// 块数取线程数的若干倍以便负载均衡，每块至少 grain 个元素
+/*****************************************************************************************/
+constexpr static size_t kParallelChunksPerThread = 4;
+
+// 分块数，n 不足两块时为 1，由调用者使用串行版本
+inline size_t parallel_chunk_count(size_t n, size_t grain) noexcept {
+    if(grain == 0)
+        grain = 1;
+    const size_t max_parts = mystl::hardware_threads() * kParallelChunksPerThread;
+    const size_t parts = n / grain;
+    return parts == 0 ? 1 : (parts < max_parts ? parts : max_parts);
+}
+
+// 第 p 块的起点，前 n % parts 块各多一个元素
+inline size_t parallel_chunk_begin(size_t n, size_t parts, size_t p) noexcept {
+    const size_t extra = n % parts;
+    return n / parts * p + (p < extra ? p : extra);
+}
+
+template <class Function>
+void parallel_for_chunks(size_t n, size_t grain, Function f) {
+    const size_t parts = mystl::parallel_chunk_count(n, grain);
+    mystl::parallel_invoke_n(parts, [&](size_t p) {
+        f(mystl::parallel_chunk_begin(n, parts, p), mystl::parallel_chunk_begin(n, parts, p + 1));
+    });
+}
+
+/*****************************************************************************************/
+// parallel_for
+// 对 [first, last) 递归二分，右半部分交给线程池，左半部分继续二分，不超过 grain 个元素时执行 f(begin, end)
+// 被窃取的总是剩余区间中最大的一块，各块耗时不均匀时也能保持负载平衡
+// grain 为 0 时按线程数自动选择
+/*****************************************************************************************/
+template <class Function>
+void parallel_for_aux(size_t first, size_t last, size_t grain, const Function& f) {
+    task_group group;
+    while(last - first > grain) {
+        const size_t mid = first + (last - first) / 2;
+        group.run([mid, last, grain, &f] { mystl::parallel_for_aux(mid, last, grain, f); });
+        last = mid;
+    }
+    f(first, last);
+    group.wait();
+}
+
+// 自动选择的粒度: 每个线程约 2 * kParallelChunksPerThread 块
+inline size_t parallel_default_grain(size_t n) noexcept {
+    const size_t grain = n / (mystl::hardware_threads() * kParallelChunksPerThread * 2);
+    return grain == 0 ? 1 : grain;
+}
+
+template <class Function>
+void parallel_for(size_t first, size_t last, size_t grain, Function f) {
+    if(first >= last)
+        return;
+    if(grain == 0)
+        grain = mystl::parallel_default_grain(last - first);
+    if(mystl::default_thread_pool().size() == 0) {
+        f(first, last);
+        return;
+    }
+    mystl::parallel_for_aux(first, last, grain, f);
+}
+
+/*****************************************************************************************/
+// parallel_reduce
+// 对 [first, last) 递归二分，叶子区间调用 reduce(begin, end, identity) 得到部分结果，
+// 再按区间顺序用 combine(left, right) 合并，要求 combine 满足结合律，不要求交换律
+// grain 为 0 时按线程数自动选择
+/*****************************************************************************************/
+template <class T, class Reduce, class Combine>
+T parallel_reduce_aux(size_t first, size_t last, size_t grain, const T& identity,
+                      const Reduce& reduce, const Combine& combine) {
+    if(last - first <= grain)
+        return reduce(first, last, identity);
+    const size_t mid = first + (last - first) / 2;
+    T right = identity;
+    task_group group;
+    group.run([&] {
+        right = mystl::parallel_reduce_aux(mid, last, grain, identity, reduce, combine);
+    });
+    T left = mystl::parallel_reduce_aux(first, mid, grain, identity, reduce, combine);
+    group.wait();
+    return combine(left, right);
+}
+
+template <class T, class Reduce, class Combine>
+T parallel_reduce(size_t first, size_t last, size_t grain, const T& identity,
+                  Reduce reduce, Combine combine) {
+    if(first >= last)
+        return identity;
+    if(grain == 0)
+        grain = mystl::parallel_default_grain(last - first);
+    if(mystl::default_thread_pool().size() == 0)
+        return reduce(first, last, identity);
+    return mystl::parallel_reduce_aux(first, last, grain, identity, reduce, combine);
+}
+
+} // namespace mystl
+
+#endif // MYSTL_PARALLEL_H_
@@ -4,36 +4,389 @@
 // 这个头文件包含 set 的四种算法: union, intersection, difference, symmetric_difference
 // 所有函数都要求序列有序
 
+// 对 4 / 8 字节整型的指针区间提供快速路径: 交集使用 SIMD 分块比较，并集与对称差使用无分支归并
+// 另外提供多路 (multiway_set_union / multiway_set_intersection) 与并行两路版本
+
+#include <cstdint>
+
 #include "algobase.h"
 #include "iterator.h"
+#include "memory.h"
+#include "parallel.h"
+#include "simd.h"
 
 namespace mystl
 {
-    
+
+/*****************************************************************************************/
+// 连续整型区间的集合运算内核
+// 内核与 scalar 归并逐步等价，因此对含重复元素的序列(multiset)也得到相同结果
+// result 为空指针时只计数，不输出
+/*****************************************************************************************/
+// 可以使用快速路径的元素类型
+template <class T>
+struct is_set_simd_type : public m_bool_constant<
+    std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+    (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+constexpr static size_t kSetGallopRatio = 32;   // 两序列长度相差超过该倍数时，改用倍增查找
+
+// 无分支归并求交集，从 (i, j) 处开始，直到某一序列到达 end
+template <class T>
+size_t set_intersection_scalar(const T* a, size_t& i, size_t end_a,
+    const T* b, size_t& j, size_t end_b, T* result, size_t count) {
+    while(i < end_a && j < end_b) {
+        const T x = a[i], y = b[j];
+        if(x == y) {
+            if(result)
+                result[count] = x;
+            ++count;
+        }
+        i += (x <= y);
+        j += (y <= x);
+    }
+    return count;
+}
+
+// 在 [j, n) 中倍增查找第一个不小于 value 的位置
+template <class T>
+size_t gallop_lower_bound(const T* b, size_t j, size_t n, const T& value) {
+    size_t step = 1;
+    size_t lo = j, hi = j;
+    while(hi < n && b[hi] < value) {
+        lo = hi + 1;
+        hi += step;
+        step <<= 1;
+    }
+    if(hi > n)
+        hi = n;
+    while(lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if(b[mid] < value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// 短序列 a 中的每个元素在长序列 b 中倍增查找
+template <class T>
+size_t set_intersection_gallop(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    size_t count = 0;
+    size_t j = 0;
+    for(size_t i = 0; i < na && j < nb; ++i) {
+        j = mystl::gallop_lower_bound(b, j, nb, a[i]);
+        if(j < nb && b[j] == a[i]) {
+            if(result)
+                result[count] = a[i];
+            ++count;
+            ++j;
+        }
+    }
+    return count;
+}
+
+#ifdef MYSTL_SIMD_X86
+// 4 字节整型, SSE4.2, 每次比较 4x4 个元素
+// 块内存在重复元素时退回到 scalar 归并，以保持 multiset 语义
+template <class T>
+MYSTL_TARGET_SSE42
+size_t set_intersection_sse42_32(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    const __m128i bias = std::is_signed<T>::value ? _mm_setzero_si128()
+        : _mm_set1_epi32(static_cast<int>(0x80000000u));
+    size_t i = 0, j = 0, count = 0;
+    while(i + 4 <= na && j + 4 <= nb) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        const int dup_a = _mm_movemask_ps(_mm_castsi128_ps(
+            _mm_cmpeq_epi32(va, _mm_srli_si128(va, 4)))) & 0x7;
+        const int dup_b = _mm_movemask_ps(_mm_castsi128_ps(
+            _mm_cmpeq_epi32(vb, _mm_srli_si128(vb, 4)))) & 0x7;
+        if(dup_a | dup_b) {
+            count = mystl::set_intersection_scalar(a, i, i + 4, b, j, j + 4, result, count);
+            continue;
+        }
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        if(result) {
+            for(; mask != 0; mask &= mask - 1)
+                result[count++] = a[i + mystl::ctz32(mask)];
+        }
+        else {
+            count += mystl::popcount32(mask);
+        }
+        // 与 scalar 归并保持一致: 跳过所有不大于对方块最大值的元素
+        const __m128i amax = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(a[i + 3])), bias);
+        const __m128i bmax = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(b[j + 3])), bias);
+        const unsigned a_gt = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(
+            _mm_cmpgt_epi32(_mm_xor_si128(va, bias), bmax))));
+        const unsigned b_gt = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(
+            _mm_cmpgt_epi32(_mm_xor_si128(vb, bias), amax))));
+        i += 4 - mystl::popcount32(a_gt);
+        j += 4 - mystl::popcount32(b_gt);
+    }
+    return mystl::set_intersection_scalar(a, i, na, b, j, nb, result, count);
+}
+
+// 8 字节整型, SSE4.2, 每次比较 2x2 个元素
+template <class T>
+MYSTL_TARGET_SSE42
+size_t set_intersection_sse42_64(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    const __m128i bias = std::is_signed<T>::value ? _mm_setzero_si128()
+        : _mm_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+    size_t i = 0, j = 0, count = 0;
+    while(i + 2 <= na && j + 2 <= nb) {
+        if(a[i] == a[i + 1] || b[j] == b[j + 1]) {
+            count = mystl::set_intersection_scalar(a, i, i + 2, b, j, j + 2, result, count);
+            continue;
+        }
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i eq = _mm_cmpeq_epi64(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi64(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(eq)));
+        if(result) {
+            for(; mask != 0; mask &= mask - 1)
+                result[count++] = a[i + mystl::ctz32(mask)];
+        }
+        else {
+            count += mystl::popcount32(mask);
+        }
+        const __m128i amax = _mm_xor_si128(_mm_set1_epi64x(static_cast<long long>(a[i + 1])), bias);
+        const __m128i bmax = _mm_xor_si128(_mm_set1_epi64x(static_cast<long long>(b[j + 1])), bias);
+        const unsigned a_gt = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(
+            _mm_cmpgt_epi64(_mm_xor_si128(va, bias), bmax))));
+        const unsigned b_gt = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(
+            _mm_cmpgt_epi64(_mm_xor_si128(vb, bias), amax))));
+        i += 2 - mystl::popcount32(a_gt);
+        j += 2 - mystl::popcount32(b_gt);
+    }
+    return mystl::set_intersection_scalar(a, i, na, b, j, nb, result, count);
+}
+
+// 4 字节整型, AVX2, 每次比较 8x8 个元素
+template <class T>
+MYSTL_TARGET_AVX2
+size_t set_intersection_avx2_32(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    const __m256i bias = std::is_signed<T>::value ? _mm256_setzero_si256()
+        : _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256i next_lane = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 7);
+    size_t i = 0, j = 0, count = 0;
+    while(i + 8 <= na && j + 8 <= nb) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        const int dup_a = _mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(va, next_lane)))) & 0x7f;
+        const int dup_b = _mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(vb, _mm256_permutevar8x32_epi32(vb, next_lane)))) & 0x7f;
+        if(dup_a | dup_b) {
+            count = mystl::set_intersection_scalar(a, i, i + 8, b, j, j + 8, result, count);
+            continue;
+        }
+        // 128 位通道内轮转 4 次，再交换高低通道轮转 4 次，覆盖全部 8x8 组合
+        const __m256i vs = _mm256_permute2x128_si256(vb, vb, 1);
+        __m256i eq = _mm256_cmpeq_epi32(va, vb);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vs));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, _MM_SHUFFLE(2, 1, 0, 3))));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        if(result) {
+            for(; mask != 0; mask &= mask - 1)
+                result[count++] = a[i + mystl::ctz32(mask)];
+        }
+        else {
+            count += mystl::popcount32(mask);
+        }
+        const __m256i amax = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(a[i + 7])), bias);
+        const __m256i bmax = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(b[j + 7])), bias);
+        const unsigned a_gt = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(_mm256_xor_si256(va, bias), bmax))));
+        const unsigned b_gt = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(_mm256_xor_si256(vb, bias), amax))));
+        i += 8 - mystl::popcount32(a_gt);
+        j += 8 - mystl::popcount32(b_gt);
+    }
+    return mystl::set_intersection_scalar(a, i, na, b, j, nb, result, count);
+}
+
+// 8 字节整型, AVX2, 每次比较 4x4 个元素
+template <class T>
+MYSTL_TARGET_AVX2
+size_t set_intersection_avx2_64(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    const __m256i bias = std::is_signed<T>::value ? _mm256_setzero_si256()
+        : _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+    size_t i = 0, j = 0, count = 0;
+    while(i + 4 <= na && j + 4 <= nb) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        const int dup_a = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(
+            va, _mm256_permute4x64_epi64(va, _MM_SHUFFLE(3, 3, 2, 1))))) & 0x7;
+        const int dup_b = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(
+            vb, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(3, 3, 2, 1))))) & 0x7;
+        if(dup_a | dup_b) {
+            count = mystl::set_intersection_scalar(a, i, i + 4, b, j, j + 4, result, count);
+            continue;
+        }
+        __m256i eq = _mm256_cmpeq_epi64(va, vb);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+        if(result) {
+            for(; mask != 0; mask &= mask - 1)
+                result[count++] = a[i + mystl::ctz32(mask)];
+        }
+        else {
+            count += mystl::popcount32(mask);
+        }
+        const __m256i amax = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(a[i + 3])), bias);
+        const __m256i bmax = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(b[j + 3])), bias);
+        const unsigned a_gt = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(
+            _mm256_cmpgt_epi64(_mm256_xor_si256(va, bias), bmax))));
+        const unsigned b_gt = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(
+            _mm256_cmpgt_epi64(_mm256_xor_si256(vb, bias), amax))));
+        i += 4 - mystl::popcount32(a_gt);
+        j += 4 - mystl::popcount32(b_gt);
+    }
+    return mystl::set_intersection_scalar(a, i, na, b, j, nb, result, count);
+}
+#endif // MYSTL_SIMD_X86
+
+// 根据长度比例与 CPU 特性选择交集内核，返回交集元素个数
+template <class T>
+size_t simd_set_intersection(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    if(na == 0 || nb == 0)
+        return 0;
+    if(na * kSetGallopRatio < nb)
+        return mystl::set_intersection_gallop(a, na, b, nb, result);
+    if(nb * kSetGallopRatio < na)
+        return mystl::set_intersection_gallop(b, nb, a, na, result);
+#ifdef MYSTL_SIMD_X86
+    const int level = mystl::simd_level();
+    if constexpr(sizeof(T) == 4) {
+        if(level >= simd_avx2)
+            return mystl::set_intersection_avx2_32(a, na, b, nb, result);
+        if(level >= simd_sse42)
+            return mystl::set_intersection_sse42_32(a, na, b, nb, result);
+    }
+    else {
+        if(level >= simd_avx2)
+            return mystl::set_intersection_avx2_64(a, na, b, nb, result);
+        if(level >= simd_sse42)
+            return mystl::set_intersection_sse42_64(a, na, b, nb, result);
+    }
+#endif // MYSTL_SIMD_X86
+    size_t i = 0, j = 0;
+    return mystl::set_intersection_scalar(a, i, na, b, j, nb, result, 0);
+}
+
+// 无分支归并求并集，相邻的整块互不交叠时整块拷贝
+template <class T>
+T* simd_set_union(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    constexpr size_t block = 32 / sizeof(T);
+    size_t i = 0, j = 0;
+    while(i < na && j < nb) {
+        if(i + block <= na && a[i + block - 1] < b[j]) {
+            std::memcpy(result, a + i, block * sizeof(T));
+            result += block; i += block;
+            continue;
+        }
+        if(j + block <= nb && b[j + block - 1] < a[i]) {
+            std::memcpy(result, b + j, block * sizeof(T));
+            result += block; j += block;
+            continue;
+        }
+        // 一块之内交错的部分逐个无分支归并
+        const size_t end_i = i + block < na ? i + block : na;
+        const size_t end_j = j + block < nb ? j + block : nb;
+        while(i < end_i && j < end_j) {
+            const T x = a[i], y = b[j];
+            *result++ = y < x ? y : x;
+            i += (x <= y);
+            j += (y <= x);
+        }
+    }
+    return mystl::copy(b + j, b + nb, mystl::copy(a + i, a + na, result));
+}
+
+// 无分支归并求对称差，相邻的整块互不交叠时整块拷贝
+template <class T>
+T* simd_set_symmetric_difference(const T* a, size_t na, const T* b, size_t nb, T* result) {
+    constexpr size_t block = 32 / sizeof(T);
+    size_t i = 0, j = 0;
+    while(i < na && j < nb) {
+        if(i + block <= na && a[i + block - 1] < b[j]) {
+            std::memcpy(result, a + i, block * sizeof(T));
+            result += block; i += block;
+            continue;
+        }
+        if(j + block <= nb && b[j + block - 1] < a[i]) {
+            std::memcpy(result, b + j, block * sizeof(T));
+            result += block; j += block;
+            continue;
+        }
+        const size_t end_i = i + block < na ? i + block : na;
+        const size_t end_j = j + block < nb ? j + block : nb;
+        while(i < end_i && j < end_j) {
+            const T x = a[i], y = b[j];
+            if(x != y)
+                *result++ = y < x ? y : x;
+            i += (x <= y);
+            j += (y <= x);
+        }
+    }
+    return mystl::copy(b + j, b + nb, mystl::copy(a + i, a + na, result));
+}
+
 /*****************************************************************************************/
 // set_union
 // 计算 S1∪S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2, class OutputIter>
-OutputIter set_union(InputIter1 first1, InputIter1 last1,
+OutputIter unchecked_set_union(InputIter1 first1, InputIter1 last1,
     InputIter2 first2, InputIter2 last2, OutputIter result) {
     while(first1 != last1 && first2 != last2) {
         if(*first1 < *first2) {
-            *result = *firs1;
-            ++first1;
-        }
-        else if(*first1 = *first2) {
             *result = *first1;
-            ++first1; ++first2;
+            ++first1;
         }
-        else {
+        else if(*first2 < *first1) {
             *result = *first2;
             ++first2;
         }
+        else {
+            *result = *first1;
+            ++first1; ++first2;
+        }
         ++result;
     }
     // 处理剩余元素
-    mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+    return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
+// 为 4 / 8 字节整型的指针区间提供特化版本
+template <class Tp, class Up, class Vp>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Vp>::value &&
+    std::is_same<typename std::remove_const_t<Up>, Vp>::value &&
+    is_set_simd_type<Vp>::value, Vp*>
+    unchecked_set_union(Tp* first1, Tp* last1, Up* first2, Up* last2, Vp* result) {
+        return mystl::simd_set_union<Vp>(first1, static_cast<size_t>(last1 - first1),
+            first2, static_cast<size_t>(last2 - first2), result);
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_union(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, OutputIter result) {
+    return mystl::unchecked_set_union(first1, last1, first2, last2, result);
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
@@ -42,7 +395,7 @@ OutputIter set_union(InputIter1 first1, InputIter1 last1,
     InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp) {
     while(first1 != last1 && first2 != last2) {
         if(comp(*first1, *first2)) {
-            *result = *firs1;
+            *result = *first1;
             ++first1;
         }
         else if(comp(*first2, *first1)) {
@@ -56,7 +409,7 @@ OutputIter set_union(InputIter1 first1, InputIter1 last1,
         ++result;
     }
     // 处理剩余元素
-    mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+    return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
 }
 
 
@@ -65,7 +418,7 @@ OutputIter set_union(InputIter1 first1, InputIter1 last1,
 // 计算 S1∩S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2, class OutputIter>
-OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
+OutputIter unchecked_set_intersection(InputIter1 first1, InputIter1 last1,
     InputIter2 first2, InputIter2 last2, OutputIter result) {
     while(first1 != last1 && first2 != last2) {
         if(*first1 < *first2) {
@@ -75,14 +428,32 @@ OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
             ++first2;
         }
         else {
-            *result = *first2;
-            ++ first1; ++first2; 
+            *result = *first1;
+            ++first1; ++first2; 
             ++result;
         }
     }
     return result;
 }
 
+// 为 4 / 8 字节整型的指针区间提供特化版本
+template <class Tp, class Up, class Vp>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Vp>::value &&
+    std::is_same<typename std::remove_const_t<Up>, Vp>::value &&
+    is_set_simd_type<Vp>::value, Vp*>
+    unchecked_set_intersection(Tp* first1, Tp* last1, Up* first2, Up* last2, Vp* result) {
+        return result + mystl::simd_set_intersection<Vp>(first1, 
+            static_cast<size_t>(last1 - first1), first2, 
+            static_cast<size_t>(last2 - first2), result);
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, OutputIter result) {
+    return mystl::unchecked_set_intersection(first1, last1, first2, last2, result);
+}
+
 // compare重载
 template <class InputIter1, class InputIter2, class OutputIter, class Compare>
 OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
@@ -97,11 +468,73 @@ OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
         else {
             *result = *first1;
             ++first1; ++first2;
-            +=result;
+            ++result;
         }
     }
     return result;
 }
+
+
+/*****************************************************************************************/
+// set_intersection_count
+// 计算 |S1∩S2|，不输出任何元素
+/*****************************************************************************************/
+template <class InputIter1, class InputIter2>
+size_t unchecked_set_intersection_count(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2) {
+    size_t n = 0;
+    while(first1 != last1 && first2 != last2) {
+        if(*first1 < *first2) {
+            ++first1;
+        }
+        else if(*first2 < *first1) {
+            ++first2;
+        }
+        else {
+            ++first1; ++first2;
+            ++n;
+        }
+    }
+    return n;
+}
+
+// 为 4 / 8 字节整型的指针区间提供特化版本
+template <class Tp, class Up>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, typename std::remove_const_t<Up>>::value &&
+    is_set_simd_type<typename std::remove_const_t<Tp>>::value, size_t>
+    unchecked_set_intersection_count(Tp* first1, Tp* last1, Up* first2, Up* last2) {
+        typedef typename std::remove_const_t<Tp> value_type;
+        return mystl::simd_set_intersection<value_type>(first1, 
+            static_cast<size_t>(last1 - first1), first2,
+            static_cast<size_t>(last2 - first2), nullptr);
+}
+
+template <class InputIter1, class InputIter2>
+size_t set_intersection_count(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2) {
+    return mystl::unchecked_set_intersection_count(first1, last1, first2, last2);
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class InputIter1, class InputIter2, class Compare>
+size_t set_intersection_count(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, Compare comp) {
+    size_t n = 0;
+    while(first1 != last1 && first2 != last2) {
+        if(comp(*first1, *first2)) {
+            ++first1;
+        }
+        else if(comp(*first2, *first1)) {
+            ++first2;
+        }
+        else {
+            ++first1; ++first2;
+            ++n;
+        }
+    }
+    return n;
+}
     
 
 
@@ -118,13 +551,13 @@ OutputIter set_difference(InputIter1 first1, InputIter1 last1,
             ++first1; ++result;
         }
         else if(*first2 < *first1) {
-            ++first2
+            ++first2;
         }
         else {
             ++first1; ++first2;
         }
-        return mystl::copy(first1, frist2, result);
     }
+    return mystl::copy(first1, last1, result);
 }
 
 // compare 重载
@@ -137,13 +570,13 @@ OutputIter set_difference(InputIter1 first1, InputIter1 last1,
             ++first1; ++result;
         }
         else if(comp(*first2, *first1)) {
-            ++first2
+            ++first2;
         }
         else {
             ++first1; ++first2;
         }
-        return mystl::copy(first1, frist2, result);
     }
+    return mystl::copy(first1, last1, result);
 }
 
 
@@ -152,45 +585,480 @@ OutputIter set_difference(InputIter1 first1, InputIter1 last1,
 // 计算 (S1-S2)∪(S2-S1) 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2, class OutputIter>
-OutputIter set_symmetric_defference(InputIter1 first1, InputIter1 last1,
+OutputIter unchecked_set_symmetric_defference(InputIter1 first1, InputIter1 last1,
     InputIter2 first2, InputIter2 last2, OutputIter result) {
-    while(*first1 != *last1 && *first2 != *last2) {
+    while(first1 != last1 && first2 != last2) {
         if(*first1 < *first2) {
             *result = *first1;
             ++first1; ++result;
         }
-        if(*first2 < *frist1) {
+        else if(*first2 < *first1) {
             *result = *first2;
             ++first2; ++result;
         }
         else {
-            ++firs1; ++first2
+            ++first1; ++first2;
         }
     }
     return mystl::copy(first1, last1, mystl::copy(first2, last2, result));
 }
 
+// 为 4 / 8 字节整型的指针区间提供特化版本
+template <class Tp, class Up, class Vp>
+typename std::enable_if_t<
+    std::is_same<typename std::remove_const_t<Tp>, Vp>::value &&
+    std::is_same<typename std::remove_const_t<Up>, Vp>::value &&
+    is_set_simd_type<Vp>::value, Vp*>
+    unchecked_set_symmetric_defference(Tp* first1, Tp* last1, Up* first2, Up* last2, Vp* result) {
+        return mystl::simd_set_symmetric_difference<Vp>(first1, 
+            static_cast<size_t>(last1 - first1), first2,
+            static_cast<size_t>(last2 - first2), result);
+}
+
+template <class InputIter1, class InputIter2, class OutputIter>
+OutputIter set_symmetric_defference(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, OutputIter result) {
+    return mystl::unchecked_set_symmetric_defference(first1, last1, first2, last2, result);
+}
+
 // compare 重载
 template <class InputIter1, class InputIter2, class OutputIter, class Compare>
 OutputIter set_symmetric_defference(InputIter1 first1, InputIter1 last1,
     InputIter2 first2, InputIter2 last2, OutputIter result, Compare comp) {
-    while(*first1 != *last1 && *first2 != *last2) {
+    while(first1 != last1 && first2 != last2) {
         if(comp(*first1, *first2)) {
             *result = *first1;
             ++first1; ++result;
         }
-        if(comp(*first2, *frist1)) {
+        else if(comp(*first2, *first1)) {
             *result = *first2;
             ++first2; ++result;
         }
         else {
-            ++firs1; ++first2
+            ++first1; ++first2;
         }
     }
     return mystl::copy(first1, last1, mystl::copy(first2, last2, result));
 }
 
 
+/*****************************************************************************************/
+// multiway_set_union / multiway_set_intersection
+// 对多个有序区间求并集 / 交集，[first, last) 中每个元素是一个 mystl::pair<Iter, Iter>
+// Iter 至少为 forward iterator，交集要求随机访问迭代器
+// 重复元素的个数与两路版本一致: 并集取各区间中出现次数的最大值，交集取最小值
+/*****************************************************************************************/
+// 败者树，每次输出 k 路中最小的元素，比较次数为 log k
+// 相等元素按区间的下标顺序输出
+template <class Iter, class Compare>
+class loser_tree {
+private:
+    struct cursor {
+        Iter cur;
+        Iter last;
+    };
+
+    cursor* src_;      // 每一路当前的位置
+    size_t* tree_;     // tree_[0] 为胜者，tree_[1, k) 为各内部节点上的败者
+    size_t  k_;
+    Compare comp_;
+
+public:
+    template <class RangeIter>
+    loser_tree(RangeIter first, RangeIter last, Compare comp)
+        : src_(nullptr), tree_(nullptr), k_(0), comp_(comp) {
+        for(auto it = first; it != last; ++it)
+            ++k_;
+        if(k_ == 0)
+            return;
+        src_ = new cursor[k_];
+        size_t i = 0;
+        for(auto it = first; it != last; ++it, ++i) {
+            src_[i].cur = (*it).first;
+            src_[i].last = (*it).second;
+        }
+        tree_ = new size_t[k_];
+        size_t* winner = new size_t[2 * k_];
+        for(i = 0; i < k_; ++i)
+            winner[k_ + i] = i;
+        for(i = k_ - 1; i > 0; --i) {
+            const size_t a = winner[2 * i], b = winner[2 * i + 1];
+            if(beats(a, b)) {
+                winner[i] = a; tree_[i] = b;
+            }
+            else {
+                winner[i] = b; tree_[i] = a;
+            }
+        }
+        tree_[0] = k_ == 1 ? 0 : winner[1];
+        delete[] winner;
+    }
+
+    ~loser_tree() {
+        delete[] src_;
+        delete[] tree_;
+    }
+
+public:
+    bool   empty()      const { return k_ == 0 || src_[tree_[0]].cur == src_[tree_[0]].last; }
+    size_t top_source() const { return tree_[0]; }
+    Iter   top()        const { return src_[tree_[0]].cur; }
+
+    // 胜者前进一步，并从它的叶节点向上重赛
+    void pop() {
+        size_t w = tree_[0];
+        ++src_[w].cur;
+        for(size_t node = (k_ + w) / 2; node > 0; node /= 2) {
+            if(beats(tree_[node], w)) {
+                const size_t tmp = tree_[node];
+                tree_[node] = w;
+                w = tmp;
+            }
+        }
+        tree_[0] = w;
+    }
+
+private:
+    // 已耗尽的一路视为无穷大
+    bool beats(size_t a, size_t b) const {
+        if(src_[a].cur == src_[a].last)
+            return false;
+        if(src_[b].cur == src_[b].last)
+            return true;
+        if(comp_(*src_[a].cur, *src_[b].cur))
+            return true;
+        return !comp_(*src_[b].cur, *src_[a].cur) && a < b;
+    }
+
+    loser_tree(const loser_tree&);
+    void operator=(const loser_tree&);
+};
+
+// 用于默认比较的函数对象
+struct set_less {
+    template <class T, class U>
+    bool operator()(const T& lhs, const U& rhs) const { return lhs < rhs; }
+};
+
+template <class RangeIter, class OutputIter, class Compare>
+OutputIter multiway_set_union(RangeIter first, RangeIter last, OutputIter result, Compare comp) {
+    typedef decltype((*first).first) iter_type;
+    typedef typename std::remove_cv_t<typename std::remove_reference_t<iter_type>> Iter;
+    mystl::loser_tree<Iter, Compare> tree(first, last, comp);
+    while(!tree.empty()) {
+        // 相等的元素按区间下标连续弹出，统计每一路的个数并取最大值
+        const Iter value = tree.top();
+        size_t source = tree.top_source();
+        size_t run = 0, max_run = 0;
+        while(!tree.empty() && !comp(*value, *tree.top())) {
+            if(tree.top_source() != source) {
+                source = tree.top_source();
+                run = 0;
+            }
+            if(++run > max_run)
+                max_run = run;
+            tree.pop();
+        }
+        for(; max_run > 0; --max_run, ++result)
+            *result = *value;
+    }
+    return result;
+}
+
+template <class RangeIter, class OutputIter>
+OutputIter multiway_set_union(RangeIter first, RangeIter last, OutputIter result) {
+    return mystl::multiway_set_union(first, last, result, set_less());
+}
+
+// 在 [first, last) 中倍增查找第一个不小于 value 的位置，要求随机访问迭代器
+template <class RandomIter, class T, class Compare>
+RandomIter set_gallop(RandomIter first, RandomIter last, const T& value, Compare comp) {
+    typename iterator_traits<RandomIter>::difference_type step = 1, len = last - first;
+    typename iterator_traits<RandomIter>::difference_type lo = 0, hi = 0;
+    while(hi < len && comp(*(first + hi), value)) {
+        lo = hi + 1;
+        hi += step;
+        step <<= 1;
+    }
+    if(hi > len)
+        hi = len;
+    while(lo < hi) {
+        const auto mid = lo + (hi - lo) / 2;
+        if(comp(*(first + mid), value))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return first + lo;
+}
+
+// 从最短的区间中取候选元素，依长度递增的顺序在其余区间中倍增查找
+template <class RangeIter, class OutputIter, class Compare>
+OutputIter multiway_intersection_aux(RangeIter first, RangeIter last, OutputIter result,
+    Compare comp) {
+    typedef typename std::remove_cv_t<typename std::remove_reference_t<
+        decltype((*first).first)>> Iter;
+    struct cursor {
+        Iter cur;
+        Iter last;
+    };
+    size_t k = 0;
+    for(auto it = first; it != last; ++it)
+        ++k;
+    if(k == 0)
+        return result;
+    cursor* src = new cursor[k];
+    size_t i = 0;
+    for(auto it = first; it != last; ++it, ++i) {
+        src[i].cur = (*it).first;
+        src[i].last = (*it).second;
+    }
+    // 按长度插入排序，k 通常很小
+    for(i = 1; i < k; ++i) {
+        cursor tmp = src[i];
+        size_t j = i;
+        for(; j > 0 && (tmp.last - tmp.cur) < (src[j - 1].last - src[j - 1].cur); --j)
+            src[j] = src[j - 1];
+        src[j] = tmp;
+    }
+    cursor& s = src[0];
+    while(s.cur != s.last) {
+        // 候选元素在最短区间中的重复个数
+        Iter run_end = s.cur + 1;
+        while(run_end != s.last && !comp(*s.cur, *run_end))
+            ++run_end;
+        size_t c = static_cast<size_t>(run_end - s.cur);
+        bool matched = true;
+        for(i = 1; i < k && c > 0; ++i) {
+            src[i].cur = mystl::set_gallop(src[i].cur, src[i].last, *s.cur, comp);
+            if(src[i].cur == src[i].last) {
+                delete[] src;
+                return result;
+            }
+            if(comp(*s.cur, *src[i].cur)) {
+                // 最短区间跳到该区间的下一个元素处
+                s.cur = mystl::set_gallop(run_end, s.last, *src[i].cur, comp);
+                matched = false;
+                break;
+            }
+            size_t m = 0;
+            for(Iter it = src[i].cur; m < c && it != src[i].last && !comp(*s.cur, *it); ++it)
+                ++m;
+            c = m;
+        }
+        if(matched) {
+            for(Iter it = s.cur; c > 0; --c, ++it, ++result)
+                *result = *it;
+            s.cur = run_end;
+        }
+    }
+    delete[] src;
+    return result;
+}
+
+// 4 / 8 字节整型的指针区间: 从最短的两个区间开始两两求交 (SvS)，每一步都使用 SIMD 内核
+template <class RangeIter, class T>
+T* multiway_intersection_svs(RangeIter first, RangeIter last, T* result) {
+    size_t k = 0;
+    for(auto it = first; it != last; ++it)
+        ++k;
+    if(k == 0)
+        return result;
+    const T** lo = new const T*[k];
+    const T** hi = new const T*[k];
+    size_t i = 0;
+    for(auto it = first; it != last; ++it, ++i) {
+        lo[i] = (*it).first;
+        hi[i] = (*it).second;
+    }
+    for(i = 1; i < k; ++i) {
+        const T* l = lo[i];
+        const T* h = hi[i];
+        size_t j = i;
+        for(; j > 0 && (h - l) < (hi[j - 1] - lo[j - 1]); --j) {
+            lo[j] = lo[j - 1];
+            hi[j] = hi[j - 1];
+        }
+        lo[j] = l;
+        hi[j] = h;
+    }
+    T* out = result;
+    if(k == 1) {
+        out = mystl::copy(lo[0], hi[0], result);
+    }
+    else {
+        const size_t n = static_cast<size_t>(hi[0] - lo[0]);
+        auto buf = mystl::get_temporary_buffer<T>(static_cast<ptrdiff_t>(n));
+        if(n != 0 && static_cast<size_t>(buf.second) < n) {
+            mystl::release_temporary_buffer(buf.first);
+            struct range { const T* first; const T* second; };
+            range* ranges = new range[k];
+            for(i = 0; i < k; ++i) {
+                ranges[i].first = lo[i];
+                ranges[i].second = hi[i];
+            }
+            out = mystl::multiway_intersection_aux(ranges, ranges + k, result, set_less());
+            delete[] ranges;
+        }
+        else {
+            // 中间结果原地与下一个区间求交，输出位置不会超过读取位置
+            size_t cnt = mystl::simd_set_intersection<T>(lo[0], n, lo[1],
+                static_cast<size_t>(hi[1] - lo[1]), buf.first);
+            for(i = 2; i < k && cnt != 0; ++i)
+                cnt = mystl::simd_set_intersection<T>(buf.first, cnt, lo[i],
+                    static_cast<size_t>(hi[i] - lo[i]), buf.first);
+            out = mystl::copy(buf.first, buf.first + cnt, result);
+            mystl::release_temporary_buffer(buf.first);
+        }
+    }
+    delete[] lo;
+    delete[] hi;
+    return out;
+}
+
+template <class RangeIter, class OutputIter>
+OutputIter multiway_intersection_dispatch(RangeIter first, RangeIter last,
+    OutputIter result, std::false_type) {
+    return mystl::multiway_intersection_aux(first, last, result, set_less());
+}
+
+template <class RangeIter, class OutputIter>
+OutputIter multiway_intersection_dispatch(RangeIter first, RangeIter last,
+    OutputIter result, std::true_type) {
+    return mystl::multiway_intersection_svs(first, last, result);
+}
+
+template <class RangeIter, class OutputIter>
+OutputIter multiway_set_intersection(RangeIter first, RangeIter last, OutputIter result) {
+    typedef typename std::remove_cv_t<typename std::remove_reference_t<
+        decltype((*first).first)>> Iter;
+    typedef typename iterator_traits<Iter>::value_type value_type;
+    return mystl::multiway_intersection_dispatch(first, last, result,
+        std::integral_constant<bool, std::is_pointer<Iter>::value &&
+        std::is_same<OutputIter, value_type*>::value &&
+        is_set_simd_type<value_type>::value>());
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class RangeIter, class OutputIter, class Compare>
+OutputIter multiway_set_intersection(RangeIter first, RangeIter last, 
+    OutputIter result, Compare comp) {
+    return mystl::multiway_intersection_aux(first, last, result, comp);
+}
+
+
+/*****************************************************************************************/
+// parallel_set_union / parallel_set_intersection
+// 按值域把两个区间切分为若干段，各段由不同线程处理，要求随机访问迭代器
+// 先并行计算各段输出的个数，再按前缀和得到的偏移并行写入 result
+/*****************************************************************************************/
+constexpr static size_t kParallelSetGrain = 1 << 16;    // 每个线程至少处理的元素个数
+
+// 切分点取自较长区间的等距位置，并在两个区间中取 lower_bound，保证相等的元素落在同一段
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compare,
+    class CountOp, class WriteOp>
+RandomIter3 parallel_set_op_aux(RandomIter1 first1, RandomIter1 last1,
+    RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compare comp,
+    CountOp count_op, WriteOp write_op) {
+    const size_t n1 = static_cast<size_t>(last1 - first1);
+    const size_t n2 = static_cast<size_t>(last2 - first2);
+    size_t parts = (n1 + n2) / kParallelSetGrain;
+    if(parts > mystl::hardware_threads())
+        parts = mystl::hardware_threads();
+    if(parts < 2)
+        return write_op(first1, last1, first2, last2, result);
+
+    RandomIter1* cut1 = new RandomIter1[parts + 1];
+    RandomIter2* cut2 = new RandomIter2[parts + 1];
+    size_t* offset = new size_t[parts + 1];
+    cut1[0] = first1; cut2[0] = first2;
+    cut1[parts] = last1; cut2[parts] = last2;
+    for(size_t p = 1; p < parts; ++p) {
+        if(n1 >= n2) {
+            const auto& value = *(first1 + n1 * p / parts);
+            cut1[p] = mystl::set_gallop(cut1[p - 1], last1, value, comp);
+            cut2[p] = mystl::set_gallop(cut2[p - 1], last2, value, comp);
+        }
+        else {
+            const auto& value = *(first2 + n2 * p / parts);
+            cut1[p] = mystl::set_gallop(cut1[p - 1], last1, value, comp);
+            cut2[p] = mystl::set_gallop(cut2[p - 1], last2, value, comp);
+        }
+    }
+    try {
+        mystl::parallel_invoke_n(parts, [&](size_t p) {
+            offset[p + 1] = count_op(cut1[p], cut1[p + 1], cut2[p], cut2[p + 1]);
+        });
+        offset[0] = 0;
+        for(size_t p = 0; p < parts; ++p)
+            offset[p + 1] += offset[p];
+        mystl::parallel_invoke_n(parts, [&](size_t p) {
+            write_op(cut1[p], cut1[p + 1], cut2[p], cut2[p + 1], result + offset[p]);
+        });
+    }
+    catch(...) {
+        delete[] cut1; delete[] cut2; delete[] offset;
+        throw;
+    }
+    RandomIter3 out = result + offset[parts];
+    delete[] cut1; delete[] cut2; delete[] offset;
+    return out;
+}
+
+template <class RandomIter1, class RandomIter2, class RandomIter3>
+RandomIter3 parallel_set_intersection(RandomIter1 first1, RandomIter1 last1,
+    RandomIter2 first2, RandomIter2 last2, RandomIter3 result) {
+    return mystl::parallel_set_op_aux(first1, last1, first2, last2, result, set_less(),
+        [](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2) {
+            return mystl::set_intersection_count(f1, l1, f2, l2);
+        },
+        [](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2, RandomIter3 out) {
+            return mystl::set_intersection(f1, l1, f2, l2, out);
+        });
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compare>
+RandomIter3 parallel_set_intersection(RandomIter1 first1, RandomIter1 last1,
+    RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compare comp) {
+    return mystl::parallel_set_op_aux(first1, last1, first2, last2, result, comp,
+        [comp](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2) {
+            return mystl::set_intersection_count(f1, l1, f2, l2, comp);
+        },
+        [comp](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2, RandomIter3 out) {
+            return mystl::set_intersection(f1, l1, f2, l2, out, comp);
+        });
+}
+
+// 并集的个数为 |S1| + |S2| - |S1∩S2|
+template <class RandomIter1, class RandomIter2, class RandomIter3>
+RandomIter3 parallel_set_union(RandomIter1 first1, RandomIter1 last1,
+    RandomIter2 first2, RandomIter2 last2, RandomIter3 result) {
+    return mystl::parallel_set_op_aux(first1, last1, first2, last2, result, set_less(),
+        [](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2) {
+            return static_cast<size_t>((l1 - f1) + (l2 - f2)) - 
+                mystl::set_intersection_count(f1, l1, f2, l2);
+        },
+        [](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2, RandomIter3 out) {
+            return mystl::set_union(f1, l1, f2, l2, out);
+        });
+}
+
+// 重载版本使用函数对象 comp 代替比较操作
+template <class RandomIter1, class RandomIter2, class RandomIter3, class Compare>
+RandomIter3 parallel_set_union(RandomIter1 first1, RandomIter1 last1,
+    RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compare comp) {
+    return mystl::parallel_set_op_aux(first1, last1, first2, last2, result, comp,
+        [comp](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2) {
+            return static_cast<size_t>((l1 - f1) + (l2 - f2)) - 
+                mystl::set_intersection_count(f1, l1, f2, l2, comp);
+        },
+        [comp](RandomIter1 f1, RandomIter1 l1, RandomIter2 f2, RandomIter2 l2, RandomIter3 out) {
+            return mystl::set_union(f1, l1, f2, l2, out, comp);
+        });
+}
+
+
 } // namespace mystl
 
 #endif // MYSTL_SET_ALGO_H_
\ No newline at end of file
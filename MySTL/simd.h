@@ -0,0 +1,269 @@
+#ifndef MYSTL_SIMD_H_
+#define MYSTL_SIMD_H_
+
+// 这个头文件包含 SIMD 相关的编译开关、运行时 CPU 特性检测以及一些位运算辅助函数
+// 各算法的连续区间快速路径通过 simd_level() 在运行时选择内核
+// 定义 MYSTL_NO_SIMD 可以关闭所有向量化路径
+
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(MYSTL_NO_SIMD) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define MYSTL_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MYSTL_LITTLE_ENDIAN: 小端序平台
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_MSC_VER)
+#define MYSTL_LITTLE_ENDIAN 1
+#endif
+
+// MYSTL_TARGET_xxx: 为单个函数开启对应指令集，未开启全局编译选项时也能生成该指令集的代码
+// MSVC 不需要额外属性即可使用所有内建函数
+#if defined(MYSTL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MYSTL_TARGET_SSE42  __attribute__((target("sse4.2,popcnt")))
+#define MYSTL_TARGET_AVX2   __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#define MYSTL_TARGET_FMA    __attribute__((target("avx2,fma,bmi,bmi2,popcnt")))
+#define MYSTL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,bmi,bmi2,popcnt")))
+#else
+#define MYSTL_TARGET_SSE42
+#define MYSTL_TARGET_AVX2
+#define MYSTL_TARGET_FMA
+#define MYSTL_TARGET_AVX512
+#endif
+
+namespace mystl {
+
+/*****************************************************************************************/
+// simd_level
+// 检测当前 CPU 支持的最高指令集等级，结果只计算一次
+/*****************************************************************************************/
+enum simd_level_t {
+    simd_none   = 0,
+    simd_sse42  = 1,
+    simd_avx2   = 2,
+    simd_avx512 = 3
+};
+
+inline int detect_simd_level() noexcept {
+#if defined(MYSTL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+       __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq"))
+        return simd_avx512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2"))
+        return simd_avx2;
+    if(__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+        return simd_sse42;
+    return simd_none;
+#elif defined(MYSTL_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse42 = (info[2] & (1 << 20)) != 0 && (info[2] & (1 << 23)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if(!sse42)
+        return simd_none;
+    if(!osxsave || max_leaf < 7)
+        return simd_sse42;
+    // 操作系统需要保存 YMM / ZMM 寄存器状态
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0 && (info[1] & (1 << 8)) != 0 && (xcr0 & 0x6) == 0x6;
+    const bool avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 17)) != 0 &&
+                        (info[1] & (1 << 30)) != 0 && (info[1] & (1u << 31)) != 0 &&
+                        (xcr0 & 0xe6) == 0xe6;
+    if(avx2 && avx512)
+        return simd_avx512;
+    return avx2 ? simd_avx2 : simd_sse42;
+#else
+    return simd_none;
+#endif
+}
+
+inline int simd_level() noexcept {
+    static const int level = detect_simd_level();
+    return level;
+}
+
+/*****************************************************************************************/
+// simd_has_fma
+// 检测 CPU 是否支持 FMA3 融合乘加，使用乘加的 AVX2 内核在 simd_level() 之外还需检查这一项
+/*****************************************************************************************/
+inline bool detect_simd_fma() noexcept {
+#if defined(MYSTL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma");
+#elif defined(MYSTL_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 12)) != 0;
+#else
+    return false;
+#endif
+}
+
+inline bool simd_has_fma() noexcept {
+    static const bool fma = detect_simd_fma();
+    return fma;
+}
+
+/*****************************************************************************************/
+// 非临时存储
+// 一次写入的字节数超过 kNonTemporalBytes 时，数据大致已超出末级缓存，写回的内容短期内不会再被读取，
+// 使用 stream 指令绕过缓存，避免读入目标缓存行 (read for ownership) 并挤出其它数据
+// stream 存储是弱序的，写完后需要 sfence 才能被其它线程按顺序观察到
+/*****************************************************************************************/
+constexpr static size_t kNonTemporalBytes = size_t(1) << 23;
+
+/*****************************************************************************************/
+// prefetch_read
+// 提示 CPU 把 p 所在的缓存行读入缓存，不会引发访存错误，不支持时什么也不做
+// 用于下一步的访问地址取决于本步比较结果的场合 (如堆的下溯)，提前发出候选地址的访存
+/*****************************************************************************************/
+inline void prefetch_read(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#elif defined(MYSTL_SIMD_X86)
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+    (void)p;
+#endif
+}
+
+/*****************************************************************************************/
+// 位运算辅助函数
+// ctz / clz: 末尾 / 开头 0 的个数，参数不能为 0
+// popcount: 二进制中 1 的个数
+// byte_swap: 字节序翻转
+/*****************************************************************************************/
+inline unsigned ctz32(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(x));
+#elif defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, x);
+    return static_cast<unsigned>(idx);
+#else
+    unsigned n = 0;
+    for(; (x & 1u) == 0; x >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+inline unsigned ctz64(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return static_cast<unsigned>(idx);
+#else
+    const uint32_t lo = static_cast<uint32_t>(x);
+    return lo != 0 ? ctz32(lo) : 32 + ctz32(static_cast<uint32_t>(x >> 32));
+#endif
+}
+
+inline unsigned clz32(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_clz(x));
+#elif defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanReverse(&idx, x);
+    return 31u - static_cast<unsigned>(idx);
+#else
+    unsigned n = 0;
+    for(; (x & 0x80000000u) == 0; x <<= 1)
+        ++n;
+    return n;
+#endif
+}
+
+inline unsigned popcount32(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcount(x));
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return static_cast<unsigned>((((x + (x >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24);
+#endif
+}
+
+inline unsigned popcount64(uint64_t x) noexcept {
+    return popcount32(static_cast<uint32_t>(x)) + popcount32(static_cast<uint32_t>(x >> 32));
+}
+
+inline uint16_t byte_swap(uint16_t x) noexcept {
+    return static_cast<uint16_t>((x >> 8) | (x << 8));
+}
+
+inline uint32_t byte_swap(uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(x);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(x);
+#else
+    return (x >> 24) | ((x >> 8) & 0xff00u) | ((x << 8) & 0xff0000u) | (x << 24);
+#endif
+}
+
+inline uint64_t byte_swap(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(x);
+#else
+    return (static_cast<uint64_t>(byte_swap(static_cast<uint32_t>(x))) << 32) |
+           byte_swap(static_cast<uint32_t>(x >> 32));
+#endif
+}
+
+#ifdef MYSTL_SIMD_X86
+/*****************************************************************************************/
+// compress_epi32
+// AVX2 没有压缩存储指令，用 permutevar8x32 代替: 把 mask 中被选中的 32 位通道按顺序移到低位
+// 表项的每个字节是一个被选中的通道下标，64 位元素传入成对的掩码位即可
+/*****************************************************************************************/
+struct compress_table_t {
+    uint64_t idx[256];
+    constexpr compress_table_t() : idx() {
+        for(unsigned m = 0; m < 256; ++m) {
+            uint64_t v = 0;
+            unsigned k = 0;
+            for(unsigned l = 0; l < 8; ++l) {
+                if(m & (1u << l))
+                    v |= static_cast<uint64_t>(l) << (8 * k++);
+            }
+            idx[m] = v;
+        }
+    }
+};
+
+inline const uint64_t* compress_table() noexcept {
+    static constexpr compress_table_t table{};
+    return table.idx;
+}
+
+MYSTL_TARGET_AVX2
+inline __m256i compress_epi32(__m256i v, unsigned mask) noexcept {
+    const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(compress_table() + mask));
+    return _mm256_permutevar8x32_epi32(v, _mm256_cvtepu8_epi32(bytes));
+}
+
+// 前 k 个 32 位通道为全 1 的掩码，用于 maskstore
+MYSTL_TARGET_AVX2
+inline __m256i prefix_mask_epi32(unsigned k) noexcept {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(k)),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+#endif // MYSTL_SIMD_X86
+
+} // namespace mystl
+
+#endif // MYSTL_SIMD_H_
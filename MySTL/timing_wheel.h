@@ -0,0 +1,459 @@
+#ifndef MYSTL_TIMING_WHEEL_H_
+#define MYSTL_TIMING_WHEEL_H_
+
+// 这个头文件包含一个模板类 timing_wheel
+// timing_wheel : 分层时间轮，O(1) 的定时器插入与取消，按时刻批量触发到期的定时器
+
+#include <cstddef>
+#include <cstdint>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl {
+
+/*****************************************************************************************/
+// timing_wheel
+// 模板参数 T 为定时器携带的数据，时刻以无符号整数的 tick 表示，单位由使用者决定
+//
+// 共 kLevels 层，每层 64 个槽，第 l 层的一个槽覆盖 64^l 个 tick，六层共覆盖 2^36 个 tick，更远的定时器
+// 放入溢出桶，并记录溢出桶中最早的到期时刻，时间直接跳到它所在的 2^36 区间再下移，中间的区间不需要处理。
+// 到期时刻为 kNever 的定时器永不触发，单独存放，不参与下移与 next_event。到期时刻 e 与当前时刻 now 的最高不同位决定所在的层，槽号为 e 在该层的六位数字，
+// 因此同一层中的定时器都不在 now 的数字之前。当前时刻进入某个槽的范围时，该槽中的定时器按新的时刻
+// 重新放入更低的层 (cascade)，最终在第 0 层到期，每个定时器最多被移动 kLevels 次
+//
+// 每层用一个 64 位的位图记录非空的槽，advance 用 ctz 直接跳到下一个有定时器的槽，
+// 空闲的时间段不需要逐个 tick 处理
+// 节点放在按块分配的节点池中，块不会移动，空闲节点组成链表复用。每个槽是一个存放节点下标的数组，
+// 节点记录自己在数组中的位置: 插入是在数组末尾追加，取消是用末尾元素填补空位，都是 O(1)。
+// 与链表相比，插入不需要访问其它节点，下移与触发时顺序扫描数组并预取后面的节点，
+// 定时器很多、节点散落在内存中时访存可以并行，不会逐个等待缓存未命中
+// 句柄包含节点下标与代数，节点回收后旧句柄失效，cancel 返回 false
+/*****************************************************************************************/
+template <class T>
+class timing_wheel {
+public:
+    typedef T           value_type;
+    typedef uint64_t    tick_type;
+    typedef uint64_t    handle_type;
+    typedef size_t      size_type;
+
+    static constexpr tick_type kNever = ~static_cast<tick_type>(0);
+
+private:
+    static constexpr unsigned  kSlotBits  = 6;
+    static constexpr uint32_t  kSlots     = 1u << kSlotBits;
+    static constexpr unsigned  kLevels    = 6;
+    static constexpr unsigned  kWheelBits = kSlotBits * kLevels;
+    static constexpr uint32_t  kOverflow  = kLevels * kSlots;      // 溢出桶
+    static constexpr uint32_t  kParked    = kOverflow + 1;         // 到期时刻为 kNever 的定时器
+    static constexpr uint32_t  kExpiring  = kParked + 1;           // 正在触发的定时器
+    static constexpr uint32_t  kBuckets   = kExpiring + 1;
+    static constexpr uint32_t  kFreeList  = kBuckets;              // node.list: 空闲节点
+    static constexpr uint32_t  kNil       = ~static_cast<uint32_t>(0);
+    static constexpr unsigned  kBlockBits = 10;                    // 每块 1024 个节点
+    static constexpr uint32_t  kPrefetch  = 8;                     // 扫描桶时预取的距离
+
+    struct bucket {
+        uint32_t* data;
+        uint32_t  size;
+        uint32_t  cap;
+    };
+
+    struct node {
+        uint32_t  list;     // 所在桶的编号，空闲节点为 kFreeList
+        uint32_t  pos;      // 在桶中的位置，空闲节点为下一个空闲节点
+        uint32_t  gen;      // 代数，节点每次回收时加一
+        tick_type expiry;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T& value() noexcept { return *reinterpret_cast<T*>(storage); }
+    };
+
+    typedef mystl::allocator<node>      node_allocator;
+    typedef mystl::allocator<node*>     block_allocator;
+    typedef mystl::allocator<uint32_t>  index_allocator;
+
+    bucket      buckets_[kBuckets];     // 各层的槽、溢出桶与正在触发的定时器
+    uint64_t    occupied_[kLevels];     // 各层非空槽的位图
+    node**      blocks_;
+    size_type   block_count_;
+    size_type   block_cap_;
+    uint32_t    nodes_;                 // 已分配过的节点数
+    uint32_t    free_;                  // 空闲链表的表头
+    size_type   size_;                  // 等待中的定时器个数
+    tick_type   now_;                   // 下一个要处理的时刻
+    tick_type   overflow_min_;          // 溢出桶中最早的到期时刻，取消定时器后可能偏早，溢出桶为空时为 kNever
+
+public:
+    // 构造、析构函数，当前时刻从 now 开始
+    explicit timing_wheel(tick_type now = 0)
+        : blocks_(nullptr), block_count_(0), block_cap_(0), nodes_(0), free_(kNil),
+          size_(0), now_(now), overflow_min_(kNever) {
+        for(uint32_t b = 0; b < kBuckets; ++b) {
+            buckets_[b].data = nullptr;
+            buckets_[b].size = buckets_[b].cap = 0;
+        }
+        for(unsigned l = 0; l < kLevels; ++l)
+            occupied_[l] = 0;
+    }
+
+    timing_wheel(const timing_wheel&) = delete;
+    timing_wheel& operator=(const timing_wheel&) = delete;
+
+    ~timing_wheel() {
+        clear();
+        for(uint32_t b = 0; b < kBuckets; ++b)
+            index_allocator::deallocate(buckets_[b].data, buckets_[b].cap);
+        for(size_type b = 0; b < block_count_; ++b)
+            node_allocator::deallocate(blocks_[b], size_type(1) << kBlockBits);
+        block_allocator::deallocate(blocks_, block_cap_);
+    }
+
+public:
+    bool      empty() const noexcept { return size_ == 0; }
+    size_type size()  const noexcept { return size_; }
+
+    // 下一个要处理的时刻，到期时刻早于它的定时器在下一次 advance 时触发
+    tick_type now()   const noexcept { return now_; }
+
+    // 句柄对应的定时器是否仍在等待
+    bool contains(handle_type h) const noexcept {
+        const uint32_t i = static_cast<uint32_t>(h);
+        return i < nodes_ && node_at(i).gen == static_cast<uint32_t>(h >> 32) &&
+               node_at(i).list != kFreeList;
+    }
+
+    // 在 expiry 时刻触发的定时器，返回句柄
+    handle_type schedule(tick_type expiry, const value_type& value) { return emplace(expiry, value); }
+    handle_type schedule(tick_type expiry, value_type&& value) { return emplace(expiry, mystl::move(value)); }
+
+    template <class... Args>
+    handle_type emplace(tick_type expiry, Args&&... args) {
+        const uint32_t i = acquire_node();
+        node& n = node_at(i);
+        try {
+            mystl::construct(&n.value(), mystl::forward<Args>(args)...);
+        }
+        catch(...) {
+            release_node(i);
+            throw;
+        }
+        n.expiry = expiry;
+        try {
+            push_back(target(i), i);
+        }
+        catch(...) {
+            mystl::destory_one(&n.value());
+            release_node(i);
+            throw;
+        }
+        ++size_;
+        return (static_cast<handle_type>(n.gen) << 32) | i;
+    }
+
+    // 取消等待中的定时器，已经触发、取消或失效的句柄返回 false
+    // 在 advance 的回调中也可以取消同一批中尚未触发的定时器
+    bool cancel(handle_type h) {
+        if(!contains(h))
+            return false;
+        const uint32_t i = static_cast<uint32_t>(h);
+        remove(i);
+        mystl::destory_one(&node_at(i).value());
+        release_node(i);
+        --size_;
+        return true;
+    }
+
+    // 触发所有到期时刻不晚于 t 的定时器，按到期时刻的顺序对每个定时器的数据调用 f(value)
+    // 同一时刻的定时器整批从槽中取下后依次触发，f 中可以 schedule 或 cancel 其它定时器，但不能调用 advance
+    // 到期时刻早于 now() 的定时器按 now() 处理，仍不晚于 t 时在本次 advance 中稍后触发
+    // 时刻在 kNever 处饱和: advance(kNever) 触发其余所有定时器后 now() 停在 kNever，
+    // 到期时刻为 kNever 的定时器永不触发
+    // 返回触发的定时器个数
+    template <class Function>
+    size_type advance(tick_type t, Function f) {
+        size_type fired = 0;
+        for(tick_type e = next_event(); e != kNever && e <= t; e = next_event())
+            fired += process(e, f);
+        if(t >= now_)
+            now_ = t == kNever ? kNever : t + 1;
+        return fired;
+    }
+
+    // 下一个需要处理的时刻，可能是第 0 层的到期时刻，也可能只是把高层的槽下移的时刻，没有定时器时返回 kNever
+    // 事件循环可以据此决定休眠的时长
+    tick_type next_event() const noexcept {
+        // now_ 恰好是某层一个槽的起点时，该层当前槽可能还没有下移，此时下一个事件就是 now_；
+        // 否则当前槽已经处理过，总是为空。低层的其它槽总是早于高层的其它槽，
+        // 但 now_ 同时是高层槽的起点时还要继续检查高层的当前槽
+        tick_type best = kNever;
+        for(unsigned l = 0; l < kLevels; ++l) {
+            const unsigned shift = kSlotBits * l;
+            const unsigned digit = static_cast<unsigned>(now_ >> shift) & (kSlots - 1);
+            const bool boundary = (now_ & ((tick_type(1) << shift) - 1)) == 0;
+            if(!boundary && best != kNever)
+                return best;
+            if(boundary && ((occupied_[l] >> digit) & 1) != 0)
+                return now_;
+            if(best == kNever && digit + 1 < kSlots) {
+                const uint64_t mask = occupied_[l] & (~uint64_t(0) << (digit + 1));
+                if(mask != 0) {
+                    const tick_type base = (now_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+                    best = base | (static_cast<tick_type>(mystl::ctz64(mask)) << shift);
+                }
+            }
+        }
+        // 溢出桶中的定时器都在更晚的区间，轮中的定时器总是先处理；
+        // 轮为空时直接跳到最早的溢出定时器所在区间的起点
+        if(buckets_[kOverflow].size != 0) {
+            const tick_type window = overflow_min_ >> kWheelBits;
+            if(window <= (now_ >> kWheelBits))
+                return now_;
+            if(best == kNever)
+                return window << kWheelBits;
+        }
+        return best;
+    }
+
+    // 销毁所有等待中的定时器，不触发
+    void clear() noexcept {
+        for(uint32_t b = 0; b < kBuckets; ++b) {
+            bucket& bk = buckets_[b];
+            for(uint32_t k = 0; k < bk.size; ++k) {
+                const uint32_t i = bk.data[k];
+                if(i == kNil)
+                    continue;
+                mystl::destory_one(&node_at(i).value());
+                release_node(i);
+            }
+            bk.size = 0;
+        }
+        for(unsigned l = 0; l < kLevels; ++l)
+            occupied_[l] = 0;
+        size_ = 0;
+        overflow_min_ = kNever;
+    }
+
+private:
+    // helper functions
+
+    node& node_at(uint32_t i) noexcept {
+        return blocks_[i >> kBlockBits][i & ((1u << kBlockBits) - 1)];
+    }
+    const node& node_at(uint32_t i) const noexcept {
+        return blocks_[i >> kBlockBits][i & ((1u << kBlockBits) - 1)];
+    }
+
+    uint32_t acquire_node() {
+        if(free_ != kNil) {
+            const uint32_t i = free_;
+            free_ = node_at(i).pos;
+            return i;
+        }
+        THROW_LENGTH_ERROR_IF(nodes_ >= kNil - 1, "timing_wheel<T>'s size too big");
+        if((nodes_ >> kBlockBits) == block_count_)
+            add_block();
+        const uint32_t i = nodes_++;
+        node_at(i).gen = 1;
+        node_at(i).list = kFreeList;
+        return i;
+    }
+
+    void release_node(uint32_t i) noexcept {
+        node& n = node_at(i);
+        ++n.gen;
+        n.list = kFreeList;
+        n.pos = free_;
+        free_ = i;
+    }
+
+    void add_block() {
+        if(block_count_ == block_cap_) {
+            const size_type cap = block_cap_ == 0 ? 16 : block_cap_ * 2;
+            node** blocks = block_allocator::allocate(cap);
+            for(size_type b = 0; b < block_count_; ++b)
+                blocks[b] = blocks_[b];
+            block_allocator::deallocate(blocks_, block_cap_);
+            blocks_ = blocks;
+            block_cap_ = cap;
+        }
+        blocks_[block_count_] = node_allocator::allocate(size_type(1) << kBlockBits);
+        ++block_count_;
+    }
+
+    void grow(bucket& bk) {
+        const uint32_t cap = bk.cap == 0 ? 8 : bk.cap * 2;
+        uint32_t* data = index_allocator::allocate(cap);
+        for(uint32_t k = 0; k < bk.size; ++k)
+            data[k] = bk.data[k];
+        index_allocator::deallocate(bk.data, bk.cap);
+        bk.data = data;
+        bk.cap = cap;
+    }
+
+    // 追加到桶的末尾，扩容失败时节点保持原状
+    void push_back(uint32_t list, uint32_t i) {
+        bucket& bk = buckets_[list];
+        if(bk.size == bk.cap)
+            grow(bk);
+        node& n = node_at(i);
+        n.list = list;
+        n.pos = bk.size;
+        bk.data[bk.size++] = i;
+        if(list < kOverflow)
+            occupied_[list / kSlots] |= uint64_t(1) << (list % kSlots);
+        else if(list == kOverflow && n.expiry < overflow_min_)
+            overflow_min_ = n.expiry;
+    }
+
+    // 从所在的桶中摘除，用末尾元素填补空位；正在触发的桶不能移动元素，只留下 kNil
+    void remove(uint32_t i) noexcept {
+        const node& n = node_at(i);
+        bucket& bk = buckets_[n.list];
+        if(n.list == kExpiring) {
+            bk.data[n.pos] = kNil;
+            return;
+        }
+        const uint32_t last = bk.data[--bk.size];
+        bk.data[n.pos] = last;
+        node_at(last).pos = n.pos;
+        if(bk.size == 0 && n.list < kOverflow)
+            occupied_[n.list / kSlots] &= ~(uint64_t(1) << (n.list % kSlots));
+        else if(bk.size == 0 && n.list == kOverflow)
+            overflow_min_ = kNever;
+    }
+
+    // 按到期时刻与当前时刻的最高不同位选择层与槽，早于当前时刻的定时器放入当前槽
+    uint32_t target(uint32_t i) noexcept {
+        node& n = node_at(i);
+        if(n.expiry < now_)
+            n.expiry = now_;
+        if(n.expiry == kNever)
+            return kParked;
+        const tick_type diff = n.expiry ^ now_;
+        unsigned level = 0;
+        if(diff >= kSlots) {
+            const uint32_t high = static_cast<uint32_t>(diff >> 32);
+            const unsigned bit = high != 0 ? 63 - mystl::clz32(high)
+                                           : 31 - mystl::clz32(static_cast<uint32_t>(diff));
+            level = bit / kSlotBits;
+        }
+        if(level >= kLevels)
+            return kOverflow;
+        return level * kSlots + (static_cast<uint32_t>(n.expiry >> (kSlotBits * level)) & (kSlots - 1));
+    }
+
+    // 按当前时刻重新放置桶 list 中的节点，仍属于该桶的 (只有溢出桶会出现) 在原地压紧
+    // 扩容失败时未处理的节点留在原桶中
+    void cascade(uint32_t list) {
+        bucket& bk = buckets_[list];
+        uint32_t keep = 0;
+        uint32_t k = 0;
+        if(list == kOverflow)
+            overflow_min_ = kNever;
+        try {
+            for(; k < bk.size; ++k) {
+                if(k + kPrefetch < bk.size && bk.data[k + kPrefetch] != kNil)
+                    mystl::prefetch_read(&node_at(bk.data[k + kPrefetch]));
+                const uint32_t i = bk.data[k];
+                if(i == kNil)
+                    continue;
+                const uint32_t to = target(i);
+                if(to == list) {
+                    keep_in_place(bk, keep, i);
+                    ++keep;
+                }
+                else {
+                    push_back(to, i);
+                }
+            }
+        }
+        catch(...) {
+            for(; k < bk.size; ++k) {
+                const uint32_t i = bk.data[k];
+                if(i == kNil)
+                    continue;
+                keep_in_place(bk, keep, i);
+                ++keep;
+            }
+            bk.size = keep;
+            throw;
+        }
+        bk.size = keep;
+        if(keep == 0 && list < kOverflow)
+            occupied_[list / kSlots] &= ~(uint64_t(1) << (list % kSlots));
+    }
+
+    // cascade 中留在原桶的节点放到位置 keep，留在溢出桶时更新最早的到期时刻
+    void keep_in_place(bucket& bk, uint32_t keep, uint32_t i) noexcept {
+        node& n = node_at(i);
+        n.pos = keep;
+        bk.data[keep] = i;
+        if(n.list == kOverflow && n.expiry < overflow_min_)
+            overflow_min_ = n.expiry;
+    }
+
+    // 处理时刻 e: 先从高到低把进入范围的槽下移，再触发第 0 层当前槽中的定时器
+    // 溢出桶在 e 进入最早的溢出定时器所在的区间时整体重新放置
+    template <class Function>
+    size_type process(tick_type e, Function& f) {
+        now_ = e;
+        if(buckets_[kOverflow].size != 0 && (overflow_min_ >> kWheelBits) <= (e >> kWheelBits))
+            cascade(kOverflow);
+        for(unsigned l = kLevels - 1; l > 0; --l) {
+            const unsigned shift = kSlotBits * l;
+            if((e & ((tick_type(1) << shift) - 1)) != 0)
+                continue;
+            const uint32_t slot = static_cast<uint32_t>(e >> shift) & (kSlots - 1);
+            if(occupied_[l] & (uint64_t(1) << slot))
+                cascade(l * kSlots + slot);
+        }
+        const uint32_t slot = static_cast<uint32_t>(e) & (kSlots - 1);
+        if((occupied_[0] & (uint64_t(1) << slot)) == 0) {
+            now_ = e + 1;
+            return 0;
+        }
+        // 与 kExpiring 交换数组，整批取下；触发过程中被 cancel 的节点在数组中留下 kNil
+        bucket& batch = buckets_[kExpiring];
+        mystl::swap(buckets_[slot], batch);
+        occupied_[0] &= ~(uint64_t(1) << slot);
+        for(uint32_t k = 0; k < batch.size; ++k) {
+            if(k + kPrefetch < batch.size)
+                mystl::prefetch_read(&node_at(batch.data[k + kPrefetch]));
+            node_at(batch.data[k]).list = kExpiring;
+        }
+        now_ = e + 1;
+
+        size_type fired = 0;
+        try {
+            for(uint32_t k = 0; k < batch.size; ++k) {
+                const uint32_t i = batch.data[k];
+                if(i == kNil)
+                    continue;
+                batch.data[k] = kNil;
+                node& n = node_at(i);
+                value_type value(mystl::move(n.value()));
+                mystl::destory_one(&n.value());
+                release_node(i);
+                --size_;
+                ++fired;
+                f(value);
+            }
+        }
+        catch(...) {
+            // 没有触发的定时器放回时间轮，在下一个时刻触发
+            cascade(kExpiring);
+            throw;
+        }
+        batch.size = 0;
+        return fired;
+    }
+};
+
+} // namespace mystl
+
+#endif // MYSTL_TIMING_WHEEL_H_
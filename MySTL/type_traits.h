@@ -30,6 +30,12 @@ struct is_pair : mystl::m_false_type{};
 template <class T1, class T2>
 struct is_pair<mystl::pair<T1, T2> > : mystl::m_true_type{};
 
+// 判断类型的对象能否逐字节比较相等: 整型、枚举、指针的值相等当且仅当对象表示相同
+// 浮点数不满足 (+0.0 == -0.0, NaN != NaN)，用户可以为没有填充字节的自定义类型特化
+template <class T>
+struct is_bitwise_comparable : m_bool_constant<
+    std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value> {};
+
 // *** general code ends *** //
 } // namespace ystl
 #endif // MYSTL_TYPE_TRAITS_H_
@@ -2,6 +2,7 @@
 #define MYSTL_UNINITIALIZED_H_
 
 // 这个头文件用于对未初始化空间构造元素
+// 元素类型可以平凡复制时直接调用 copy / fill / move，连续区间在其中使用 memmove / memset
 
 #include "algobase.h"
 #include "construct.h"
@@ -11,6 +12,15 @@
 
 namespace mystl {
 
+// 构造与赋值都是平凡的类型可以直接在未初始化空间上赋值，不需要逐个调用构造函数
+template <class T>
+using is_trivially_uninit_copy = std::bool_constant<
+    std::is_trivially_copy_constructible<T>::value && std::is_trivially_copy_assignable<T>::value>;
+
+template <class T>
+using is_trivially_uninit_move = std::bool_constant<
+    std::is_trivially_move_constructible<T>::value && std::is_trivially_move_assignable<T>::value>;
+
 /*****************************************************************************************/
 // uninitialized_copy
 // 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
@@ -29,9 +39,10 @@ ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
         for(; first != last; ++first, ++cur)
             mystl::construct(&*cur, *first);
     }
-    case(...) {
-        for(; result != cur; --cur)
-            mystl::destory(&*cur);
+    catch(...) {
+        for(; result != cur; ++result)
+            mystl::destory_one(&*result);
+        throw;
     }
     return cur;
 }
@@ -39,7 +50,7 @@ ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
 template <class InputIter, class ForwardIter>
 ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
     return mystl::unchecked_uninit_copy(first, last, result,
-        std::is_trivially_copy_assignable<
+        mystl::is_trivially_uninit_copy<
         typename iterator_traits<ForwardIter>::value_type>{});
 }
 
@@ -57,23 +68,24 @@ ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result,
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result,
     std::false_type) {
-    auto cur = first;
+    auto cur = result;
     try {
         for(; n > 0; ++cur, ++first, --n)
             mystl::construct(&*cur, *first);
     }
     catch(...) {
-        for(; result != cur; --cur) 
-            mystl::destory(&*cur);
+        for(; result != cur; ++result)
+            mystl::destory_one(&*result);
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class Size, class ForwardIter>
 ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
-    return mystl::unchecked_uninit_copy_n(first, last, result,
-        std::is_trivially_copy_assignable<
-        typename iterator_traits<InputIter>::value_type{});
+    return mystl::unchecked_uninit_copy_n(first, n, result,
+        mystl::is_trivially_uninit_copy<
+        typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 
@@ -96,17 +108,17 @@ void unchecked_uninit_fill(ForwardIter first, ForwardIter last,
             mystl::construct(&*cur, value);
     }
     catch(...) {
-        for(; first != cur; ++first) 
-            mystl::destory(&*first);
+        for(; first != cur; ++first)
+            mystl::destory_one(&*first);
+        throw;
     }
-    return cur;
 }
 
 template <class ForwardIter, class T>
-void unchecked_fill(ForwardIter first, ForwardIter last, const T& value) {
+void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
     mystl::unchecked_uninit_fill(first, last, value,
-        std::is_trivially_copy_assignable<
-        typename iterator_traits<ForwardIter>::value_type{});
+        mystl::is_trivially_uninit_copy<
+        typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 
@@ -116,7 +128,7 @@ void unchecked_fill(ForwardIter first, ForwardIter last, const T& value) {
 /*****************************************************************************************/
 template <class ForwardIter, class T, class Size>
 ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, std::true_type) {
-    mystl::fill_n(first, n, value);
+    return mystl::fill_n(first, n, value);
 }
 
 template <class ForwardIter, class T, class Size>
@@ -127,8 +139,9 @@ ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, s
             mystl::construct(&*cur, value);
     }
     catch(...) {
-        for(; first != cur; ++first) 
-            mystl::destory(&*first);
+        for(; first != cur; ++first)
+            mystl::destory_one(&*first);
+        throw;
     }
     return cur;
 }
@@ -136,8 +149,8 @@ ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value, s
 template <class ForwardIter, class T, class Size>
 ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
     return mystl::unchecked_uninit_fill_n(first, n, value,
-            std::is_trivially_copy_assignable<
-            typename iterator_traits<ForwardIter>::value_type{});
+            mystl::is_trivially_uninit_copy<
+            typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 
@@ -159,8 +172,9 @@ ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
         for(; first != last; ++first, ++cur)
             mystl::construct(&*cur, mystl::move(*first));
     }
-    case(...) {
+    catch(...) {
         mystl::destory(result, cur);
+        throw;
     }
     return cur;
 }
@@ -168,8 +182,8 @@ ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
 template <class InputIter, class ForwardIter>
 ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
     return mystl::unchecked_uninit_move(first, last, result,
-        std::is_trivially_copy_assignable<
-        typename iterator_traits<InputIter>::value_type>{});
+        mystl::is_trivially_uninit_move<
+        typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 
@@ -190,8 +204,8 @@ ForwardIter unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result,
             mystl::construct(&*cur, mystl::move(*first));
     }
     catch(...) {
-        for(; result != cur; ++result) 
-            mystl::destory(&*result);
+        for(; result != cur; ++result)
+            mystl::destory_one(&*result);
         throw;
     }
     return cur;
@@ -200,8 +214,8 @@ ForwardIter unchecked_uninit_move_n(InputIter first, Size n, ForwardIter result,
 template <class InputIter, class ForwardIter, class Size>
 ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
     return mystl::unchecked_uninit_move_n(first, n, result,
-            std::is_trivially_copy_assignable<
-            typename iterator_traits<InputIter>::value_type{});
+            mystl::is_trivially_uninit_move<
+            typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 }
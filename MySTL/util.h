@@ -68,8 +68,8 @@ struct pair {
     //implicit constructor
     template <class U1 = Ty1, class U2 = Ty2,
         typename std::enable_if_t<          
-        std::is_copy_constructible_v<Other1> &&
-        std::is_copy_constructible_v<Other2> &&
+        std::is_copy_constructible_v<U1> &&
+        std::is_copy_constructible_v<U2> &&
         std::is_convertible_v<const U1&, Ty1> &&
         std::is_convertible_v<const U2&, Ty2>, int> = 0>
         constexpr pair(const U1& a, const U2& b): first(a), second(b) {}        
@@ -77,8 +77,8 @@ struct pair {
     //explicit constructor
     template <class U1 = Ty1, class U2 = Ty2,
         typename std::enable_if_t<          
-        std::is_copy_constructible_v<Other1> &&
-        std::is_copy_constructible_v<Other2> &&
+        std::is_copy_constructible_v<U1> &&
+        std::is_copy_constructible_v<U2> &&
         (!std::is_convertible_v<const U1&, Ty1> ||
         !std::is_convertible_v<const U2&, Ty2>), int> = 0>
         explicit constexpr pair(const U1& a, const U2& b): first(a), second(b) {}        
@@ -117,7 +117,7 @@ struct pair {
         std::is_convertible_v<const Other1&, Ty1> &&
         std::is_convertible_v<const Other2&, Ty2>, int> = 0>
         constexpr pair(const pair<Other1, Other2>& other):
-        :first(other.fisrt), second(other.second) {}
+        first(other.first), second(other.second) {}
     
     template <class Other1, class Other2, 
         typename std::enable_if_t<
@@ -126,7 +126,7 @@ struct pair {
         std::is_convertible_v<Other1, Ty1> &&
         std::is_convertible_v<Other2, Ty2>, int> = 0>
         constexpr pair(pair<Other1, Other2>&& other):
-        :first(mystl::forward<Other1>(other.first)),
+        first(mystl::forward<Other1>(other.first)),
         second(mystl::forward<Other2>(other.second)) {}
     
     //explicit, pair
@@ -137,7 +137,7 @@ struct pair {
         (!std::is_convertible_v<const Other1&, Ty1> &&
         !std::is_convertible_v<const Other2&, Ty2>), int> = 0>
         explicit constexpr pair(const pair<Other1, Other2>& other):
-        :first(other.fisrt), second(other.second) {}
+        first(other.first), second(other.second) {}
     
     template <class Other1, class Other2, 
         typename std::enable_if_t<
@@ -146,7 +146,7 @@ struct pair {
         (!std::is_convertible_v<Other1, Ty1> &&
         !std::is_convertible_v<Other2, Ty2>), int> = 0>
         explicit constexpr pair(const pair<Other1, Other2>&& other):
-        :first(mystl::forward<Other1>(other.first)),
+        first(mystl::forward<Other1>(other.first)),
         second(mystl::forward<Other2>(other.second)) {}
 
     pair& operator=(const pair& rhs) {
@@ -0,0 +1,128 @@
+// 复制与移动算法的耗时，按算法与迭代器类型分别列出
+// 64K 个 12 字节的可平凡复制结构体，输出每个元素的平均耗时：
+//   pointer     : 指针区间，可平凡复制时使用 memmove
+//   contiguous  : 声明 contiguous_iterator_tag 的包装迭代器，同样使用 memmove
+//   random      : 只声明 random_access_iterator_tag 的包装迭代器，逐个赋值或构造，作为对照
+//   std (ptr)   : std:: 的同名算法在指针区间上的耗时
+// 每行一个算法: copy、copy_backward、copy_n、move、move_backward、uninitialized_copy、
+// uninitialized_copy_n、uninitialized_move
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O2 -IMySTL bench/copy_bench.cpp -o copy_bench
+//   ./copy_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "uninitialized.h"
+
+namespace {
+
+struct pod12 {
+    int32_t a, b, c;
+};
+
+// 包装指针的迭代器，Category 决定算法能否识别为连续区间
+template <class T, class Category>
+class wrap_iter {
+public:
+    typedef Category        iterator_category;
+    typedef T               value_type;
+    typedef ptrdiff_t       difference_type;
+    typedef T*              pointer;
+    typedef T&              reference;
+
+    wrap_iter() : p_(nullptr) {}
+    explicit wrap_iter(T* p) : p_(p) {}
+
+    T& operator*() const { return *p_; }
+    T* operator->() const { return p_; }
+    wrap_iter& operator++() { ++p_; return *this; }
+    wrap_iter& operator--() { --p_; return *this; }
+    wrap_iter& operator+=(ptrdiff_t n) { p_ += n; return *this; }
+    wrap_iter& operator-=(ptrdiff_t n) { p_ -= n; return *this; }
+    wrap_iter operator+(ptrdiff_t n) const { return wrap_iter(p_ + n); }
+    wrap_iter operator-(ptrdiff_t n) const { return wrap_iter(p_ - n); }
+    ptrdiff_t operator-(const wrap_iter& rhs) const { return p_ - rhs.p_; }
+    bool operator==(const wrap_iter& rhs) const { return p_ == rhs.p_; }
+    bool operator!=(const wrap_iter& rhs) const { return p_ != rhs.p_; }
+
+private:
+    T* p_;
+};
+
+typedef wrap_iter<pod12, mystl::contiguous_iterator_tag>    contiguous_it;
+typedef wrap_iter<pod12, mystl::random_access_iterator_tag> random_it;
+
+constexpr size_t kSize   = size_t(1) << 16;
+constexpr int    kRepeat = 200;
+
+// 返回 f 平均每个元素的耗时 (ns)，取多次运行中的最小值
+template <class F>
+double time_per_elem(F f) {
+    double best = 1e30;
+    for(int r = 0; r < kRepeat; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        best = std::min(best, s);
+    }
+    return best / kSize * 1e9;
+}
+
+pod12* volatile sink;
+
+// Op(first, last, result) 对三种迭代器各运行一次
+template <class Op, class StdOp>
+void row(const char* name, pod12* src, pod12* dst, Op op, StdOp std_op) {
+    const size_t n = kSize;
+    const double p = time_per_elem([&] { sink = mystl::to_address(op(src, src + n, dst)); });
+    const double c = time_per_elem([&] {
+        sink = mystl::to_address(op(contiguous_it(src), contiguous_it(src + n), contiguous_it(dst))); });
+    const double r = time_per_elem([&] {
+        sink = mystl::to_address(op(random_it(src), random_it(src + n), random_it(dst))); });
+    const double s = time_per_elem([&] { sink = std_op(src, src + n, dst); });
+    std::printf("%-22s %10.3f %12.3f %10.3f %10.3f\n", name, p, c, r, s);
+}
+
+} // namespace
+
+int main() {
+    std::vector<pod12> a(kSize), b(kSize + 1);
+    for(size_t i = 0; i < kSize; ++i)
+        a[i] = pod12{int32_t(i), int32_t(i * 3), int32_t(i * 7)};
+    pod12* src = a.data();
+    pod12* dst = b.data();
+
+    std::printf("%-22s %10s %12s %10s %10s   (ns/elem)\n", "", "pointer", "contiguous", "random", "std (ptr)");
+    row("copy", src, dst,
+        [](auto f, auto l, auto r) { return mystl::copy(f, l, r); },
+        [](pod12* f, pod12* l, pod12* r) { return std::copy(f, l, r); });
+    row("copy_backward", src, dst,
+        [](auto f, auto l, auto r) { return mystl::copy_backward(f, l, r + (l - f)); },
+        [](pod12* f, pod12* l, pod12* r) { return std::copy_backward(f, l, r + (l - f)); });
+    row("copy_n", src, dst,
+        [](auto f, auto l, auto r) { return mystl::copy_n(f, l - f, r).second; },
+        [](pod12* f, pod12* l, pod12* r) { return std::copy_n(f, l - f, r); });
+    row("move", src, dst,
+        [](auto f, auto l, auto r) { return mystl::move(f, l, r); },
+        [](pod12* f, pod12* l, pod12* r) { return std::move(f, l, r); });
+    row("move_backward", src, dst,
+        [](auto f, auto l, auto r) { return mystl::move_backward(f, l, r + (l - f)); },
+        [](pod12* f, pod12* l, pod12* r) { return std::move_backward(f, l, r + (l - f)); });
+    row("uninitialized_copy", src, dst,
+        [](auto f, auto l, auto r) { return mystl::uninitialized_copy(f, l, r); },
+        [](pod12* f, pod12* l, pod12* r) { return std::uninitialized_copy(f, l, r); });
+    row("uninitialized_copy_n", src, dst,
+        [](auto f, auto l, auto r) { return mystl::uninitialized_copy_n(f, l - f, r); },
+        [](pod12* f, pod12* l, pod12* r) { return std::uninitialized_copy_n(f, l - f, r); });
+    row("uninitialized_move", src, dst,
+        [](auto f, auto l, auto r) { return mystl::uninitialized_move(f, l, r); },
+        [](pod12* f, pod12* l, pod12* r) { return std::uninitialized_move(f, l, r); });
+    return 0;
+}
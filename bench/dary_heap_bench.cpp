@@ -0,0 +1,96 @@
+// d 叉堆作为调度队列的耗时 (hold 模型)
+// 堆中有 n 个 16 字节的事件，每一步弹出最早的事件，把它的时间推后一个随机量后重新插入，
+// 输出每次 pop + push 的平均耗时 (ns)：
+//   binary : mystl::pop_heap / push_heap
+//   4-ary  : mystl::pop_dary_heap<4> / push_dary_heap<4>，first + 1 对齐到 64 字节，
+//            每个节点的 4 个子节点恰好位于同一个缓存行
+//   8-ary  : mystl::pop_dary_heap<8> / push_dary_heap<8>，对齐方式同上，子节点跨两个缓存行
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O2 -IMySTL bench/dary_heap_bench.cpp -o dary_heap_bench
+//   ./dary_heap_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "heap_algo.h"
+
+namespace {
+
+struct event {
+    uint64_t time;
+    uint64_t id;
+};
+
+// 时间早的事件优先，堆顶为最小值
+struct later {
+    bool operator()(const event& a, const event& b) const { return a.time > b.time; }
+};
+
+constexpr size_t kSteps = size_t(1) << 20;
+
+// 分配 n 个事件的缓冲区，使 first + 1 位于 64 字节边界
+event* aligned_events(std::vector<unsigned char>& storage, size_t n) {
+    storage.resize((n + 8) * sizeof(event));
+    uintptr_t p = reinterpret_cast<uintptr_t>(storage.data()) + sizeof(event);
+    p = (p + 63) & ~uintptr_t(63);
+    return reinterpret_cast<event*>(p - sizeof(event));
+}
+
+volatile uint64_t sink;
+
+// Pop / Push 为对 [first, last) 的堆操作，返回每步的耗时 (ns)，取三次运行中的最小值
+template <class Pop, class Push, class Make>
+double hold(event* first, size_t n, Make make, Pop pop, Push push) {
+    double best = 1e30;
+    for(int r = 0; r < 3; ++r) {
+        std::mt19937_64 rng(41);
+        for(size_t i = 0; i < n; ++i)
+            first[i] = event{rng() % (n * 4), i};
+        make(first, first + n);
+        const auto t0 = std::chrono::steady_clock::now();
+        uint64_t acc = 0;
+        for(size_t s = 0; s < kSteps; ++s) {
+            pop(first, first + n);
+            event& e = first[n - 1];
+            acc += e.id;
+            e.time += 1 + (rng() & 0xffff) % (n * 2);
+            push(first, first + n);
+        }
+        const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        sink = acc;
+        best = std::min(best, t);
+    }
+    return best / kSteps * 1e9;
+}
+
+template <size_t D>
+double hold_dary(event* first, size_t n) {
+    return hold(first, n,
+                [](event* f, event* l) { mystl::make_dary_heap<D>(f, l, later()); },
+                [](event* f, event* l) { mystl::pop_dary_heap<D>(f, l, later()); },
+                [](event* f, event* l) { mystl::push_dary_heap<D>(f, l, later()); });
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-8s %10s %10s %10s   (ns per pop+push)\n", "n", "binary", "4-ary", "8-ary");
+    for(size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 20, size_t(1) << 23}) {
+        std::vector<unsigned char> storage;
+        event* first = aligned_events(storage, n);
+        const double b = hold(first, n,
+                              [](event* f, event* l) { mystl::make_heap(f, l, later()); },
+                              [](event* f, event* l) { mystl::pop_heap(f, l, later()); },
+                              [](event* f, event* l) { mystl::push_heap(f, l, later()); });
+        const double d4 = hold_dary<4>(first, n);
+        const double d8 = hold_dary<8>(first, n);
+        std::printf("%-8zu %10.1f %10.1f %10.1f\n", n, b, d4, d8);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// heap_algo 的比较次数与耗时测试
+// 1M 个约 26 字符的字符串键，比较函数计数，输出每个元素的平均比较次数与耗时：
+//   sort_heap                 : mystl::sort_heap，adjust_heap 自底向上，每层一次子节点间的比较
+//   sort_heap (top-down ref)  : 教科书式的自顶向下下滤，每层两次比较，作为对照
+//   pop+push hold             : 反复 pop_heap 后把键改大一点再 push_heap，模拟定时器队列
+//   make_heap                 : mystl::make_heap
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O2 -IMySTL bench/heap_algo_bench.cpp -o heap_algo_bench
+//   ./heap_algo_bench
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "heap_algo.h"
+
+namespace {
+
+unsigned long long compares = 0;
+
+struct counting_less {
+    bool operator()(const std::string& a, const std::string& b) const {
+        ++compares;
+        return a < b;
+    }
+};
+
+// 对照: 自顶向下的 pop_heap，每层先比较两个子节点，再与下滤的值比较
+template <class RandomIter>
+void top_down_pop_heap(RandomIter first, RandomIter last, counting_less comp) {
+    --last;
+    std::string value = mystl::move(*last);
+    *last = mystl::move(*first);
+    const ptrdiff_t len = last - first;
+    ptrdiff_t hole = 0;
+    while(true) {
+        ptrdiff_t child = 2 * hole + 1;
+        if(child >= len)
+            break;
+        if(child + 1 < len && comp(first[child], first[child + 1]))
+            ++child;
+        if(!comp(value, first[child]))
+            break;
+        first[hole] = mystl::move(first[child]);
+        hole = child;
+    }
+    first[hole] = mystl::move(value);
+}
+
+void report(const char* name, size_t n, std::chrono::steady_clock::time_point t0) {
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::printf("%-28s %6.2f cmp/elem  %7.1f ns/elem\n", name, double(compares) / n, s / n * 1e9);
+}
+
+// 在已建好的堆上运行 f，只统计 f 的比较次数与耗时
+template <class F>
+void run_on_heap(const char* name, const std::vector<std::string>& keys, F f) {
+    std::vector<std::string> v = keys;
+    mystl::make_heap(v.data(), v.data() + v.size(), counting_less());
+    compares = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    f(v);
+    report(name, v.size(), t0);
+}
+
+} // namespace
+
+int main() {
+    const size_t n = size_t(1) << 20;
+    std::mt19937 rng(7);
+    std::vector<std::string> keys(n);
+    for(auto& k : keys) {
+        k = "tenant-0042/event/";
+        k += std::to_string(rng() % 100000000);
+    }
+
+    run_on_heap("sort_heap", keys, [](std::vector<std::string>& v) {
+        mystl::sort_heap(v.data(), v.data() + v.size(), counting_less());
+    });
+    run_on_heap("sort_heap (top-down ref)", keys, [](std::vector<std::string>& v) {
+        for(size_t k = v.size(); k > 1; --k)
+            top_down_pop_heap(v.data(), v.data() + k, counting_less());
+    });
+    run_on_heap("pop+push hold", keys, [](std::vector<std::string>& v) {
+        const size_t len = v.size();
+        for(size_t k = 0; k < len; ++k) {
+            mystl::pop_heap(v.data(), v.data() + len, counting_less());
+            v[len - 1].back() ^= 1;
+            mystl::push_heap(v.data(), v.data() + len, counting_less());
+        }
+    });
+
+    std::vector<std::string> v = keys;
+    compares = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    mystl::make_heap(v.data(), v.data() + v.size(), counting_less());
+    report("make_heap", v.size(), t0);
+    return 0;
+}
@@ -0,0 +1,115 @@
+// 大块复制对并发的缓存敏感负载的影响
+// 读线程在大小为 ws 的工作集上做随机的指针追逐，主线程同时反复复制 64 MiB 的缓冲区，输出：
+//   alone      : 没有复制时读线程每次访问的平均耗时
+//   memcpy     : 以 std::memcpy 复制时读线程每次访问的平均耗时，以及复制带宽
+//   large_copy : 以 mystl::large_copy (非临时存储) 复制时的同样两项
+// 非临时存储不把目标缓存行读入缓存，读线程的工作集被挤出得更少；
+// 读线程与复制需要在不同的核上运行，单核机器上两者分时执行，结果没有意义
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O2 -pthread -IMySTL bench/large_copy_bench.cpp -o large_copy_bench
+//   ./large_copy_bench
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "algobase.h"
+
+namespace {
+
+constexpr size_t kCopyBytes = size_t(64) << 20;
+constexpr int    kCopies    = 8;
+
+typedef std::chrono::steady_clock clock_type;
+
+// 把 [0, n) 排成一个随机的环，每个元素占一个缓存行，next[i] 为下一个访问的下标
+std::vector<size_t> make_ring(size_t n) {
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::mt19937_64 rng(40);
+    for(size_t i = n - 1; i > 0; --i)
+        std::swap(order[i], order[rng() % (i + 1)]);
+    std::vector<size_t> next(n * 8);
+    for(size_t i = 0; i < n; ++i)
+        next[order[i] * 8] = order[(i + 1) % n] * 8;
+    return next;
+}
+
+struct reader {
+    const std::vector<size_t>* next;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> measuring{false};
+    std::atomic<uint64_t> accesses{0};
+    volatile size_t sink = 0;
+
+    void run() {
+        size_t p = 0;
+        uint64_t local = 0;
+        while(!stop.load(std::memory_order_relaxed)) {
+            for(int k = 0; k < 256; ++k)
+                p = (*next)[p];
+            if(measuring.load(std::memory_order_relaxed))
+                local += 256;
+            else if(local != 0) {
+                accesses.fetch_add(local, std::memory_order_relaxed);
+                local = 0;
+            }
+        }
+        accesses.fetch_add(local, std::memory_order_relaxed);
+        sink = p;
+    }
+};
+
+// 在 body 执行期间统计读线程的访问次数，返回每次访问的平均耗时 (ns) 与 body 的耗时 (s)
+template <class Body>
+void measure(reader& r, Body body, double& ns_per_access, double& seconds) {
+    r.accesses.store(0);
+    r.measuring.store(true);
+    const auto t0 = clock_type::now();
+    body();
+    seconds = std::chrono::duration<double>(clock_type::now() - t0).count();
+    r.measuring.store(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    const uint64_t n = r.accesses.load();
+    ns_per_access = n ? seconds / n * 1e9 : 0.0;
+}
+
+} // namespace
+
+int main() {
+    std::vector<unsigned char> src(kCopyBytes, 1), dst(kCopyBytes, 2);
+    const double gb = double(kCopyBytes) * kCopies / 1e9;
+
+    std::printf("%-8s | %10s | %10s %10s | %10s %10s\n", "ws", "alone", "memcpy", "GB/s", "large_copy", "GB/s");
+    for(size_t ws : {size_t(256) << 10, size_t(1) << 20, size_t(4) << 20, size_t(16) << 20}) {
+        const std::vector<size_t> next = make_ring(ws / 64);
+        reader r;
+        r.next = &next;
+        std::thread t([&] { r.run(); });
+
+        double alone, copy_ns, copy_s, stream_ns, stream_s, unused;
+        measure(r, [] { std::this_thread::sleep_for(std::chrono::milliseconds(200)); }, alone, unused);
+        measure(r, [&] {
+            for(int i = 0; i < kCopies; ++i)
+                std::memcpy(dst.data(), src.data(), kCopyBytes);
+        }, copy_ns, copy_s);
+        measure(r, [&] {
+            for(int i = 0; i < kCopies; ++i)
+                mystl::large_copy(src.data(), src.data() + kCopyBytes, dst.data());
+        }, stream_ns, stream_s);
+
+        r.stop.store(true);
+        t.join();
+        std::printf("%5zu KiB | %7.2f ns | %7.2f ns %10.2f | %7.2f ns %10.2f\n",
+                    ws >> 10, alone, copy_ns, gb / copy_s, stream_ns, gb / stream_s);
+    }
+    return 0;
+}
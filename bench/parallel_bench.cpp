@@ -0,0 +1,105 @@
+// parallel.h 的扩展性测试: 递归 fib 与快速排序，串行版本与 task_group 版本对比
+// fib(n) 在 n < kFibCutoff 时串行计算；快速排序在区间小于 kSortCutoff 时串行排序
+// 线程数在编译时由 MYSTL_PARALLEL_THREADS 指定 (缺省为硬件线程数)，分别编译后对比各线程数下的加速比
+//
+// 编译运行（在仓库根目录）：
+//   for t in 1 2 4 8; do
+//       g++ -std=c++17 -O2 -pthread -DMYSTL_PARALLEL_THREADS=$t -IMySTL bench/parallel_bench.cpp -o parallel_bench_$t
+//       ./parallel_bench_$t
+//   done
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "parallel.h"
+
+namespace {
+
+constexpr int  kFibN       = 36;
+constexpr int  kFibCutoff  = 20;
+constexpr long kSortSize   = 1L << 24;
+constexpr long kSortCutoff = 1L << 12;
+constexpr int  kRounds     = 3;
+
+long serial_fib(int n) {
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+long task_fib(int n) {
+    if(n < kFibCutoff)
+        return serial_fib(n);
+    long a = 0, b = 0;
+    mystl::parallel_invoke([&] { a = task_fib(n - 1); }, [&] { b = task_fib(n - 2); });
+    return a + b;
+}
+
+template <bool Parallel>
+void quick_sort(int* a, long n) {
+    if(n < kSortCutoff) {
+        std::sort(a, a + n);
+        return;
+    }
+    const int pivot = a[n / 2];
+    int* m1 = std::partition(a, a + n, [pivot](int x) { return x < pivot; });
+    int* m2 = std::partition(m1, a + n, [pivot](int x) { return x == pivot; });
+    if(Parallel) {
+        mystl::task_group group;
+        group.run([=] { quick_sort<Parallel>(a, m1 - a); });
+        quick_sort<Parallel>(m2, a + n - m2);
+        group.wait();
+    }
+    else {
+        quick_sort<Parallel>(a, m1 - a);
+        quick_sort<Parallel>(m2, a + n - m2);
+    }
+}
+
+// 取 kRounds 次中最好的一次，prepare 不计时
+template <class Prepare, class F>
+double best_ms(Prepare prepare, F f) {
+    double best = 1e300;
+    for(int r = 0; r < kRounds; ++r) {
+        prepare();
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        const double ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        best = std::min(best, ms);
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    const size_t threads = mystl::hardware_threads();
+    mystl::default_thread_pool();       // 预先创建工作线程
+
+    long fs = 0, ft = 0;
+    const double fib_serial = best_ms([] {}, [&] { fs = serial_fib(kFibN); });
+    const double fib_tasks  = best_ms([] {}, [&] { ft = task_fib(kFibN); });
+
+    std::mt19937 rng(11);
+    std::vector<int> input(kSortSize), a;
+    for(auto& x : input)
+        x = static_cast<int>(rng());
+    std::vector<int> expect = input;
+    std::sort(expect.begin(), expect.end());
+    bool sorted_ok = true;
+    auto prepare = [&] { a = input; };
+    const double sort_serial = best_ms(prepare, [&] { quick_sort<false>(a.data(), kSortSize); });
+    sorted_ok = sorted_ok && a == expect;
+    const double sort_tasks = best_ms(prepare, [&] { quick_sort<true>(a.data(), kSortSize); });
+    sorted_ok = sorted_ok && a == expect;
+
+    std::printf("threads %2zu  fib(%d)    serial %8.1f ms  tasks %8.1f ms  speedup %5.2fx  %s\n",
+                threads, kFibN, fib_serial, fib_tasks, fib_serial / fib_tasks,
+                fs == ft ? "ok" : "MISMATCH");
+    std::printf("threads %2zu  sort(%ldM) serial %8.1f ms  tasks %8.1f ms  speedup %5.2fx  %s\n",
+                threads, kSortSize >> 20, sort_serial, sort_tasks, sort_serial / sort_tasks,
+                sorted_ok ? "ok" : "MISMATCH");
+    return 0;
+}
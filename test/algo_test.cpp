@@ -0,0 +1,528 @@
+// algo.h 的正确性测试: 以 std 的同名算法为参照，比较随机输入上的结果
+// 指针区间上的算术类型走 SIMD 快速路径，其余迭代器与类型走通用版本
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/algo_test.cpp -o algo_test
+//   ./algo_test
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -DMYSTL_NO_SIMD -IMySTL test/algo_test.cpp -o algo_test_scalar
+//   ./algo_test_scalar
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algo.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(28);
+
+// 在 range 个相邻值中取值的随机序列，range 小时重复元素多
+template <class T>
+std::vector<T> random_input(size_t n, uint64_t range) {
+    std::vector<T> v(n);
+    for(auto& x : v)
+        x = static_cast<T>(static_cast<int64_t>(rng() % range) - static_cast<int64_t>(range / 2));
+    return v;
+}
+
+/*****************************************************************************************/
+// min_element / max_element / minmax_element
+/*****************************************************************************************/
+template <class T>
+void check_extremum(const std::vector<T>& v) {
+    const T* first = v.data();
+    const T* last = first + v.size();
+    CHECK(mystl::min_element(first, last) - first == std::min_element(v.begin(), v.end()) - v.begin());
+    CHECK(mystl::max_element(first, last) - first == std::max_element(v.begin(), v.end()) - v.begin());
+    const auto mm = mystl::minmax_element(first, last);
+    const auto expect = std::minmax_element(v.begin(), v.end());
+    CHECK(mm.first - first == expect.first - v.begin());
+    CHECK(mm.second - first == expect.second - v.begin());
+    const auto mc = mystl::minmax_element(first, last, std::greater<T>());
+    const auto expect_c = std::minmax_element(v.begin(), v.end(), std::greater<T>());
+    CHECK(mc.first - first == expect_c.first - v.begin());
+    CHECK(mc.second - first == expect_c.second - v.begin());
+}
+
+template <class T>
+void test_extremum() {
+    for(int round = 0; round < 300; ++round) {
+        const size_t n = round < 80 ? static_cast<size_t>(round) : rng() % 5000;
+        // 小值域时最值会重复出现，检查取第一个最小值、最后一个最大值
+        const uint64_t range = round % 2 == 0 ? 7 : (uint64_t(1) << 40);
+        check_extremum(random_input<T>(n, range));
+    }
+    // 窄整型在 4 / 8 字节内核里按块处理索引，长度跨过 65536 时检查索引不截断
+    std::vector<T> big = random_input<T>(200000, 100);
+    big[150001] = std::numeric_limits<T>::max();
+    big[131072] = std::numeric_limits<T>::lowest();
+    check_extremum(big);
+}
+
+template <class T>
+void test_extremum_nan() {
+    for(int round = 0; round < 100; ++round) {
+        std::vector<T> v = random_input<T>(1 + rng() % 300, 1000);
+        v[rng() % v.size()] = std::numeric_limits<T>::quiet_NaN();
+        // 含 NaN 时回退通用循环，结果应与逐个比较的顺序一致
+        const T* first = v.data();
+        const T* last = first + v.size();
+        CHECK(mystl::min_element(first, last) - first == std::min_element(v.begin(), v.end()) - v.begin());
+        CHECK(mystl::max_element(first, last) - first == std::max_element(v.begin(), v.end()) - v.begin());
+        const auto mm = mystl::minmax_element(first, last);
+        const auto expect = std::minmax_element(v.begin(), v.end());
+        CHECK(mm.first - first == expect.first - v.begin());
+        CHECK(mm.second - first == expect.second - v.begin());
+    }
+}
+
+/*****************************************************************************************/
+// adjacent_find / is_sorted / unique / unique_copy
+/*****************************************************************************************/
+template <class T>
+void check_neighbors(std::vector<T> v) {
+    T* p = v.data();
+    T* const pe = p + v.size();
+    CHECK(mystl::adjacent_find(p, pe) - p == std::adjacent_find(v.begin(), v.end()) - v.begin());
+    CHECK(mystl::is_sorted(p, pe) == std::is_sorted(v.begin(), v.end()));
+    CHECK(mystl::is_sorted(p, pe, std::greater<T>()) == std::is_sorted(v.begin(), v.end(), std::greater<T>()));
+    using mystl_test::forward_iter;
+    CHECK(mystl::is_sorted(forward_iter<T>(p), forward_iter<T>(pe)) == std::is_sorted(v.begin(), v.end()));
+
+    std::vector<T> expect(v.size());
+    expect.erase(std::unique_copy(v.begin(), v.end(), expect.begin()), expect.end());
+    std::vector<T> out(v.size() + 1);
+    CHECK(mystl::unique_copy(p, pe, out.data()) - out.data() == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin(),
+                     [](const T& a, const T& b) { return a == b || (a != a && b != b); }));
+    CHECK(mystl::unique_copy(p, pe, forward_iter<T>(out.data()), std::equal_to<T>()).base() - out.data()
+          == static_cast<ptrdiff_t>(expect.size()));
+
+    std::vector<T> w = v;
+    CHECK(mystl::unique(w.data(), w.data() + w.size(), std::equal_to<T>()) - w.data()
+          == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(mystl::unique(p, pe) - p == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(std::equal(expect.begin(), expect.end(), v.begin(),
+                     [](const T& a, const T& b) { return a == b || (a != a && b != b); }));
+}
+
+template <class T>
+void test_neighbors() {
+    for(int round = 0; round < 400; ++round) {
+        const size_t n = round < 100 ? static_cast<size_t>(round) : rng() % 3000;
+        std::vector<T> v = random_input<T>(n, round % 3 == 0 ? 3 : round % 3 == 1 ? 50 : (uint64_t(1) << 40));
+        if(round % 2 == 0)
+            std::sort(v.begin(), v.end());
+        check_neighbors(v);
+    }
+    if constexpr(std::is_floating_point<T>::value) {
+        std::vector<T> v = random_input<T>(100, 5);
+        std::sort(v.begin(), v.end());
+        v[40] = v[41] = std::numeric_limits<T>::quiet_NaN();
+        check_neighbors(v);
+    }
+}
+
+/*****************************************************************************************/
+// copy_if / remove_copy_if / remove_copy / remove_if / remove / partition_copy
+/*****************************************************************************************/
+// 12 字节的结构体，走标量的流压缩
+struct triple {
+    int32_t a, b, c;
+    bool operator==(const triple& rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c; }
+    bool operator!=(const triple& rhs) const { return !(*this == rhs); }
+};
+
+template <class T, class Pred>
+void check_compaction(const std::vector<T>& v, Pred pred) {
+    const T* p = v.data();
+    const T* const pe = p + v.size();
+    std::vector<T> expect, out(v.size() + 1), out2(v.size() + 1);
+    // 输出区间之后放一个哨兵，检查压缩不会写出保留的元素之外
+    const size_t guard = v.size();
+
+    std::copy_if(v.begin(), v.end(), std::back_inserter(expect), pred);
+    std::fill(out.begin(), out.end(), T{});
+    CHECK(mystl::copy_if(p, pe, out.data(), pred) - out.data() == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+    CHECK(expect.size() == guard || out[expect.size()] == T{});
+
+    std::vector<T> rest;
+    std::remove_copy_if(v.begin(), v.end(), std::back_inserter(rest), pred);
+    CHECK(mystl::remove_copy_if(p, pe, out.data(), pred) - out.data() == static_cast<ptrdiff_t>(rest.size()));
+    CHECK(std::equal(rest.begin(), rest.end(), out.begin()));
+
+    std::fill(out.begin(), out.end(), T{});
+    const auto pc = mystl::partition_copy(p, pe, out.data(), out2.data(), pred);
+    CHECK(pc.first - out.data() == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(pc.second - out2.data() == static_cast<ptrdiff_t>(rest.size()));
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+    CHECK(std::equal(rest.begin(), rest.end(), out2.begin()));
+    CHECK(expect.size() == guard || out[expect.size()] == T{});
+
+    std::vector<T> w = v;
+    T* const we = mystl::remove_if(w.data(), w.data() + w.size(), pred);
+    CHECK(we - w.data() == static_cast<ptrdiff_t>(rest.size()));
+    CHECK(std::equal(rest.begin(), rest.end(), w.begin()));
+}
+
+template <class T>
+void check_remove(const std::vector<T>& v, const T& value) {
+    std::vector<T> expect, out(v.size());
+    std::remove_copy(v.begin(), v.end(), std::back_inserter(expect), value);
+    CHECK(mystl::remove_copy(v.data(), v.data() + v.size(), out.data(), value) - out.data()
+          == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+    std::vector<T> w = v;
+    CHECK(mystl::remove(w.data(), w.data() + w.size(), value) - w.data() == static_cast<ptrdiff_t>(expect.size()));
+    CHECK(std::equal(expect.begin(), expect.end(), w.begin()));
+}
+
+template <class T>
+void test_compaction() {
+    // 选择率从 0 到 1: 元素取自 [-50, 50)，阈值 t 使约 (t + 50)% 的元素小于 t
+    for(int t = -50; t <= 50; t += 5) {
+        for(int round = 0; round < 6; ++round) {
+            const size_t n = round < 2 ? rng() % 40 : rng() % 3000;
+            const std::vector<T> v = random_input<T>(n, 100);
+            const T c = static_cast<T>(t);
+            check_compaction(v, mystl::bind2nd(mystl::less<T>(), c));
+            check_compaction(v, mystl::bind2nd(mystl::greater_equal<T>(), c));
+            check_compaction(v, [c](const T& x) { return x < c; });
+            if(round == 0) {
+                check_compaction(v, mystl::bind2nd(mystl::equal_to<T>(), c));
+                check_compaction(v, mystl::bind2nd(mystl::not_equal_to<T>(), c));
+                check_compaction(v, mystl::bind2nd(mystl::less_equal<T>(), c));
+                check_compaction(v, mystl::bind2nd(mystl::greater<T>(), c));
+                check_remove(v, c);
+            }
+        }
+    }
+}
+
+// 当前 CPU 支持的每个向量压缩内核都单独比较一次，包括写到读取位置之前一格的原地压缩
+template <class T>
+void test_compress_kernels() {
+#ifdef MYSTL_SIMD_X86
+    const int level = mystl::simd_level();
+    for(int round = 0; round < 200; ++round) {
+        const std::vector<T> v = random_input<T>(rng() % 500, 100);
+        const T c = static_cast<T>(static_cast<int>(rng() % 100) - 50);
+        std::vector<T> expect_t, expect_f;
+        for(const T& x : v)
+            (x < c ? expect_t : expect_f).push_back(x);
+        std::vector<T> out_t(v.size() + 1), out_f(v.size() + 1);
+        auto check = [&](mystl::pair<size_t, size_t> r) {
+            CHECK(r.first == expect_t.size() && r.second == expect_f.size());
+            CHECK(std::equal(expect_t.begin(), expect_t.end(), out_t.begin()));
+            CHECK(std::equal(expect_f.begin(), expect_f.end(), out_f.begin()));
+        };
+        std::vector<T> w = v;
+        w.insert(w.begin(), T{});
+        if(level >= mystl::simd_avx2) {
+            check(mystl::compress_avx2<T, mystl::cmp_lt>(v.data(), v.size(), c, out_t.data(), out_f.data(), false));
+            const auto r = mystl::compress_avx2<T, mystl::cmp_lt>(w.data() + 1, v.size(), c,
+                                                                  nullptr, w.data(), true);
+            CHECK(r.second == expect_f.size() && std::equal(expect_f.begin(), expect_f.end(), w.begin()));
+        }
+        w = v;
+        w.insert(w.begin(), T{});
+        if(level >= mystl::simd_avx512) {
+            check(mystl::compress_avx512<T, mystl::cmp_lt>(v.data(), v.size(), c, out_t.data(), out_f.data()));
+            const auto r = mystl::compress_avx512<T, mystl::cmp_lt>(w.data() + 1, v.size(), c,
+                                                                    nullptr, w.data());
+            CHECK(r.second == expect_f.size() && std::equal(expect_f.begin(), expect_f.end(), w.begin()));
+        }
+    }
+#endif
+}
+
+void test_compaction_struct() {
+    for(int round = 0; round < 100; ++round) {
+        std::vector<triple> v(rng() % 2000);
+        for(auto& x : v)
+            x = triple{static_cast<int32_t>(rng() % 10), static_cast<int32_t>(rng()), 0};
+        check_compaction(v, [](const triple& x) { return x.a < 3; });
+        check_remove(v, v.empty() ? triple{} : v[0]);
+    }
+}
+
+// remove / remove_if 对每个元素只调用一次谓词
+void test_compaction_calls() {
+    for(size_t n : {0, 1, 7, 100, 1000}) {
+        std::vector<int> v = random_input<int>(n, 10);
+        size_t calls = 0;
+        mystl::remove_if(v.data(), v.data() + v.size(), [&calls](int x) { ++calls; return x < 0; });
+        CHECK(calls == n);
+        std::vector<triple> w(n);
+        calls = 0;
+        mystl::remove_if(w.data(), w.data() + w.size(), [&calls](const triple&) { ++calls; return true; });
+        CHECK(calls == n);
+    }
+}
+
+/*****************************************************************************************/
+// partition / stable_partition / parallel_partition
+/*****************************************************************************************/
+// [first, mid) 全部满足谓词，[mid, last) 全部不满足，且元素的多重集合不变
+template <class T, class Pred>
+void check_partitioned(const std::vector<T>& before, const std::vector<T>& after, size_t mid, Pred pred) {
+    for(size_t i = 0; i < after.size(); ++i)
+        CHECK(static_cast<bool>(pred(after[i])) == (i < mid));
+    std::vector<T> a = before, b = after;
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    CHECK(a == b);
+}
+
+template <class T>
+void check_partition(const std::vector<T>& v, const T& c) {
+    size_t calls = 0;
+    auto pred = [&calls, c](const T& x) { ++calls; return x < c; };
+    auto plain = [c](const T& x) { return x < c; };
+
+    std::vector<T> w = v;
+    size_t mid = static_cast<size_t>(mystl::partition(w.data(), w.data() + w.size(), pred) - w.data());
+    CHECK(calls == v.size());
+    check_partitioned(v, w, mid, plain);
+
+    using mystl_test::bidi_iter;
+    w = v;
+    mid = static_cast<size_t>(mystl::partition(bidi_iter<T>(w.data()), bidi_iter<T>(w.data() + w.size()), plain)
+                              .base() - w.data());
+    check_partitioned(v, w, mid, plain);
+
+    std::vector<T> expect = v;
+    std::stable_partition(expect.begin(), expect.end(), plain);
+    w = v;
+    calls = 0;
+    mystl::stable_partition(w.data(), w.data() + w.size(), pred);
+    CHECK(calls == v.size());
+    CHECK(w == expect);
+    w = v;
+    mystl::stable_partition(bidi_iter<T>(w.data()), bidi_iter<T>(w.data() + w.size()), plain);
+    CHECK(w == expect);
+
+    // 没有缓冲区时的分治版本，调用前跳过令谓词为 true 的前缀，首元素已知为 false 不再调用谓词
+    w = v;
+    T* first = std::find_if_not(w.data(), w.data() + w.size(), plain);
+    if(first != w.data() + w.size()) {
+        calls = 0;
+        const ptrdiff_t len = w.data() + w.size() - first;
+        mystl::stable_partition_without_buffer(first, w.data() + w.size(), pred, len);
+        CHECK(calls == static_cast<size_t>(len) - 1);
+    }
+    CHECK(w == expect);
+}
+
+template <class T>
+void test_partition() {
+    for(int round = 0; round < 300; ++round) {
+        // 长度覆盖分块版本的主循环与不足两块的收尾
+        const size_t n = round < 150 ? static_cast<size_t>(round * 3) : rng() % 5000;
+        const std::vector<T> v = random_input<T>(n, 100);
+        check_partition(v, static_cast<T>(static_cast<int>(rng() % 110) - 55));
+    }
+}
+
+void test_partition_string() {
+    for(int round = 0; round < 100; ++round) {
+        std::vector<std::string> v;
+        for(int value : random_input<int>(rng() % 600, 1000))
+            v.push_back(std::to_string(value));
+        check_partition(v, std::string("3"));
+    }
+}
+
+void test_parallel_partition() {
+    for(int round = 0; round < 3; ++round) {
+        const std::vector<int> v = random_input<int>(4 * mystl::kParallelPartitionGrain + 77, 1000);
+        const int c = round == 0 ? -500 : round == 1 ? 0 : 450;
+        auto pred = [c](int x) { return x < c; };
+        std::vector<int> w = v;
+        const size_t mid = static_cast<size_t>(mystl::parallel_partition(w.data(), w.data() + w.size(), pred)
+                                               - w.data());
+        check_partitioned(v, w, mid, pred);
+    }
+}
+
+/*****************************************************************************************/
+// 二分查找与其他查找算法的通用版本
+/*****************************************************************************************/
+template <class Iter>
+void check_bounds(const std::vector<int>& v) {
+    const int* p = v.data();
+    const Iter first(const_cast<int*>(p)), last(const_cast<int*>(p + v.size()));
+    for(int value = -25; value <= 25; ++value) {
+        CHECK(mystl::lower_bound(first, last, value).base() - p
+              == std::lower_bound(v.begin(), v.end(), value) - v.begin());
+        CHECK(mystl::upper_bound(first, last, value).base() - p
+              == std::upper_bound(v.begin(), v.end(), value) - v.begin());
+        const auto er = mystl::equal_range(first, last, value);
+        const auto expect = std::equal_range(v.begin(), v.end(), value);
+        CHECK(er.first.base() - p == expect.first - v.begin());
+        CHECK(er.second.base() - p == expect.second - v.begin());
+        const auto erc = mystl::equal_range(first, last, value, std::less<int>());
+        CHECK(erc.first.base() - p == expect.first - v.begin());
+        CHECK(erc.second.base() - p == expect.second - v.begin());
+    }
+}
+
+void test_search() {
+    using mystl_test::bidi_iter;
+    using mystl_test::forward_iter;
+    using mystl_test::random_iter;
+    for(int round = 0; round < 200; ++round) {
+        std::vector<int> v = random_input<int>(rng() % 100, 40);
+        std::sort(v.begin(), v.end());
+        check_bounds<forward_iter<int>>(v);
+        check_bounds<random_iter<int>>(v);
+    }
+
+    for(int round = 0; round < 300; ++round) {
+        std::vector<int> v = random_input<int>(rng() % 60, 3);
+        std::vector<int> pat = random_input<int>(rng() % 4, 3);
+        int* p = v.data();
+        int* const pe = p + v.size();
+        int* const q = pat.data();
+        int* const qe = q + pat.size();
+        const int count = static_cast<int>(rng() % 5);
+        const int value = static_cast<int>(rng() % 3) - 1;
+        CHECK(mystl::search_n(p, pe, count, value) - p
+              == std::search_n(v.begin(), v.end(), count, value) - v.begin());
+        CHECK(mystl::search_n(p, pe, count, value, std::equal_to<int>()) - p
+              == std::search_n(v.begin(), v.end(), count, value) - v.begin());
+        const ptrdiff_t fe = std::find_end(v.begin(), v.end(), pat.begin(), pat.end()) - v.begin();
+        CHECK(mystl::find_end(p, pe, q, qe) - p == fe);
+        CHECK(mystl::find_end(bidi_iter<int>(p), bidi_iter<int>(pe), bidi_iter<int>(q), bidi_iter<int>(qe))
+              .base() - p == fe);
+        CHECK(mystl::find_end(forward_iter<int>(p), forward_iter<int>(pe),
+                              forward_iter<int>(q), forward_iter<int>(qe)).base() - p == fe);
+        CHECK(mystl::find_first_of(p, pe, q, qe) - p
+              == std::find_first_of(v.begin(), v.end(), pat.begin(), pat.end()) - v.begin());
+
+        std::vector<int> perm = v;
+        std::shuffle(perm.begin(), perm.end(), rng);
+        if(round % 3 == 0 && !perm.empty())
+            perm[0] += 1;
+        CHECK(mystl::is_permutation(p, pe, perm.data(), perm.data() + perm.size())
+              == std::is_permutation(v.begin(), v.end(), perm.begin(), perm.end()));
+    }
+}
+
+void test_merge() {
+    for(int round = 0; round < 200; ++round) {
+        std::vector<int> v = random_input<int>(rng() % 200, round % 2 == 0 ? 10 : 100000);
+        const size_t mid = v.empty() ? 0 : rng() % (v.size() + 1);
+        std::sort(v.begin(), v.begin() + mid);
+        std::sort(v.begin() + mid, v.end());
+        std::vector<int> expect = v;
+        std::inplace_merge(expect.begin(), expect.begin() + mid, expect.end());
+        std::vector<int> w = v;
+        mystl::inplace_merge(v.data(), v.data() + mid, v.data() + v.size());
+        CHECK(v == expect);
+        mystl::inplace_merge(w.data(), w.data() + mid, w.data() + w.size(), std::less<int>());
+        CHECK(w == expect);
+    }
+}
+
+void test_nth_element() {
+    for(int round = 0; round < 200; ++round) {
+        std::vector<std::string> v;
+        for(int value : random_input<int>(1 + rng() % 300, round % 2 == 0 ? 10 : 100000))
+            v.push_back(std::to_string(value));
+        std::vector<std::string> sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t nth = rng() % v.size();
+        std::string* p = v.data();
+        if(round % 2 == 0)
+            mystl::nth_element(p, p + nth, p + v.size());
+        else
+            mystl::nth_element(p, p + nth, p + v.size(), std::less<std::string>());
+        CHECK(v[nth] == sorted[nth]);
+        for(size_t i = 0; i < nth; ++i)
+            CHECK(!(v[nth] < v[i]));
+        for(size_t i = nth + 1; i < v.size(); ++i)
+            CHECK(!(v[i] < v[nth]));
+    }
+}
+
+void test_partial_sort() {
+    for(int round = 0; round < 200; ++round) {
+        std::vector<std::string> v;
+        for(int value : random_input<int>(rng() % 300, round % 2 == 0 ? 10 : 100000))
+            v.push_back(std::to_string(value));
+        std::vector<std::string> sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t mid = round % 5 == 0 ? 0 : rng() % (v.size() + 1);
+        std::string* p = v.data();
+        if(round % 2 == 0)
+            mystl::partial_sort(p, p + mid, p + v.size());
+        else
+            mystl::partial_sort(p, p + mid, p + v.size(), std::less<std::string>());
+        CHECK(std::equal(p, p + mid, sorted.begin()));
+        std::sort(v.begin(), v.end());
+        CHECK(v == sorted);
+    }
+}
+
+} // namespace
+
+int main() {
+    test_extremum<int8_t>();
+    test_extremum<uint8_t>();
+    test_extremum<int16_t>();
+    test_extremum<uint16_t>();
+    test_extremum<int32_t>();
+    test_extremum<uint32_t>();
+    test_extremum<int64_t>();
+    test_extremum<uint64_t>();
+    test_extremum<float>();
+    test_extremum<double>();
+    test_extremum_nan<float>();
+    test_extremum_nan<double>();
+    test_neighbors<int8_t>();
+    test_neighbors<uint8_t>();
+    test_neighbors<int16_t>();
+    test_neighbors<uint16_t>();
+    test_neighbors<int32_t>();
+    test_neighbors<uint32_t>();
+    test_neighbors<int64_t>();
+    test_neighbors<uint64_t>();
+    test_neighbors<float>();
+    test_neighbors<double>();
+    test_compaction<int8_t>();
+    test_compaction<int16_t>();
+    test_compaction<int32_t>();
+    test_compaction<uint32_t>();
+    test_compaction<int64_t>();
+    test_compaction<uint64_t>();
+    test_compaction<float>();
+    test_compaction<double>();
+    test_compress_kernels<int32_t>();
+    test_compress_kernels<uint32_t>();
+    test_compress_kernels<int64_t>();
+    test_compress_kernels<uint64_t>();
+    test_compress_kernels<float>();
+    test_compress_kernels<double>();
+    test_compaction_struct();
+    test_compaction_calls();
+    test_partition<int32_t>();
+    test_partition<double>();
+    test_partition_string();
+    test_parallel_partition();
+    test_search();
+    test_merge();
+    test_nth_element();
+    test_partial_sort();
+    std::printf("algo_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,388 @@
+// algobase.h 的正确性测试: 以 std 的同名算法为参照，比较随机输入上的结果
+// 可逐字节比较的指针区间走 memcmp / SIMD 快速路径，包装迭代器与浮点数走通用版本
+// copy / move 系列比较指针、连续包装迭代器与普通随机访问迭代器，包括重叠区间与不可按字节复制的类型
+// large_copy 与超过阈值的 copy 检查非临时存储的头尾处理，重叠的区间仍按 memmove 处理
+// fill_n / fill 覆盖 memset、AVX2 模式写入与非临时存储三条路径，并检查区间两侧没有被改写
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/algobase_test.cpp -o algobase_test
+//   ./algobase_test
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -DMYSTL_NO_SIMD -IMySTL test/algobase_test.cpp -o algobase_test_scalar
+//   ./algobase_test_scalar
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "algobase.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(29);
+
+/*****************************************************************************************/
+// equal / mismatch / lexicographical_compare
+/*****************************************************************************************/
+// b 为 a 的前缀 (长度随机) 并在随机位置改动一个元素，覆盖各个分块边界上的首个差异
+template <class T>
+void check_compare(const std::vector<T>& a, const std::vector<T>& b) {
+    const T* pa = a.data();
+    const T* pb = b.data();
+    const size_t n = std::min(a.size(), b.size());
+    CHECK(mystl::equal(pa, pa + n, pb) == std::equal(a.begin(), a.begin() + n, b.begin()));
+    const auto mm = mystl::mismatch(pa, pa + n, pb);
+    const auto expect = std::mismatch(a.begin(), a.begin() + n, b.begin());
+    CHECK(mm.first - pa == expect.first - a.begin());
+    CHECK(mm.second - pb == expect.second - b.begin());
+    const bool lc = std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    CHECK(mystl::lexicographical_compare(pa, pa + a.size(), pb, pb + b.size()) == lc);
+
+    using mystl_test::random_iter;
+    T* const qa = const_cast<T*>(pa);
+    T* const qb = const_cast<T*>(pb);
+    CHECK(mystl::lexicographical_compare(random_iter<T>(qa), random_iter<T>(qa + a.size()),
+                                         random_iter<T>(qb), random_iter<T>(qb + b.size())) == lc);
+    CHECK(mystl::mismatch(random_iter<T>(qa), random_iter<T>(qa + n), random_iter<T>(qb))
+          .first.base() - pa == expect.first - a.begin());
+}
+
+template <class T>
+void test_compare() {
+    for(int round = 0; round < 2000; ++round) {
+        const size_t n = round < 200 ? static_cast<size_t>(round) : rng() % 3000;
+        std::vector<T> a(n);
+        for(auto& x : a)
+            x = static_cast<T>(rng());
+        std::vector<T> b = a;
+        if(round % 5 != 0 && n > 0) {
+            const size_t i = rng() % n;
+            b[i] = static_cast<T>(b[i] + 1 + rng() % 3);
+            // 有符号类型让差异跨过符号位，检查字节比较对符号的处理
+            if(round % 7 == 0)
+                b[i] = static_cast<T>(a[i] < 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min());
+        }
+        if(round % 3 == 0)
+            b.resize(rng() % (n + 1));
+        check_compare(a, b);
+        check_compare(b, a);
+    }
+}
+
+void test_compare_float() {
+    // -0.0 与 0.0 相等、NaN 与任何值不等，浮点数保持逐个元素比较
+    const std::vector<double> a = {1.0, -0.0, 2.0, std::numeric_limits<double>::quiet_NaN()};
+    const std::vector<double> b = {1.0, 0.0, 2.0, std::numeric_limits<double>::quiet_NaN()};
+    CHECK(mystl::mismatch(a.data(), a.data() + 3, b.data()).first == a.data() + 3);
+    CHECK(mystl::equal(a.data(), a.data() + 3, b.data()));
+    CHECK(!mystl::equal(a.data(), a.data() + 4, b.data()));
+    CHECK(!mystl::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3));
+}
+
+/*****************************************************************************************/
+// fill_n / fill
+/*****************************************************************************************/
+struct rgb {
+    unsigned char r, g, b;
+    bool operator==(const rgb& rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+};
+
+struct quad {
+    int32_t a, b, c, d;
+    bool operator==(const quad& rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c && d == rhs.d; }
+};
+
+// 可平凡复制但不能赋值，不能走按字节写入的路径
+struct const_member {
+    const int x;
+};
+
+static_assert(mystl::is_wide_fill<int, int>::value, "");
+static_assert(mystl::is_wide_fill<double, int>::value, "");
+static_assert(mystl::is_wide_fill<quad, quad>::value, "");
+static_assert(!mystl::is_wide_fill<const int, int>::value, "");
+static_assert(!mystl::is_wide_fill<const_member, const_member>::value, "");
+
+// 在 buf 的 [off, off + n) 填充 value，检查区间内的值以及两侧的哨兵没有被改写
+template <class T, class U>
+void check_fill(size_t off, size_t n, const U& value, const T& guard) {
+    std::vector<T> buf(off + n + 40, guard);
+    const T expect = static_cast<T>(value);
+    T* end = mystl::fill_n(buf.data() + off, n, value);
+    CHECK(end == buf.data() + off + n);
+    for(size_t i = 0; i < buf.size(); ++i)
+        CHECK(std::memcmp(&buf[i], i >= off && i < off + n ? &expect : &guard, sizeof(T)) == 0);
+    std::fill(buf.begin(), buf.end(), guard);
+    mystl::fill(buf.data() + off, buf.data() + off + n, value);
+    for(size_t i = 0; i < buf.size(); ++i)
+        CHECK(std::memcmp(&buf[i], i >= off && i < off + n ? &expect : &guard, sizeof(T)) == 0);
+}
+
+template <class T>
+void test_fill_type(const T& value, const T& guard) {
+    // 长度覆盖不足 32 字节、不足一轮展开以及各种起始对齐
+    for(size_t n = 0; n < 100; ++n)
+        check_fill(n % 7, n, value, guard);
+    for(int round = 0; round < 20; ++round)
+        check_fill(rng() % 64, rng() % 5000, value, guard);
+}
+
+void test_fill() {
+    test_fill_type<int8_t>(-3, 7);
+    test_fill_type<uint16_t>(0x1234, 0);
+    test_fill_type<int32_t>(-1, 5);
+    test_fill_type<int32_t>(0x01020304, 0);
+    test_fill_type<uint64_t>(0x0101010101010101ull, 0);
+    test_fill_type<int64_t>(-123456789012345ll, 0);
+    test_fill_type<float>(1.5f, 0.0f);
+    test_fill_type<double>(-0.0, 1.0);
+    test_fill_type<rgb>(rgb{1, 2, 3}, rgb{9, 9, 9});
+    test_fill_type<quad>(quad{1, -2, 3, -4}, quad{0, 0, 0, 0});
+    test_fill_type<quad>(quad{0, 0, 0, 0}, quad{5, 5, 5, 5});
+    // 值与元素类型不同的算术类型先转换再写入
+    check_fill<int32_t>(3, 1000, 3.75, 0);
+    check_fill<double>(1, 1000, 7, 0.5);
+    check_fill<int16_t>(5, 1000, 'x', int16_t(0));
+    // 超过 kNonTemporalBytes 时使用非临时存储，起点不对齐
+    check_fill<int32_t>(3, mystl::kNonTemporalBytes / 4 + 13, 0x5a5a1234, 0);
+    check_fill<quad>(1, mystl::kNonTemporalBytes / 16 + 3, quad{7, 8, 9, 10}, quad{0, 0, 0, 0});
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= mystl::simd_avx2) {
+        unsigned char pat[64];
+        for(size_t i = 0; i < 64; ++i)
+            pat[i] = static_cast<unsigned char>(i % 8 + 1);
+        for(size_t bytes : {size_t(32), size_t(33), size_t(200), mystl::kNonTemporalBytes + 72}) {
+            std::vector<unsigned char> buf(bytes + 64, 0);
+            mystl::fill_pattern_avx2(buf.data() + 8, bytes, pat);
+            for(size_t i = 0; i < buf.size(); ++i)
+                CHECK(buf[i] == (i >= 8 && i < 8 + bytes ? static_cast<unsigned char>(i % 8 + 1) : 0));
+        }
+    }
+#endif
+}
+
+/*****************************************************************************************/
+// copy / copy_backward / copy_n / move / move_backward
+/*****************************************************************************************/
+struct pod12 {
+    int32_t a, b, c;
+    bool operator==(const pod12& rhs) const { return a == rhs.a && b == rhs.b && c == rhs.c; }
+};
+
+// 自定义了移动赋值，不可平凡复制，只能逐个移动
+struct counted_move {
+    int v;
+    static int moves;
+    counted_move(int x = 0) : v(x) {}
+    counted_move(const counted_move&) = default;
+    counted_move& operator=(const counted_move&) = default;
+    counted_move& operator=(counted_move&& rhs) { v = rhs.v; ++moves; return *this; }
+    bool operator==(const counted_move& rhs) const { return v == rhs.v; }
+};
+int counted_move::moves = 0;
+
+using mystl_test::contiguous_iter;
+using mystl_test::random_iter;
+static_assert(mystl::is_bitwise_copy<const int*, int*>::value, "");
+static_assert(mystl::is_bitwise_copy<contiguous_iter<pod12>, pod12*>::value, "");
+static_assert(!mystl::is_bitwise_copy<random_iter<int>, int*>::value, "");
+static_assert(!mystl::is_bitwise_copy<int*, long*>::value, "");
+static_assert(!mystl::is_bitwise_copy<std::string*, std::string*>::value, "");
+static_assert(!mystl::is_bitwise_copy<counted_move*, counted_move*>::value, "");
+static_assert(!mystl::is_bitwise_move<counted_move*, counted_move*>::value, "");
+
+template <class T>
+T make_value(size_t i) { return static_cast<T>(i * 2654435761u); }
+template <>
+pod12 make_value<pod12>(size_t i) { return pod12{int32_t(i), int32_t(i * 3), -int32_t(i)}; }
+template <>
+std::string make_value<std::string>(size_t i) { return std::to_string(i * 7919); }
+template <>
+counted_move make_value<counted_move>(size_t i) { return counted_move(static_cast<int>(i)); }
+
+// 在同一块缓冲区中以不同偏移复制，覆盖不重叠与向前、向后重叠的情况
+template <class T, class Iter>
+void check_copy_in(size_t n, ptrdiff_t shift) {
+    const size_t cap = n + 64;
+    std::vector<T> init(cap);
+    for(size_t i = 0; i < cap; ++i)
+        init[i] = make_value<T>(i);
+    const size_t src = 32;
+    const size_t dst = static_cast<size_t>(static_cast<ptrdiff_t>(src) + shift);
+    std::vector<T> buf = init, expect = init;
+    // 参照: 用临时副本复制，不受重叠影响
+    std::vector<T> tmp(init.begin() + src, init.begin() + src + n);
+    std::copy(tmp.begin(), tmp.end(), expect.begin() + dst);
+
+    // 向左 (shift <= 0) 用 copy，向右用 copy_backward，与标准的重叠要求一致
+    if(shift <= 0) {
+        Iter r = mystl::copy(Iter(buf.data() + src), Iter(buf.data() + src + n), Iter(buf.data() + dst));
+        CHECK(r == Iter(buf.data() + dst + n));
+        CHECK(buf == expect);
+        buf = init;
+        r = mystl::move(Iter(buf.data() + src), Iter(buf.data() + src + n), Iter(buf.data() + dst));
+        CHECK(r == Iter(buf.data() + dst + n));
+        if(!std::is_same<T, std::string>::value)
+            CHECK(buf == expect);
+    }
+    if(shift >= 0) {
+        buf = init;
+        Iter r = mystl::copy_backward(Iter(buf.data() + src), Iter(buf.data() + src + n),
+                                      Iter(buf.data() + dst + n));
+        CHECK(r == Iter(buf.data() + dst));
+        CHECK(buf == expect);
+        buf = init;
+        r = mystl::move_backward(Iter(buf.data() + src), Iter(buf.data() + src + n),
+                                 Iter(buf.data() + dst + n));
+        CHECK(r == Iter(buf.data() + dst));
+        if(!std::is_same<T, std::string>::value)
+            CHECK(buf == expect);
+    }
+    // 被移动的 string 处于有效但未指定的状态，移动到另一个区间后只检查目标区间
+    if(std::is_same<T, std::string>::value) {
+        buf = init;
+        std::vector<T> to(n);
+        mystl::move(Iter(buf.data() + src), Iter(buf.data() + src + n), Iter(to.data()));
+        CHECK(to == tmp);
+        buf = init;
+        mystl::move_backward(Iter(buf.data() + src), Iter(buf.data() + src + n), Iter(to.data() + n));
+        CHECK(to == tmp);
+    }
+
+    std::vector<T> out(n + 1, make_value<T>(12345));
+    auto r = mystl::copy_n(Iter(init.data() + src), n, Iter(out.data()));
+    CHECK(r.first == Iter(init.data() + src + n));
+    CHECK(r.second == Iter(out.data() + n));
+    CHECK(std::equal(tmp.begin(), tmp.end(), out.begin()));
+    CHECK(out[n] == make_value<T>(12345));
+}
+
+template <class T>
+void test_copy_type() {
+    for(size_t n : {size_t(0), size_t(1), size_t(5), size_t(31), size_t(1000)}) {
+        for(ptrdiff_t shift : {ptrdiff_t(-32), ptrdiff_t(-3), ptrdiff_t(0), ptrdiff_t(3), ptrdiff_t(32)}) {
+            check_copy_in<T, T*>(n, shift);
+            check_copy_in<T, contiguous_iter<T>>(n, shift);
+            check_copy_in<T, random_iter<T>>(n, shift);
+        }
+    }
+}
+
+void test_copy() {
+    test_copy_type<int32_t>();
+    test_copy_type<uint8_t>();
+    test_copy_type<double>();
+    test_copy_type<pod12>();
+    test_copy_type<std::string>();
+    test_copy_type<counted_move>();
+
+    // 源区间为 const，元素类型不同时逐个转换
+    const std::vector<int> src = {1, -2, 3, -4, 5};
+    std::vector<long> dst(5);
+    mystl::copy(src.data(), src.data() + src.size(), dst.data());
+    CHECK((dst == std::vector<long>{1, -2, 3, -4, 5}));
+
+    // 移动赋值不平凡时不能按字节复制
+    std::vector<counted_move> a(100), b(100);
+    counted_move::moves = 0;
+    mystl::move(a.data(), a.data() + a.size(), b.data());
+    CHECK(counted_move::moves == 100);
+    mystl::move_backward(a.data(), a.data() + a.size(), b.data() + b.size());
+    CHECK(counted_move::moves == 200);
+}
+
+/*****************************************************************************************/
+// large_copy 与超过 kNonTemporalBytes 的 copy
+/*****************************************************************************************/
+// dst 与 src 起点的对齐各不相同，检查复制的内容与目标区间两侧的哨兵
+void check_large_copy(size_t bytes, size_t src_off, size_t dst_off, bool explicit_stream) {
+    std::vector<unsigned char> src(bytes + 64), dst(bytes + 128, 0xee);
+    for(size_t i = 0; i < src.size(); ++i)
+        src[i] = static_cast<unsigned char>(i * 131 + (i >> 8));
+    unsigned char* r = explicit_stream
+        ? mystl::large_copy(src.data() + src_off, src.data() + src_off + bytes, dst.data() + dst_off)
+        : mystl::copy(src.data() + src_off, src.data() + src_off + bytes, dst.data() + dst_off);
+    CHECK(r == dst.data() + dst_off + bytes);
+    CHECK(std::memcmp(dst.data() + dst_off, src.data() + src_off, bytes) == 0);
+    for(size_t i = 0; i < dst_off; ++i)
+        CHECK(dst[i] == 0xee);
+    for(size_t i = dst_off + bytes; i < dst.size(); ++i)
+        CHECK(dst[i] == 0xee);
+}
+
+void test_large_copy() {
+    for(size_t bytes : {size_t(0), size_t(1), size_t(31), size_t(32), size_t(33), size_t(127),
+                        size_t(128), size_t(129), size_t(1000), size_t(4099)})
+        for(size_t off : {size_t(0), size_t(1), size_t(17), size_t(31)}) {
+            check_large_copy(bytes, off, (off * 7) % 32, true);
+            check_large_copy(bytes, off, (off * 7) % 32, false);
+        }
+    // 超过阈值时 copy 也使用非临时存储
+    check_large_copy(mystl::kNonTemporalBytes + 77, 3, 5, false);
+    check_large_copy(mystl::kNonTemporalBytes + 77, 0, 0, true);
+
+    // 重叠的大区间退回 memmove，copy / copy_backward 的语义不变
+    const size_t n = mystl::kNonTemporalBytes / sizeof(int32_t) + 1000;
+    std::vector<int32_t> v(n + 100);
+    for(size_t i = 0; i < v.size(); ++i)
+        v[i] = static_cast<int32_t>(i);
+    mystl::copy(v.data() + 100, v.data() + 100 + n, v.data());
+    for(size_t i = 0; i < n; ++i)
+        CHECK(v[i] == static_cast<int32_t>(i + 100));
+    for(size_t i = 0; i < v.size(); ++i)
+        v[i] = static_cast<int32_t>(i);
+    mystl::copy_backward(v.data(), v.data() + n, v.data() + 100 + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(v[i + 100] == static_cast<int32_t>(i));
+
+    // 结构体与包装迭代器走同样的路径，不可按字节复制时按 copy 处理
+    std::vector<pod12> a(5000), b(5000);
+    for(size_t i = 0; i < a.size(); ++i)
+        a[i] = make_value<pod12>(i);
+    mystl::large_copy(contiguous_iter<pod12>(a.data()), contiguous_iter<pod12>(a.data() + a.size()),
+                      contiguous_iter<pod12>(b.data()));
+    CHECK(a == b);
+    std::vector<std::string> s(100), t(100);
+    for(size_t i = 0; i < s.size(); ++i)
+        s[i] = make_value<std::string>(i);
+    CHECK(mystl::large_copy(s.data(), s.data() + s.size(), t.data()) == t.data() + t.size());
+    CHECK(s == t);
+
+#ifdef MYSTL_SIMD_X86
+    if(mystl::simd_level() >= mystl::simd_avx2) {
+        for(size_t bytes = 32; bytes < 300; bytes += 7) {
+            std::vector<unsigned char> src(bytes + 32), dst(bytes + 64, 0);
+            for(size_t i = 0; i < src.size(); ++i)
+                src[i] = static_cast<unsigned char>(i + 1);
+            mystl::stream_copy_avx2(dst.data() + bytes % 32, src.data() + bytes % 13, bytes);
+            CHECK(std::memcmp(dst.data() + bytes % 32, src.data() + bytes % 13, bytes) == 0);
+            CHECK(dst[bytes % 32 + bytes] == 0);
+        }
+    }
+#endif
+}
+
+} // namespace
+
+int main() {
+    test_compare<int8_t>();
+    test_compare<uint8_t>();
+    test_compare<char>();
+    test_compare<int16_t>();
+    test_compare<uint16_t>();
+    test_compare<int32_t>();
+    test_compare<uint32_t>();
+    test_compare<int64_t>();
+    test_compare<uint64_t>();
+    test_compare_float();
+    test_fill();
+    test_copy();
+    test_large_copy();
+    std::printf("algobase_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,263 @@
+// execution.h 的正确性测试: seq / par / par_unseq 三种策略下的各算法与 std 的串行结果比较
+// 区间长度覆盖不分块、分块以及块数多于线程数的情况，accumulate 与各种扫描使用不可交换的运算检查合并顺序
+// 单核机器上也应指定多个线程，使线程池的路径能执行到，并分别在 ASan 与 TSan 下运行
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -pthread -fsanitize=address,undefined -DMYSTL_PARALLEL_THREADS=4 -IMySTL test/execution_test.cpp -o execution_test_asan
+//   ./execution_test_asan
+//   g++ -std=c++17 -O1 -g -pthread -fsanitize=thread -DMYSTL_PARALLEL_THREADS=4 -IMySTL test/execution_test.cpp -o execution_test_tsan
+//   ./execution_test_tsan
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "execution.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(33);
+
+const size_t kSizes[] = {0, 1, 1000, mystl::kParallelGrain * 3 + 17, mystl::kParallelGrain * 40 + 5};
+
+template <class Policy>
+void test_policy(Policy policy) {
+    for(size_t n : kSizes) {
+        std::vector<int> v(n);
+        for(auto& x : v)
+            x = static_cast<int>(rng() % 1000);
+        int* const p = v.data();
+        int* const pe = p + n;
+
+        std::vector<int> w = v;
+        mystl::for_each(policy, w.data(), w.data() + n, [](int& x) { x *= 3; });
+        for(size_t i = 0; i < n; ++i)
+            CHECK(w[i] == v[i] * 3);
+
+        std::vector<int> out(n);
+        CHECK(mystl::transform(policy, p, pe, out.data(), [](int x) { return x + 1; }) == out.data() + n);
+        for(size_t i = 0; i < n; ++i)
+            CHECK(out[i] == v[i] + 1);
+        CHECK(mystl::transform(policy, p, pe, w.data(), w.data() + n, out.data(), std::minus<int>())
+              == out.data() + n);
+        for(size_t i = 0; i < n; ++i)
+            CHECK(out[i] == v[i] - w[i]);
+
+        CHECK(mystl::count(policy, p, pe, 7) == static_cast<size_t>(std::count(v.begin(), v.end(), 7)));
+        CHECK(mystl::count_if(policy, p, pe, [](int x) { return x < 100; })
+              == static_cast<size_t>(std::count_if(v.begin(), v.end(), [](int x) { return x < 100; })));
+
+        // 查找最后一个元素与不存在的元素，检查提前结束的块不会跳过更靠前的结果
+        for(int target : {n ? v[n - 1] : 0, 1000, n ? v[n / 2] : 0}) {
+            CHECK(mystl::find(policy, p, pe, target) - p == std::find(v.begin(), v.end(), target) - v.begin());
+            CHECK(mystl::find_if(policy, p, pe, [target](int x) { return x == target; }) - p
+                  == std::find(v.begin(), v.end(), target) - v.begin());
+        }
+
+        mystl::fill(policy, out.data(), out.data() + n, 42);
+        CHECK(std::count(out.begin(), out.end(), 42) == static_cast<ptrdiff_t>(n));
+        CHECK(mystl::copy(policy, p, pe, out.data()) == out.data() + n);
+        CHECK(out == v);
+
+        CHECK(mystl::accumulate(policy, p, pe, int64_t(5)) == std::accumulate(v.begin(), v.end(), int64_t(5)));
+        // 可结合但不可交换: 各块的结果必须按块的顺序合并
+        std::vector<std::string> s(n < 5000 ? n : 5000 + n % 7);
+        for(size_t i = 0; i < s.size(); ++i)
+            s[i] = std::string(1, static_cast<char>('a' + v[i] % 26));
+        CHECK(mystl::accumulate(policy, s.data(), s.data() + s.size(), std::string("^"), std::plus<std::string>())
+              == std::accumulate(s.begin(), s.end(), std::string("^")));
+
+        std::vector<int> expect = v;
+        std::sort(expect.begin(), expect.end());
+        w = v;
+        mystl::sort(policy, w.data(), w.data() + n);
+        CHECK(w == expect);
+        std::sort(expect.begin(), expect.end(), std::greater<int>());
+        w = v;
+        mystl::sort(policy, w.data(), w.data() + n, std::greater<int>());
+        CHECK(w == expect);
+    }
+}
+
+// 单趟分片前缀和 (整型加法) 与两趟分块扫描 (其他类型与运算)
+template <class Policy>
+void test_scans(Policy policy) {
+    const size_t sizes[] = {0, 1, 1000, mystl::kParallelScanTile * 2, mystl::kParallelScanTile * 21 + 9};
+    for(size_t n : sizes) {
+        std::vector<int64_t> v(n);
+        for(auto& x : v)
+            x = static_cast<int64_t>(rng() % 2000) - 1000;
+        const int64_t* const p = v.data();
+        std::vector<int64_t> out(n), expect(n);
+
+        std::partial_sum(v.begin(), v.end(), expect.begin());
+        CHECK(mystl::inclusive_scan(policy, p, p + n, out.data()) == out.data() + n);
+        CHECK(out == expect);
+        std::exclusive_scan(v.begin(), v.end(), expect.begin(), int64_t(7));
+        CHECK(mystl::exclusive_scan(policy, p, p + n, out.data(), int64_t(7)) == out.data() + n);
+        CHECK(out == expect);
+        out = v;
+        mystl::exclusive_scan(policy, out.data(), out.data() + n, out.data(), int64_t(7));
+        CHECK(out == expect);
+
+        auto sq = [](int64_t x) { return x * x; };
+        std::transform_inclusive_scan(v.begin(), v.end(), expect.begin(), std::plus<int64_t>(), sq);
+        mystl::transform_inclusive_scan(policy, p, p + n, out.data(), std::plus<int64_t>(), sq);
+        CHECK(out == expect);
+        std::transform_inclusive_scan(v.begin(), v.end(), expect.begin(), std::plus<int64_t>(), sq, int64_t(3));
+        mystl::transform_inclusive_scan(policy, p, p + n, out.data(), std::plus<int64_t>(), sq, int64_t(3));
+        CHECK(out == expect);
+        std::transform_exclusive_scan(v.begin(), v.end(), expect.begin(), int64_t(3), std::plus<int64_t>(), sq);
+        mystl::transform_exclusive_scan(policy, p, p + n, out.data(), int64_t(3), std::plus<int64_t>(), sq);
+        CHECK(out == expect);
+
+        // 可结合但不可交换的运算: 2x2 矩阵乘法取模，用 int64_t 编码四个 8 位元素
+        auto mul = [](int64_t a, int64_t b) {
+            int64_t r = 0;
+            for(int i = 0; i < 2; ++i)
+                for(int j = 0; j < 2; ++j) {
+                    int64_t c = 0;
+                    for(int k = 0; k < 2; ++k)
+                        c += ((a >> ((i * 2 + k) * 8)) & 0xff) * ((b >> ((k * 2 + j) * 8)) & 0xff);
+                    r |= (c % 251) << ((i * 2 + j) * 8);
+                }
+            return r;
+        };
+        std::vector<int64_t> m(n);
+        for(auto& x : m)
+            x = static_cast<int64_t>(rng() & 0xffffffff) % (int64_t(1) << 31);
+        std::inclusive_scan(m.begin(), m.end(), expect.begin(), mul);
+        mystl::inclusive_scan(policy, m.data(), m.data() + n, out.data(), mul);
+        CHECK(out == expect);
+        std::exclusive_scan(m.begin(), m.end(), expect.begin(), int64_t(0x01000001), mul);
+        mystl::exclusive_scan(policy, m.data(), m.data() + n, out.data(), int64_t(0x01000001), mul);
+        CHECK(out == expect);
+
+        // int32_t 加法走单趟前缀和，double 走两趟扫描 (输入为整数值，结果与结合顺序无关)
+        std::vector<int32_t> w(n), wout(n), wexpect(n);
+        for(auto& x : w)
+            x = static_cast<int32_t>(rng() % 100);
+        std::inclusive_scan(w.begin(), w.end(), wexpect.begin(), std::plus<int32_t>(), int32_t(-5));
+        mystl::inclusive_scan(policy, w.data(), w.data() + n, wout.data(), mystl::plus<int32_t>(), int32_t(-5));
+        CHECK(wout == wexpect);
+        std::vector<double> d(w.begin(), w.end()), dout(n), dexpect(n);
+        std::partial_sum(d.begin(), d.end(), dexpect.begin());
+        mystl::inclusive_scan(policy, d.data(), d.data() + n, dout.data());
+        CHECK(dout == dexpect);
+    }
+}
+
+// reduce 与 transform_reduce: 整型结果精确，浮点数输入为 1/8 的整数倍且和不大，任意结合顺序下也是精确的
+// 补偿版本用大数与其相反数相互抵消的病态输入，各块的 (和, 误差) 合并后仍应得到精确值
+template <class Policy>
+void test_reductions(Policy policy) {
+    for(size_t n : kSizes) {
+        std::vector<int64_t> v(n);
+        std::vector<double> d(n), e(n);
+        for(size_t i = 0; i < n; ++i) {
+            v[i] = static_cast<int64_t>(rng() % 2000) - 1000;
+            d[i] = static_cast<double>(v[i]) / 8.0;
+            e[i] = static_cast<double>(rng() % 64) / 8.0;
+        }
+        const int64_t* const p = v.data();
+        CHECK(mystl::reduce(policy, p, p + n) == std::accumulate(v.begin(), v.end(), int64_t(0)));
+        CHECK(mystl::reduce(policy, p, p + n, int64_t(9)) == std::accumulate(v.begin(), v.end(), int64_t(9)));
+        CHECK(mystl::reduce(policy, p, p + n, int64_t(1), [](int64_t x, int64_t y) { return x ^ y; })
+              == std::accumulate(v.begin(), v.end(), int64_t(1), [](int64_t x, int64_t y) { return x ^ y; }));
+        CHECK(mystl::transform_reduce(policy, p, p + n, p, int64_t(0))
+              == std::inner_product(v.begin(), v.end(), v.begin(), int64_t(0)));
+        CHECK(mystl::transform_reduce(policy, p, p + n, int64_t(0), mystl::plus<int64_t>(),
+                                      [](int64_t x) { return x < 0 ? -x : x; })
+              == std::accumulate(v.begin(), v.end(), int64_t(0),
+                                 [](int64_t s, int64_t x) { return s + (x < 0 ? -x : x); }));
+
+        CHECK(mystl::reduce(policy, d.data(), d.data() + n, 0.5)
+              == std::accumulate(d.begin(), d.end(), 0.5));
+        CHECK(mystl::transform_reduce(policy, d.data(), d.data() + n, e.data(), 0.0)
+              == std::inner_product(d.begin(), d.end(), e.begin(), 0.0));
+
+        std::vector<double> a, x, y;
+        long long small = 0;
+        for(size_t i = 0; i < n / 2; ++i) {
+            const double big = static_cast<double>(rng() % (uint64_t(1) << 50)) / 8.0;
+            a.push_back(big);
+            a.push_back(-big);
+            const double fx = static_cast<double>(rng() % (uint64_t(1) << 30)) / 8.0;
+            const double fy = static_cast<double>(rng() % (uint64_t(1) << 30)) / 8.0;
+            x.push_back(fx);
+            y.push_back(fy);
+            x.push_back(-fx);
+            y.push_back(fy);
+            if(i % 64 == 0) {
+                a.push_back(1.0);
+                x.push_back(1.0);
+                y.push_back(1.0);
+                ++small;
+            }
+        }
+        for(size_t i = a.size(); i > 1; --i)
+            std::swap(a[i - 1], a[rng() % i]);
+        for(size_t i = x.size(); i > 1; --i) {
+            const size_t j = rng() % i;
+            std::swap(x[i - 1], x[j]);
+            std::swap(y[i - 1], y[j]);
+        }
+        CHECK(mystl::compensated_reduce(policy, a.data(), a.data() + a.size(), 0.0)
+              == static_cast<double>(small));
+        CHECK(mystl::compensated_transform_reduce(policy, x.data(), x.data() + x.size(), y.data(), 0.0)
+              == static_cast<double>(small));
+    }
+}
+
+// 总字节数超过 kNonTemporalBytes 时各块使用非临时存储，large_copy 不论长短都使用
+template <class Policy>
+void test_large_copy(Policy policy) {
+    for(size_t n : {size_t(0), size_t(1000), mystl::kParallelGrain * 5 + 3,
+                    mystl::kNonTemporalBytes / sizeof(int32_t) + 12345}) {
+        std::vector<int32_t> v(n + 1), out(n + 2, -1);
+        for(size_t i = 0; i < v.size(); ++i)
+            v[i] = static_cast<int32_t>(i * 2654435761u);
+        CHECK(mystl::copy(policy, v.data() + 1, v.data() + 1 + n, out.data() + 1) == out.data() + 1 + n);
+        CHECK(std::equal(v.begin() + 1, v.end(), out.begin() + 1));
+        CHECK(out[0] == -1 && out[n + 1] == -1);
+        std::fill(out.begin(), out.end(), -1);
+        CHECK(mystl::large_copy(policy, v.data(), v.data() + n, out.data() + 1) == out.data() + 1 + n);
+        CHECK(std::equal(v.begin(), v.begin() + n, out.begin() + 1));
+        CHECK(out[0] == -1 && out[n + 1] == -1);
+    }
+}
+
+void test_sort_strings() {
+    std::vector<std::string> v(mystl::kParallelSortGrain * 9 + 3);
+    for(auto& x : v)
+        x = std::to_string(rng() % 100000);
+    std::vector<std::string> expect = v;
+    std::sort(expect.begin(), expect.end());
+    mystl::sort(mystl::execution::par, v.data(), v.data() + v.size());
+    CHECK(v == expect);
+}
+
+} // namespace
+
+int main() {
+    test_policy(mystl::execution::seq);
+    test_policy(mystl::execution::par);
+    test_policy(mystl::execution::par_unseq);
+    test_scans(mystl::execution::seq);
+    test_scans(mystl::execution::par);
+    test_scans(mystl::execution::par_unseq);
+    test_reductions(mystl::execution::seq);
+    test_reductions(mystl::execution::par);
+    test_reductions(mystl::execution::par_unseq);
+    test_large_copy(mystl::execution::seq);
+    test_large_copy(mystl::execution::par);
+    test_large_copy(mystl::execution::par_unseq);
+    test_sort_strings();
+    std::printf("execution_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+// heap_algo.h 的正确性测试: 二叉堆与 d 叉堆的建堆、插入、弹出与排序
+// 以 std:: 的排序结果为参照，覆盖 less/greater、字符串键与只声明随机访问的迭代器
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/heap_algo_test.cpp -o heap_algo_test
+//   ./heap_algo_test
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "heap_algo.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(41);
+
+// 按 D 的二叉堆版本: D == 0 表示使用 push_heap 等二叉堆算法
+template <size_t D>
+struct heap_ops {
+    template <class It, class C> static void make(It f, It l, C c) { mystl::make_dary_heap<D>(f, l, c); }
+    template <class It, class C> static void push(It f, It l, C c) { mystl::push_dary_heap<D>(f, l, c); }
+    template <class It, class C> static void pop(It f, It l, C c) { mystl::pop_dary_heap<D>(f, l, c); }
+    template <class It, class C> static void sort(It f, It l, C c) { mystl::sort_dary_heap<D>(f, l, c); }
+    template <class It, class C> static bool is_heap(It f, It l, C c) { return mystl::is_dary_heap<D>(f, l, c); }
+};
+
+template <>
+struct heap_ops<0> {
+    template <class It, class C> static void make(It f, It l, C c) { mystl::make_heap(f, l, c); }
+    template <class It, class C> static void push(It f, It l, C c) { mystl::push_heap(f, l, c); }
+    template <class It, class C> static void pop(It f, It l, C c) { mystl::pop_heap(f, l, c); }
+    template <class It, class C> static void sort(It f, It l, C c) { mystl::sort_heap(f, l, c); }
+    template <class It, class C> static bool is_heap(It f, It l, C c) { return std::is_heap(f, l, c); }
+};
+
+template <size_t D, class T, class Comp>
+void check_heap(const std::vector<T>& src, Comp comp) {
+    typedef heap_ops<D> ops;
+    std::vector<T> want = src;
+    std::sort(want.begin(), want.end(), comp);
+
+    // make + sort
+    std::vector<T> v = src;
+    ops::make(v.data(), v.data() + v.size(), comp);
+    CHECK(ops::is_heap(v.data(), v.data() + v.size(), comp));
+    ops::sort(v.data(), v.data() + v.size(), comp);
+    CHECK(v == want);
+
+    // 逐个 push，再逐个 pop，弹出的序列从大到小
+    v.clear();
+    for(const T& x : src) {
+        v.push_back(x);
+        ops::push(v.data(), v.data() + v.size(), comp);
+        CHECK(ops::is_heap(v.data(), v.data() + v.size(), comp));
+    }
+    for(size_t n = v.size(); n > 0; --n) {
+        ops::pop(v.data(), v.data() + n, comp);
+        CHECK(ops::is_heap(v.data(), v.data() + (n - 1), comp));
+    }
+    CHECK(v == want);
+
+    // 只声明随机访问的迭代器
+    typedef mystl_test::random_iter<T> rit;
+    v = src;
+    ops::make(rit(v.data()), rit(v.data() + v.size()), comp);
+    CHECK(ops::is_heap(v.data(), v.data() + v.size(), comp));
+    ops::sort(rit(v.data()), rit(v.data() + v.size()), comp);
+    CHECK(v == want);
+}
+
+// 交替 pop 与 push，模拟调度队列: 取出最早的事件并以更晚的时间重新插入
+template <size_t D>
+void check_hold(size_t n) {
+    typedef heap_ops<D> ops;
+    std::greater<uint64_t> comp;
+    std::vector<uint64_t> v(n);
+    for(auto& x : v)
+        x = rng() % 1000;
+    std::multiset<uint64_t> ref(v.data(), v.data() + v.size());
+    ops::make(v.data(), v.data() + v.size(), comp);
+    for(int round = 0; round < 2000; ++round) {
+        ops::pop(v.data(), v.data() + v.size(), comp);
+        CHECK(v.back() == *ref.begin());
+        ref.erase(ref.begin());
+        v.back() += 1 + rng() % 500;
+        ref.insert(v.back());
+        ops::push(v.data(), v.data() + v.size(), comp);
+    }
+    CHECK(ops::is_heap(v.data(), v.data() + v.size(), comp));
+}
+
+template <size_t D>
+void check_arity() {
+    for(size_t n : {size_t(0), size_t(1), size_t(2), size_t(3), size_t(D), size_t(D + 1),
+                    size_t(D * D + 1), size_t(100), size_t(1000)}) {
+        std::vector<int> ints(n);
+        for(auto& x : ints)
+            x = static_cast<int>(rng() % (n + 1)) - static_cast<int>(n / 2);
+        check_heap<D>(ints, std::less<int>());
+        check_heap<D>(ints, std::greater<int>());
+
+        std::vector<std::string> strs(n);
+        for(auto& s : strs)
+            s = std::string(rng() % 20, 'k') + std::to_string(rng() % 50);
+        check_heap<D>(strs, std::less<std::string>());
+    }
+    check_hold<D>(1);
+    check_hold<D>(257);
+}
+
+// 自底向上的调整每层只比较两个子节点，sort_heap 的比较次数约为 n log2(n)，
+// 自顶向下的调整每层还要与 value 比较，约为 2 n log2(n)
+void check_compare_count() {
+    const size_t n = 1 << 14;
+    std::vector<std::string> v(n);
+    for(auto& s : v)
+        s = "key" + std::to_string(rng() % 100000);
+    size_t compares = 0;
+    auto comp = [&](const std::string& a, const std::string& b) { ++compares; return a < b; };
+    mystl::make_heap(v.data(), v.data() + n, comp);
+    compares = 0;
+    mystl::sort_heap(v.data(), v.data() + n, comp);
+    CHECK(std::is_sorted(v.begin(), v.end()));
+    CHECK(compares < n * 16);                     // log2(n) = 14
+}
+
+// 堆算法沿路径移动元素，只能移动的类型也可以使用
+void check_move_only() {
+    typedef std::unique_ptr<int> ptr;
+    auto comp = [](const ptr& a, const ptr& b) { return *a < *b; };
+    std::vector<ptr> v;
+    for(int i = 0; i < 200; ++i) {
+        v.push_back(ptr(new int(static_cast<int>(rng() % 1000))));
+        mystl::push_heap(v.data(), v.data() + v.size(), comp);
+    }
+    mystl::pop_heap(v.data(), v.data() + v.size(), comp);
+    CHECK(*v.back() == **std::max_element(v.begin(), v.end(), comp));
+    mystl::make_heap(v.data(), v.data() + v.size(), comp);
+    mystl::sort_heap(v.data(), v.data() + v.size(), comp);
+    CHECK(std::is_sorted(v.begin(), v.end(), comp));
+    for(const ptr& p : v)
+        CHECK(p != nullptr);
+}
+
+} // namespace
+
+int main() {
+    check_arity<0>();
+    check_arity<2>();
+    check_arity<3>();
+    check_arity<4>();
+    check_arity<8>();
+
+    check_compare_count();
+    check_move_only();
+
+    // 默认比较
+    std::vector<int> v{5, 1, 9, 3, 7, 2, 8};
+    mystl::make_dary_heap<4>(v.data(), v.data() + v.size());
+    CHECK(mystl::is_dary_heap<4>(v.data(), v.data() + v.size()));
+    CHECK(v[0] == 9);
+    mystl::sort_dary_heap<4>(v.data(), v.data() + v.size());
+    CHECK(std::is_sorted(v.data(), v.data() + v.size()));
+    std::printf("heap_algo_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,248 @@
+// indexed_priority_queue.h 的正确性测试
+// 随机交替 push、pop、erase、update、increase_key、decrease_key，与按句柄记录的参照表比较，
+// 每步检查位置表与句柄表一致、键满足 d 叉堆的性质；另测复制、移动、swap、句柄回收与异常安全
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/indexed_priority_queue_test.cpp -o indexed_priority_queue_test
+//   ./indexed_priority_queue_test
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "indexed_priority_queue.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(43);
+
+// 队列中的元素与参照表 ref (句柄 -> 值) 一致，且 top 为参照表中优先级最高的值
+template <class Q, class Comp>
+void check_queue(const Q& q, const std::map<size_t, typename Q::value_type>& ref, Comp comp) {
+    CHECK(q.size() == ref.size());
+    CHECK(q.empty() == ref.empty());
+    for(const auto& kv : ref) {
+        CHECK(q.contains(kv.first));
+        CHECK(q.value(kv.first) == kv.second);
+    }
+    if(!ref.empty()) {
+        auto best = ref.begin();
+        for(auto it = ref.begin(); it != ref.end(); ++it)
+            if(comp(best->second, it->second))
+                best = it;
+        CHECK(!comp(q.top(), best->second) && !comp(best->second, q.top()));
+        CHECK(q.value(q.top_handle()) == q.top());
+    }
+}
+
+template <size_t D, class T, class Comp, class Make>
+void check_random_ops(Comp comp, Make make) {
+    typedef mystl::indexed_priority_queue<T, Comp, D> queue;
+    queue q(comp);
+    std::map<size_t, T> ref;
+    std::vector<size_t> handles;     // 曾经分配过的句柄，包括已删除的
+    for(int step = 0; step < 4000; ++step) {
+        const int op = static_cast<int>(rng() % 10);
+        if(op < 4 || ref.empty()) {
+            const T v = make();
+            const size_t h = op == 0 ? q.emplace(v) : q.push(v);
+            CHECK(ref.count(h) == 0);
+            ref[h] = v;
+            handles.push_back(h);
+        }
+        else if(op == 4) {
+            const size_t h = q.top_handle();
+            CHECK(ref.count(h) == 1);
+            q.pop();
+            ref.erase(h);
+            CHECK(!q.contains(h));
+        }
+        else {
+            auto it = ref.begin();
+            std::advance(it, rng() % ref.size());
+            const size_t h = it->first;
+            const T v = make();
+            if(op == 5) {
+                q.erase(h);
+                ref.erase(it);
+                CHECK(!q.contains(h));
+            }
+            else if(op < 8) {
+                q.update(h, v);
+                it->second = v;
+            }
+            else if(!comp(v, it->second)) {
+                q.increase_key(h, v);
+                it->second = v;
+            }
+            else {
+                q.decrease_key(h, v);
+                it->second = v;
+            }
+        }
+        if(step % 37 == 0 || q.size() < 10)
+            check_queue(q, ref, comp);
+    }
+    check_queue(q, ref, comp);
+
+    // 复制与移动后句柄保持有效
+    queue copy(q);
+    check_queue(copy, ref, comp);
+    queue moved(mystl::move(copy));
+    check_queue(moved, ref, comp);
+    CHECK(copy.empty());
+    queue assigned;
+    assigned = moved;
+    check_queue(assigned, ref, comp);
+    queue other(comp);
+    other.push(make());
+    mystl::swap(other, assigned);
+    check_queue(other, ref, comp);
+    CHECK(assigned.size() == 1);
+
+    // 按优先级顺序弹出全部元素
+    std::vector<T> want;
+    for(const auto& kv : ref)
+        want.push_back(kv.second);
+    std::sort(want.begin(), want.end(), [&](const T& a, const T& b) { return comp(b, a); });
+    std::vector<T> got;
+    while(!q.empty()) {
+        got.push_back(q.top());
+        q.pop();
+    }
+    CHECK(got.size() == want.size());
+    for(size_t i = 0; i < got.size(); ++i)
+        CHECK(!comp(got[i], want[i]) && !comp(want[i], got[i]));
+    for(size_t h : handles)
+        CHECK(!q.contains(h));
+
+    q.clear();
+    CHECK(q.empty() && q.capacity() > 0);
+    CHECK(q.push(make()) == 0);
+}
+
+// 句柄在删除后被回收，push 不会得到仍在队列中的句柄
+void test_handle_reuse() {
+    mystl::indexed_priority_queue<int> q;
+    const size_t a = q.push(1), b = q.push(2), c = q.push(3);
+    CHECK(a != b && b != c && a != c);
+    q.erase(b);
+    const size_t d = q.push(4);
+    CHECK(d == b);
+    CHECK(q.top_handle() == d && q.top() == 4);
+    q.reserve(1000);
+    CHECK(q.capacity() >= 1000);
+    CHECK(q.value(a) == 1 && q.value(c) == 3);
+    CHECK(!q.contains(12345));
+}
+
+// 作为最小堆的 Dijkstra，与朴素 O(n^2) 的实现比较
+void test_dijkstra() {
+    const uint32_t n = 300;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> adj(n);
+    for(uint32_t u = 0; u < n; ++u)
+        for(int k = 0; k < 5; ++k)
+            adj[u].push_back({static_cast<uint32_t>(rng() % n), static_cast<uint32_t>(1 + rng() % 100)});
+    const uint64_t inf = ~uint64_t(0);
+
+    std::vector<uint64_t> naive(n, inf);
+    std::vector<bool> done(n, false);
+    naive[0] = 0;
+    for(uint32_t round = 0; round < n; ++round) {
+        uint32_t u = n;
+        for(uint32_t v = 0; v < n; ++v)
+            if(!done[v] && naive[v] != inf && (u == n || naive[v] < naive[u]))
+                u = v;
+        if(u == n)
+            break;
+        done[u] = true;
+        for(auto e : adj[u])
+            naive[e.first] = std::min(naive[e.first], naive[u] + e.second);
+    }
+
+    typedef std::pair<uint64_t, uint32_t> item;
+    struct later {
+        bool operator()(const item& a, const item& b) const { return a.first > b.first; }
+    };
+    mystl::indexed_priority_queue<item, later, 4> q;
+    std::vector<uint64_t> dist(n, inf);
+    std::vector<size_t> handle(n, q.npos);
+    dist[0] = 0;
+    handle[0] = q.push(item(0, 0));
+    while(!q.empty()) {
+        const uint32_t u = q.top().second;
+        q.pop();
+        handle[u] = q.npos;
+        for(auto e : adj[u]) {
+            const uint64_t d = dist[u] + e.second;
+            if(d < dist[e.first]) {
+                dist[e.first] = d;
+                if(handle[e.first] != q.npos)
+                    q.increase_key(handle[e.first], item(d, e.first));   // 距离变小即优先级升高
+                else
+                    handle[e.first] = q.push(item(d, e.first));
+            }
+        }
+    }
+    CHECK(dist == naive);
+}
+
+// 构造元素时抛出异常，队列保持不变，句柄被回收
+struct thrower {
+    int v;
+    static int throw_at;
+    thrower(int x = 0) : v(x) {}
+    thrower(const thrower& rhs) : v(rhs.v) {
+        if(throw_at > 0 && --throw_at == 0)
+            throw 43;
+    }
+    thrower(thrower&&) = default;
+    thrower& operator=(const thrower&) = default;
+    thrower& operator=(thrower&&) = default;
+    bool operator<(const thrower& rhs) const { return v < rhs.v; }
+};
+int thrower::throw_at = 0;
+
+void test_exception() {
+    mystl::indexed_priority_queue<thrower> q;
+    for(int i = 0; i < 20; ++i)
+        q.push(thrower(i));
+    const thrower t(100);
+    thrower::throw_at = 1;
+    bool thrown = false;
+    try {
+        q.push(t);
+    }
+    catch(int) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(q.size() == 20 && q.top().v == 19);
+    CHECK(q.push(thrower(50)) == 20);     // 抛出异常时取得的句柄已回收
+    CHECK(q.top().v == 50);
+}
+
+} // namespace
+
+int main() {
+    auto small = [] { return static_cast<int>(rng() % 100); };
+    auto wide = [] { return static_cast<int>(rng() % 1000000); };
+    auto str = [] { return std::string(rng() % 20, 'x') + std::to_string(rng() % 500); };
+    check_random_ops<2, int>(std::less<int>(), small);
+    check_random_ops<2, int>(std::greater<int>(), wide);
+    check_random_ops<3, int>(std::less<int>(), wide);
+    check_random_ops<4, int>(std::greater<int>(), small);
+    check_random_ops<8, int>(std::less<int>(), wide);
+    check_random_ops<2, std::string>(std::less<std::string>(), str);
+    check_random_ops<4, std::string>(std::greater<std::string>(), str);
+    test_handle_reuse();
+    test_dijkstra();
+    test_exception();
+    std::printf("indexed_priority_queue_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,389 @@
+// numeric.h 的正确性测试: 以逐个元素计算的结果为参照，比较各种前缀扫描与 partial_sum
+// 4 / 8 字节整型的加法走向量化前缀和，溢出按模回绕；其余类型与运算走通用版本
+// 当前 CPU 支持 AVX2 时，向量内核另外单独比较一次 (长度覆盖不足一个向量的尾部)
+// iota / adjacent_difference / delta_encode / delta_decode 覆盖整型极值的回绕与从 -0.0 开始的 iota
+// 浮点归约以 long double 的结果为参照检查误差，补偿版本在病态输入上应得到精确结果
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/numeric_test.cpp -o numeric_test
+//   ./numeric_test
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -DMYSTL_NO_SIMD -IMySTL test/numeric_test.cpp -o numeric_test_scalar
+//   ./numeric_test_scalar
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "numeric.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(35);
+
+// 按无符号数计算的参照前缀和，与有符号整数的回绕结果一致
+template <class T>
+std::vector<T> expect_prefix(const std::vector<T>& a, T init, bool exclusive) {
+    typedef std::make_unsigned_t<T> U;
+    std::vector<T> out(a.size());
+    U s = static_cast<U>(init);
+    for(size_t i = 0; i < a.size(); ++i) {
+        if(exclusive)
+            out[i] = static_cast<T>(s);
+        s += static_cast<U>(a[i]);
+        if(!exclusive)
+            out[i] = static_cast<T>(s);
+    }
+    return out;
+}
+
+template <class T>
+void test_integer_scan() {
+    for(int round = 0; round < 300; ++round) {
+        const size_t n = round < 70 ? static_cast<size_t>(round) : rng() % 5000;
+        std::vector<T> a(n);
+        for(auto& x : a) {
+            // 一部分输入取到极值，使前缀和跨过溢出边界
+            x = round % 4 == 0 ? static_cast<T>(rng()) : static_cast<T>(rng() % 2000) - static_cast<T>(500);
+        }
+        const T init = round % 3 == 0 ? std::numeric_limits<T>::max() : static_cast<T>(round);
+        std::vector<T> out(n), expect;
+
+        expect = expect_prefix(a, T(0), false);
+        CHECK(mystl::inclusive_scan(a.data(), a.data() + n, out.data()) == out.data() + n);
+        CHECK(out == expect);
+        CHECK(mystl::partial_sum(a.data(), a.data() + n, out.data()) == out.data() + n);
+        CHECK(out == expect);
+
+        expect = expect_prefix(a, init, false);
+        mystl::inclusive_scan(a.data(), a.data() + n, out.data(), mystl::plus<T>(), init);
+        CHECK(out == expect);
+
+        expect = expect_prefix(a, init, true);
+        CHECK(mystl::exclusive_scan(a.data(), a.data() + n, out.data(), init) == out.data() + n);
+        CHECK(out == expect);
+        // 原地扫描
+        out = a;
+        mystl::exclusive_scan(out.data(), out.data() + n, out.data(), init);
+        CHECK(out == expect);
+        out = a;
+        mystl::inclusive_scan(out.data(), out.data() + n, out.data(), mystl::plus<T>(), init);
+        CHECK(out == expect_prefix(a, init, false));
+
+        // 通用路径: 包装迭代器与自定义运算，有符号数相加溢出是未定义行为，只用不会溢出的输入
+        using mystl_test::forward_iter;
+        std::vector<T> in = a;
+        if(round % 4 != 0 || std::is_unsigned<T>::value) {
+            mystl::inclusive_scan(forward_iter<T>(in.data()), forward_iter<T>(in.data() + n), out.data());
+            CHECK(out == expect_prefix(a, T(0), false));
+        }
+        mystl::exclusive_scan(a.data(), a.data() + n, out.data(), init,
+                              [](T x, T y) { return mystl::wrapping_add(x, y); });
+        CHECK(out == expect);
+
+#ifdef MYSTL_SIMD_X86
+        if(mystl::simd_level() >= mystl::simd_avx2) {
+            CHECK(mystl::prefix_sum_avx2<false>(a.data(), n, out.data(), init)
+                  == (n ? expect_prefix(a, init, false).back() : init));
+            CHECK(out == expect_prefix(a, init, false));
+            mystl::prefix_sum_avx2<true>(a.data(), n, out.data(), init);
+            CHECK(out == expect);
+        }
+#endif
+    }
+}
+
+void test_generic_scan() {
+    // 不可交换的运算检查结合顺序
+    std::vector<std::string> a;
+    for(int i = 0; i < 20; ++i)
+        a.push_back(std::string(1, static_cast<char>('a' + i)));
+    std::vector<std::string> out(a.size());
+    mystl::inclusive_scan(a.data(), a.data() + a.size(), out.data(), std::plus<std::string>());
+    CHECK(out[0] == "a" && out[19] == "abcdefghijklmnopqrst");
+    mystl::exclusive_scan(a.data(), a.data() + a.size(), out.data(), std::string(">"), std::plus<std::string>());
+    CHECK(out[0] == ">" && out[1] == ">a" && out[19] == ">abcdefghijklmnopqrs");
+    mystl::partial_sum(a.data(), a.data() + a.size(), out.data(), std::plus<std::string>());
+    CHECK(out[5] == "abcdef");
+
+    // double 不走向量路径，结果与逐个相加完全相同
+    std::vector<double> d(1000);
+    for(auto& x : d)
+        x = static_cast<double>(rng() % 1000) / 7.0;
+    std::vector<double> dout(d.size());
+    mystl::inclusive_scan(d.data(), d.data() + d.size(), dout.data());
+    double s = 0.0;
+    for(size_t i = 0; i < d.size(); ++i) {
+        s += d[i];
+        CHECK(dout[i] == s);
+    }
+
+    const std::vector<int> v = {3, -1, 4, -1, 5};
+    std::vector<long long> sq(v.size());
+    mystl::transform_inclusive_scan(v.data(), v.data() + v.size(), sq.data(), std::plus<long long>(),
+                                    [](int x) { return static_cast<long long>(x) * x; });
+    CHECK((sq == std::vector<long long>{9, 10, 26, 27, 52}));
+    mystl::transform_inclusive_scan(v.data(), v.data() + v.size(), sq.data(), std::plus<long long>(),
+                                    [](int x) { return static_cast<long long>(x) * x; }, 100LL);
+    CHECK((sq == std::vector<long long>{109, 110, 126, 127, 152}));
+    mystl::transform_exclusive_scan(v.data(), v.data() + v.size(), sq.data(), 100LL, std::plus<long long>(),
+                                    [](int x) { return static_cast<long long>(x) * x; });
+    CHECK((sq == std::vector<long long>{100, 109, 110, 126, 127}));
+}
+
+/*****************************************************************************************/
+// reduce / transform_reduce / compensated_reduce
+/*****************************************************************************************/
+// 浮点数以 long double 的结果为参照: 普通版本的误差不超过 n eps sum|x|，整型的求和是精确的
+template <class T>
+void test_reduce() {
+    for(int round = 0; round < 200; ++round) {
+        const size_t n = round < 40 ? static_cast<size_t>(round) : rng() % 20000;
+        std::vector<T> a(n), b(n);
+        long double sum = 0, dot = 0, abs_sum = 0, abs_dot = 0;
+        for(size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<T>(static_cast<double>(rng() % 20001) / 64.0 - 150.0);
+            b[i] = static_cast<T>(static_cast<double>(rng() % 2001) / 16.0 - 60.0);
+            sum += a[i];
+            dot += static_cast<long double>(a[i]) * b[i];
+            abs_sum += std::fabs(static_cast<long double>(a[i]));
+            abs_dot += std::fabs(static_cast<long double>(a[i]) * b[i]);
+        }
+        const long double eps = std::numeric_limits<T>::epsilon();
+        auto close = [&](T x, long double expect, long double scale) {
+            return std::fabs(static_cast<long double>(x) - expect) <= 2 * eps * (scale + 1);
+        };
+        const T* p = a.data();
+        CHECK(close(mystl::reduce(p, p + n), sum, n * abs_sum));
+        CHECK(close(mystl::reduce(p, p + n, T(10)), sum + 10, n * (abs_sum + 10)));
+        CHECK(close(mystl::transform_reduce(p, p + n, b.data(), T(0)), dot, n * abs_dot));
+        CHECK(close(mystl::transform_reduce(p, p + n, T(0), mystl::plus<T>(), [](T x) { return x * 2; }),
+                    2 * sum, 2 * n * abs_sum));
+        // 补偿版本的误差不超过结果本身的舍入误差与 n^2 eps^2 量级的项
+        CHECK(close(mystl::compensated_reduce(p, p + n, T(0)), sum, std::fabs(sum)));
+        CHECK(close(mystl::compensated_transform_reduce(p, p + n, b.data(), T(0)), dot, std::fabs(dot)));
+
+        using mystl_test::forward_iter;
+        T* const q = a.data();
+        CHECK(close(mystl::reduce(forward_iter<T>(q), forward_iter<T>(q + n), T(0)), sum, n * abs_sum));
+        CHECK(close(mystl::compensated_reduce(forward_iter<T>(q), forward_iter<T>(q + n), T(0)),
+                    sum, std::fabs(sum)));
+
+        mystl::compensated_sum<T> acc;
+        mystl::compensated_sum_scalar(p, n, acc);
+        CHECK(close(acc.value(), sum, std::fabs(sum)));
+        acc = mystl::compensated_sum<T>();
+        mystl::compensated_dot_scalar(p, b.data(), n, acc);
+        CHECK(close(acc.value(), dot, std::fabs(dot)));
+#ifdef MYSTL_SIMD_X86
+        if(mystl::simd_level() >= mystl::simd_avx2) {
+            CHECK(close(mystl::sum_avx2(p, n), sum, n * abs_sum));
+            acc = mystl::compensated_sum<T>();
+            mystl::compensated_sum_avx2(p, n, acc);
+            CHECK(close(acc.value(), sum, std::fabs(sum)));
+        }
+        if(mystl::simd_level() >= mystl::simd_avx2 && mystl::simd_has_fma()) {
+            CHECK(close(mystl::dot_fma(p, b.data(), n), dot, n * abs_dot));
+            acc = mystl::compensated_sum<T>();
+            mystl::compensated_dot_fma(p, b.data(), n, acc);
+            CHECK(close(acc.value(), dot, std::fabs(dot)));
+        }
+#endif
+    }
+
+    std::vector<int> v(10007);
+    for(auto& x : v)
+        x = static_cast<int>(rng() % 1000) - 500;
+    CHECK(mystl::reduce(v.data(), v.data() + v.size()) == std::accumulate(v.begin(), v.end(), 0));
+    CHECK(mystl::transform_reduce(v.data(), v.data() + v.size(), v.data(), 0LL)
+          == std::inner_product(v.begin(), v.end(), v.begin(), 0LL));
+}
+
+// 病态的求和与点积: 大数与其相反数打乱后相互抵消，只剩下一些小整数
+// 输入都是 1/8 (点积为 1/64) 的整数倍，且位数足够少，TwoSum 与 fma 求出的误差之和可以精确表示，
+// 因此补偿版本的结果与精确值完全相等，而普通的求和一般会丢掉这些小整数
+template <class T>
+void test_compensated() {
+    const int bits = sizeof(T) == 8 ? 50 : 20;   // 求和时大数的位数
+    const int dbits = sizeof(T) == 8 ? 30 : 11;  // 点积时每个因子的位数
+    const size_t n = sizeof(T) == 8 ? 20000 : 400;
+    for(int round = 0; round < 20; ++round) {
+        std::vector<T> a, x, y;
+        long long small_sum = 0, small_dot = 0;
+        for(size_t i = 0; i < n; ++i) {
+            const T big = static_cast<T>(static_cast<double>(rng() % (uint64_t(1) << bits)) / 8.0);
+            a.push_back(big);
+            a.push_back(-big);
+            const T fx = static_cast<T>(static_cast<double>(rng() % (uint64_t(1) << dbits)) / 8.0);
+            const T fy = static_cast<T>(static_cast<double>(rng() % (uint64_t(1) << dbits)) / 8.0);
+            x.push_back(fx);
+            y.push_back(fy);
+            x.push_back(fx);
+            y.push_back(-fy);
+            if(i % 50 == 0) {
+                const int s = static_cast<int>(rng() % 9) + 1;
+                a.push_back(static_cast<T>(s));
+                small_sum += s;
+                x.push_back(static_cast<T>(s));
+                y.push_back(static_cast<T>(3));
+                small_dot += 3 * s;
+            }
+        }
+        // 同一个下标打乱两个区间，保持乘积的配对
+        for(size_t i = a.size() - 1; i > 0; --i)
+            std::swap(a[i], a[rng() % (i + 1)]);
+        for(size_t i = x.size() - 1; i > 0; --i) {
+            const size_t j = rng() % (i + 1);
+            std::swap(x[i], x[j]);
+            std::swap(y[i], y[j]);
+        }
+        const T* p = a.data();
+        CHECK(mystl::compensated_reduce(p, p + a.size(), T(0)) == static_cast<T>(small_sum));
+        CHECK(mystl::compensated_transform_reduce(x.data(), x.data() + x.size(), y.data(), T(0))
+              == static_cast<T>(small_dot));
+        using mystl_test::forward_iter;
+        CHECK(mystl::compensated_reduce(forward_iter<T>(a.data()), forward_iter<T>(a.data() + a.size()), T(0))
+              == static_cast<T>(small_sum));
+#ifdef MYSTL_SIMD_X86
+        mystl::compensated_sum<T> acc;
+        if(mystl::simd_level() >= mystl::simd_avx2) {
+            mystl::compensated_sum_avx2(p, a.size(), acc);
+            CHECK(acc.value() == static_cast<T>(small_sum));
+        }
+        if(mystl::simd_level() >= mystl::simd_avx2 && mystl::simd_has_fma()) {
+            acc = mystl::compensated_sum<T>();
+            mystl::compensated_dot_fma(x.data(), y.data(), x.size(), acc);
+            CHECK(acc.value() == static_cast<T>(small_dot));
+        }
+#endif
+    }
+}
+
+/*****************************************************************************************/
+// iota / adjacent_difference / delta_encode / delta_decode
+/*****************************************************************************************/
+template <class T>
+T wrap_sub(T x, T y) {
+    typedef std::make_unsigned_t<T> U;
+    return static_cast<T>(static_cast<U>(x) - static_cast<U>(y));
+}
+
+template <class T>
+void test_sequence_int() {
+    typedef std::numeric_limits<T> lim;
+    for(int round = 0; round < 200; ++round) {
+        const size_t n = round < 80 ? static_cast<size_t>(round) : rng() % 3000;
+        std::vector<T> a(n), out(n), back(n);
+        // 交替出现 INT_MIN / INT_MAX，相邻差与编码都跨过溢出边界
+        for(size_t i = 0; i < n; ++i) {
+            const uint64_t r = rng();
+            a[i] = round % 3 == 0 ? (r % 2 ? lim::max() : lim::min())
+                 : round % 3 == 1 ? static_cast<T>(r)
+                 : static_cast<T>(static_cast<T>(i * 7) + static_cast<T>(r % 5));
+        }
+        const T start = round % 2 ? lim::max() - static_cast<T>(n / 2) : lim::min();
+        mystl::iota(out.data(), out.data() + n, start);
+        for(size_t i = 0; i < n; ++i)
+            CHECK(out[i] == static_cast<T>(static_cast<std::make_unsigned_t<T>>(start) + i));
+
+        const T base = round % 4 == 0 ? lim::max() : round % 4 == 1 ? lim::min() : T(0);
+        CHECK(mystl::delta_encode(a.data(), a.data() + n, out.data(), base) == out.data() + n);
+        for(size_t i = 0; i < n; ++i)
+            CHECK(out[i] == wrap_sub(a[i], i == 0 ? base : a[i - 1]));
+        CHECK(mystl::delta_decode(out.data(), out.data() + n, back.data(), base) == back.data() + n);
+        CHECK(back == a);
+        // 原地编码与解码
+        back = a;
+        mystl::delta_encode(back.data(), back.data() + n, back.data());
+        mystl::delta_decode(back.data(), back.data() + n, back.data());
+        CHECK(back == a);
+        // 通用路径
+        using mystl_test::forward_iter;
+        mystl::delta_encode(forward_iter<T>(a.data()), forward_iter<T>(a.data() + n), out.data(), base);
+        back.assign(n, T(0));
+        mystl::delta_decode(forward_iter<T>(out.data()), forward_iter<T>(out.data() + n), back.data(), base);
+        CHECK(back == a);
+
+        // 指针区间的 adjacent_difference 同样按模运算，result 可以等于 first
+        mystl::adjacent_difference(a.data(), a.data() + n, out.data());
+        for(size_t i = 0; i < n; ++i)
+            CHECK(out[i] == (i == 0 ? a[0] : wrap_sub(a[i], a[i - 1])));
+        back = a;
+        mystl::adjacent_diffrence(back.data(), back.data() + n, back.data());
+        CHECK(back == out);
+#ifdef MYSTL_SIMD_X86
+        if(mystl::simd_level() >= mystl::simd_avx2) {
+            mystl::adjacent_difference_avx2(a.data(), n, back.data(), base);
+            for(size_t i = 0; i < n; ++i)
+                CHECK(back[i] == wrap_sub(a[i], i == 0 ? base : a[i - 1]));
+            mystl::iota_avx2(back.data(), n, start);
+            mystl::iota_scalar(out.data(), n, start);
+            CHECK(back == out);
+        }
+#endif
+    }
+}
+
+template <class T>
+void test_sequence_float() {
+    for(size_t n : {size_t(0), size_t(1), size_t(7), size_t(100), size_t(1001)}) {
+        std::vector<T> out(n), expect(n);
+        // -0.0 开始时第一个元素保持 -0.0，之后与 ++value 的结果相同
+        for(T start : {T(-0.0), T(-3), T(2.5), T(1) / T(3)}) {
+            T v = start;
+            for(auto& x : expect)
+                x = v++;
+            mystl::iota(out.data(), out.data() + n, start);
+            for(size_t i = 0; i < n; ++i)
+                CHECK(out[i] == expect[i] && std::signbit(out[i]) == std::signbit(expect[i]));
+        }
+        for(size_t i = 0; i < n; ++i)
+            expect[i] = static_cast<T>(static_cast<double>(rng() % 10000) / 16.0 - 300.0);
+        mystl::adjacent_difference(expect.data(), expect.data() + n, out.data());
+        for(size_t i = 0; i < n; ++i)
+            CHECK(out[i] == (i == 0 ? expect[0] : expect[i] - expect[i - 1]));
+        std::vector<T> back(n);
+        mystl::delta_encode(expect.data(), expect.data() + n, out.data(), T(-0.0));
+        mystl::delta_decode(out.data(), out.data() + n, back.data(), T(-0.0));
+        CHECK(back == expect);
+    }
+    // 超出可以精确表示的整数范围后使用逐个 ++value 的版本
+    const T big = static_cast<T>(1ull << std::numeric_limits<T>::digits) - T(4);
+    std::vector<T> out(16), expect(16);
+    T v = big;
+    for(auto& x : expect)
+        x = v++;
+    mystl::iota(out.data(), out.data() + out.size(), big);
+    CHECK(out == expect);
+}
+
+} // namespace
+
+int main() {
+    test_integer_scan<int32_t>();
+    test_integer_scan<uint32_t>();
+    test_integer_scan<int64_t>();
+    test_integer_scan<uint64_t>();
+    test_generic_scan();
+    test_sequence_int<int8_t>();
+    test_sequence_int<uint8_t>();
+    test_sequence_int<int16_t>();
+    test_sequence_int<int32_t>();
+    test_sequence_int<uint32_t>();
+    test_sequence_int<int64_t>();
+    test_sequence_int<uint64_t>();
+    test_sequence_float<float>();
+    test_sequence_float<double>();
+    test_reduce<float>();
+    test_reduce<double>();
+    test_compensated<float>();
+    test_compensated<double>();
+    std::printf("numeric_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+// parallel.h 的正确性测试: work_stealing_deque、task_group、parallel_invoke、parallel_for、
+// parallel_reduce、异常传递、嵌套并行与休眠后的唤醒
+// 单核机器上也应指定多个线程，使窃取与休眠的路径都能执行到，并分别在 ASan 与 TSan 下运行
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -pthread -fsanitize=address,undefined -DMYSTL_PARALLEL_THREADS=4 -IMySTL test/parallel_test.cpp -o parallel_test_asan
+//   ./parallel_test_asan
+//   g++ -std=c++17 -O1 -g -pthread -fsanitize=thread -DMYSTL_PARALLEL_THREADS=4 -IMySTL test/parallel_test.cpp -o parallel_test_tsan
+//   ./parallel_test_tsan
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parallel.h"
+#include "test.h"
+
+namespace {
+
+long fib(int n) {
+    if(n < 12)
+        return n < 2 ? n : fib(n - 1) + fib(n - 2);
+    long a = 0, b = 0;
+    mystl::parallel_invoke([&] { a = fib(n - 1); }, [&] { b = fib(n - 2); });
+    return a + b;
+}
+
+void quick_sort(int* a, long n) {
+    if(n < 512) {
+        std::sort(a, a + n);
+        return;
+    }
+    const int pivot = a[n / 2];
+    int* m1 = std::partition(a, a + n, [pivot](int x) { return x < pivot; });
+    int* m2 = std::partition(m1, a + n, [pivot](int x) { return x == pivot; });
+    mystl::task_group group;
+    group.run([=] { quick_sort(a, m1 - a); });
+    quick_sort(m2, a + n - m2);
+    group.wait();
+}
+
+// 单线程下的双端语义: 底部后进先出，顶部先进先出，环形缓冲区从 2 个元素开始扩容
+void test_deque_serial() {
+    mystl::work_stealing_deque<int*> d(2);
+    int v[1000];
+    for(int i = 0; i < 1000; ++i)
+        d.push(v + i);
+    for(int i = 0; i < 10; ++i)
+        CHECK(d.steal() == v + i);
+    for(int i = 999; i >= 10; --i)
+        CHECK(d.pop() == v + i);
+    CHECK(d.pop() == nullptr && d.steal() == nullptr && d.empty());
+}
+
+// 所有者压入与弹出的同时三个线程窃取，每个元素恰好被取出一次
+void test_deque_concurrent() {
+    const long n = 200000;
+    mystl::work_stealing_deque<long*> d(4);
+    std::vector<long> v(n);
+    std::vector<std::atomic<int>> seen(n);
+    std::atomic<long> taken(0);
+    std::atomic<bool> done(false);
+    auto take = [&](long* p) {
+        seen[p - v.data()].fetch_add(1);
+        taken.fetch_add(1);
+    };
+    std::vector<std::thread> thieves;
+    for(int k = 0; k < 3; ++k) {
+        thieves.emplace_back([&] {
+            while(!done.load() || !d.empty()) {
+                if(long* p = d.steal())
+                    take(p);
+            }
+        });
+    }
+    for(long i = 0; i < n; ++i) {
+        d.push(&v[i]);
+        if(i % 3 == 0) {
+            if(long* p = d.pop())
+                take(p);
+        }
+    }
+    while(long* p = d.pop())
+        take(p);
+    done.store(true);
+    for(auto& t : thieves)
+        t.join();
+    while(long* p = d.pop())
+        take(p);
+    CHECK(taken.load() == n);
+    for(long i = 0; i < n; ++i)
+        CHECK(seen[i].load() == 1);
+}
+
+void test_fork_join() {
+    CHECK(fib(27) == 196418);
+
+    std::mt19937 rng(3);
+    std::vector<int> a(1 << 20);
+    for(auto& x : a)
+        x = static_cast<int>(rng() % 100000);
+    std::vector<int> b = a;
+    quick_sort(a.data(), static_cast<long>(a.size()));
+    std::sort(b.begin(), b.end());
+    CHECK(a == b);
+}
+
+void test_for_and_reduce() {
+    std::vector<long> s(1000003);
+    for(size_t i = 0; i < s.size(); ++i)
+        s[i] = static_cast<long>(i % 97);
+    long expect = 0;
+    for(long x : s)
+        expect += x;
+
+    std::atomic<long> total(0);
+    mystl::parallel_for(0, s.size(), 0, [&](size_t lo, size_t hi) {
+        long t = 0;
+        for(size_t i = lo; i < hi; ++i)
+            t += s[i];
+        total.fetch_add(t);
+    });
+    CHECK(total.load() == expect);
+
+    const long sum = mystl::parallel_reduce(0, s.size(), 1000, 0L,
+        [&](size_t lo, size_t hi, long init) {
+            for(size_t i = lo; i < hi; ++i)
+                init += s[i];
+            return init;
+        },
+        [](long x, long y) { return x + y; });
+    CHECK(sum == expect);
+
+    // combine 不可交换: 结果必须按下标顺序拼接
+    const std::string cat = mystl::parallel_reduce(0, 5000, 7, std::string(),
+        [](size_t lo, size_t hi, std::string init) {
+            for(size_t i = lo; i < hi; ++i)
+                init += static_cast<char>('a' + i % 26);
+            return init;
+        },
+        [](const std::string& x, const std::string& y) { return x + y; });
+    std::string cat_expect;
+    for(int i = 0; i < 5000; ++i)
+        cat_expect += static_cast<char>('a' + i % 26);
+    CHECK(cat == cat_expect);
+}
+
+void test_exceptions() {
+    bool caught = false;
+    try {
+        mystl::task_group group;
+        for(int i = 0; i < 50; ++i)
+            group.run([i] { if(i == 17) throw i; });
+        group.wait();
+    }
+    catch(int x) {
+        caught = x == 17;
+    }
+    CHECK(caught);
+
+    caught = false;
+    try {
+        mystl::parallel_invoke_n(100, [](size_t i) { if(i == 63) throw 5; });
+    }
+    catch(int) {
+        caught = true;
+    }
+    CHECK(caught);
+}
+
+void test_nested() {
+    std::atomic<long> count(0);
+    mystl::parallel_invoke_n(16, [&](size_t) {
+        mystl::parallel_invoke_n(16, [&](size_t) {
+            mystl::parallel_for(0, 100, 3, [&](size_t lo, size_t hi) {
+                count.fetch_add(static_cast<long>(hi - lo));
+            });
+        });
+    });
+    CHECK(count.load() == 16 * 16 * 100);
+}
+
+// 工作线程空闲后进入休眠，之后提交的任务仍要能唤醒它们
+void test_wake_after_park() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(fib(20) == 6765);
+}
+
+} // namespace
+
+int main() {
+    test_deque_serial();
+    test_deque_concurrent();
+    test_fork_join();
+    test_for_and_reduce();
+    test_exceptions();
+    test_nested();
+    test_wake_after_park();
+    std::printf("parallel_test: %zu threads, ok\n", mystl::hardware_threads());
+    return 0;
+}
@@ -0,0 +1,212 @@
+// set_algo.h 的正确性测试: 以 std 的集合算法为参照，比较随机有序序列 (含重复元素) 上的
+// set_union / set_intersection / set_intersection_count / set_difference / set_symmetric_defference，
+// 4 / 8 字节整型走 SIMD 快速路径，double 走通用归并；当前 CPU 支持的每个交集内核都单独比较一次
+// 多路版本以两两折叠的 std 结果为参照，并行版本在输入足够长时按硬件线程数切分
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/set_algo_test.cpp -o set_algo_test
+//   ./set_algo_test
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -DMYSTL_NO_SIMD -IMySTL test/set_algo_test.cpp -o set_algo_test_scalar
+//   ./set_algo_test_scalar
+
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "set_algo.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(26);
+
+// 长度为 n、在 range 个相邻整数中取值 (包括负数) 的有序序列，range 小时重复元素多
+template <class T>
+std::vector<T> sorted_input(size_t n, uint64_t range) {
+    std::vector<T> v(n);
+    for(auto& x : v)
+        x = static_cast<T>(static_cast<int64_t>(rng() % range) - static_cast<int64_t>(range / 3));
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+template <class T>
+void check_kernels(const std::vector<T>& a, const std::vector<T>& b, const std::vector<T>& expect) {
+    std::vector<T> out(a.size() + b.size() + 1);
+    size_t i = 0, j = 0;
+    CHECK(mystl::set_intersection_scalar(a.data(), i, a.size(), b.data(), j, b.size(), out.data(), 0)
+          == expect.size());
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+    if(!a.empty() && !b.empty()) {
+        const size_t n = mystl::set_intersection_gallop(a.data(), a.size(), b.data(), b.size(), out.data());
+        CHECK(n == expect.size() && std::equal(expect.begin(), expect.end(), out.begin()));
+    }
+#ifdef MYSTL_SIMD_X86
+    const int level = mystl::simd_level();
+    if(level >= mystl::simd_sse42) {
+        const size_t n = sizeof(T) == 4
+            ? mystl::set_intersection_sse42_32(a.data(), a.size(), b.data(), b.size(), out.data())
+            : mystl::set_intersection_sse42_64(a.data(), a.size(), b.data(), b.size(), out.data());
+        CHECK(n == expect.size() && std::equal(expect.begin(), expect.end(), out.begin()));
+    }
+    if(level >= mystl::simd_avx2) {
+        const size_t n = sizeof(T) == 4
+            ? mystl::set_intersection_avx2_32(a.data(), a.size(), b.data(), b.size(), out.data())
+            : mystl::set_intersection_avx2_64(a.data(), a.size(), b.data(), b.size(), out.data());
+        CHECK(n == expect.size() && std::equal(expect.begin(), expect.end(), out.begin()));
+    }
+#endif
+}
+
+template <class T>
+void check_pair(const std::vector<T>& a, const std::vector<T>& b) {
+    std::vector<T> expect, out(a.size() + b.size() + 1);
+    const T* pa = a.data();
+    const T* pb = b.data();
+
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+    T* end = mystl::set_union(pa, pa + a.size(), pb, pb + b.size(), out.data());
+    CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+
+    expect.clear();
+    std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+    end = mystl::set_symmetric_defference(pa, pa + a.size(), pb, pb + b.size(), out.data());
+    CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+
+    expect.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+    end = mystl::set_difference(pa, pa + a.size(), pb, pb + b.size(), out.data());
+    CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+
+    expect.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+    end = mystl::set_intersection(pa, pa + a.size(), pb, pb + b.size(), out.data());
+    CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+    CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+    CHECK(mystl::set_intersection_count(pa, pa + a.size(), pb, pb + b.size()) == expect.size());
+
+    if constexpr(mystl::is_set_simd_type<T>::value)
+        check_kernels(a, b, expect);
+}
+
+template <class T>
+void test_type() {
+    for(int round = 0; round < 400; ++round) {
+        const size_t na = rng() % 300;
+        // 约四分之一的情况两序列长度相差超过 kSetGallopRatio 倍，走倍增查找
+        const size_t nb = round % 4 == 0 ? na * 40 + rng() % 50 : rng() % 300;
+        const uint64_t range = round % 3 == 0 ? 16 : round % 3 == 1 ? 1000 : (uint64_t(1) << 40);
+        check_pair(sorted_input<T>(na, range), sorted_input<T>(nb, range));
+    }
+    check_pair(std::vector<T>(), sorted_input<T>(100, 50));
+    check_pair(sorted_input<T>(100, 50), std::vector<T>());
+    const std::vector<T> same = sorted_input<T>(257, 1 << 20);
+    check_pair(same, same);
+}
+
+template <class T>
+std::vector<T> fold_expect(const std::vector<std::vector<T>>& ins, bool is_union) {
+    std::vector<T> acc = ins[0];
+    for(size_t i = 1; i < ins.size(); ++i) {
+        std::vector<T> next;
+        if(is_union)
+            std::set_union(acc.begin(), acc.end(), ins[i].begin(), ins[i].end(), std::back_inserter(next));
+        else
+            std::set_intersection(acc.begin(), acc.end(), ins[i].begin(), ins[i].end(), std::back_inserter(next));
+        acc.swap(next);
+    }
+    return acc;
+}
+
+template <class T>
+void test_multiway() {
+    for(int round = 0; round < 200; ++round) {
+        const size_t k = 1 + rng() % 9;
+        const uint64_t range = round % 2 == 0 ? 64 : 4000;
+        std::vector<std::vector<T>> ins(k);
+        size_t total = 0;
+        for(auto& v : ins) {
+            v = sorted_input<T>(rng() % 400, range);
+            total += v.size();
+        }
+        std::vector<mystl::pair<const T*, const T*>> ranges;
+        for(const auto& v : ins)
+            ranges.push_back(mystl::pair<const T*, const T*>(v.data(), v.data() + v.size()));
+        std::vector<T> out(total + 1);
+
+        std::vector<T> expect = fold_expect(ins, true);
+        T* end = mystl::multiway_set_union(ranges.begin(), ranges.end(), out.data());
+        CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+        CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+
+        expect = fold_expect(ins, false);
+        end = mystl::multiway_set_intersection(ranges.begin(), ranges.end(), out.data());
+        CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+        CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+
+        // comp 版本走通用路径 (倍增查找 + 败者树)，用降序序列与 greater 比较
+        for(auto& v : ins)
+            std::reverse(v.begin(), v.end());
+        std::vector<std::vector<T>> rev = ins;
+        for(auto& v : rev)
+            std::sort(v.begin(), v.end());
+        std::vector<T> expect_rev = fold_expect(rev, false);
+        std::reverse(expect_rev.begin(), expect_rev.end());
+        end = mystl::multiway_set_intersection(ranges.begin(), ranges.end(), out.data(), std::greater<T>());
+        CHECK(static_cast<size_t>(end - out.data()) == expect_rev.size());
+        CHECK(std::equal(expect_rev.begin(), expect_rev.end(), out.begin()));
+        expect_rev = fold_expect(rev, true);
+        std::reverse(expect_rev.begin(), expect_rev.end());
+        end = mystl::multiway_set_union(ranges.begin(), ranges.end(), out.data(), std::greater<T>());
+        CHECK(static_cast<size_t>(end - out.data()) == expect_rev.size());
+        CHECK(std::equal(expect_rev.begin(), expect_rev.end(), out.begin()));
+    }
+}
+
+template <class T>
+void test_parallel() {
+    // 单线程机器上退化为串行，多线程时每段至少 kParallelSetGrain 个元素
+    const size_t n = 4 * mystl::kParallelSetGrain + 123;
+    for(int round = 0; round < 3; ++round) {
+        const uint64_t range = round == 0 ? 100 : round == 1 ? n : (uint64_t(1) << 40);
+        const std::vector<T> a = sorted_input<T>(n, range);
+        const std::vector<T> b = sorted_input<T>(n / (round + 1), range);
+        std::vector<T> expect, out(a.size() + b.size());
+
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+        T* end = mystl::parallel_set_union(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+                                           out.data());
+        CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+        CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+
+        expect.clear();
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expect));
+        end = mystl::parallel_set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+                                               out.data());
+        CHECK(static_cast<size_t>(end - out.data()) == expect.size());
+        CHECK(std::equal(expect.begin(), expect.end(), out.begin()));
+    }
+}
+
+} // namespace
+
+int main() {
+    test_type<int32_t>();
+    test_type<uint32_t>();
+    test_type<int64_t>();
+    test_type<uint64_t>();
+    test_type<double>();
+    test_multiway<int32_t>();
+    test_multiway<uint64_t>();
+    test_multiway<double>();
+    test_parallel<int32_t>();
+    test_parallel<double>();
+    std::printf("set_algo_test: ok\n");
+    return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef MYSTL_TEST_TEST_H_
+#define MYSTL_TEST_TEST_H_
+
+// 测试用的断言: 条件不成立时输出文件、行号与表达式，并以非零状态退出
+// 每个测试是一个独立的程序，不依赖测试框架
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include "iterator.h"
+
+#define CHECK(cond) do {                                                    \
+    if(!(cond)) {                                                           \
+        std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        std::exit(1);                                                       \
+    }                                                                       \
+} while(0)
+
+namespace mystl_test {
+
+// 包装指针的迭代器，只提供 Category 对应的操作，用来测试各算法的通用 (非指针) 版本
+template <class T, class Category>
+class tag_iterator {
+public:
+    typedef Category        iterator_category;
+    typedef T               value_type;
+    typedef ptrdiff_t       difference_type;
+    typedef T*              pointer;
+    typedef T&              reference;
+
+    tag_iterator() : p_(nullptr) {}
+    explicit tag_iterator(T* p) : p_(p) {}
+
+    T* base() const { return p_; }
+    T& operator*() const { return *p_; }
+    T* operator->() const { return p_; }
+    tag_iterator& operator++() { ++p_; return *this; }
+    tag_iterator operator++(int) { return tag_iterator(p_++); }
+    tag_iterator& operator--() { --p_; return *this; }
+    tag_iterator operator--(int) { return tag_iterator(p_--); }
+    tag_iterator& operator+=(ptrdiff_t n) { p_ += n; return *this; }
+    tag_iterator& operator-=(ptrdiff_t n) { p_ -= n; return *this; }
+    tag_iterator operator+(ptrdiff_t n) const { return tag_iterator(p_ + n); }
+    tag_iterator operator-(ptrdiff_t n) const { return tag_iterator(p_ - n); }
+    ptrdiff_t operator-(const tag_iterator& rhs) const { return p_ - rhs.p_; }
+    T& operator[](ptrdiff_t n) const { return p_[n]; }
+    bool operator==(const tag_iterator& rhs) const { return p_ == rhs.p_; }
+    bool operator!=(const tag_iterator& rhs) const { return p_ != rhs.p_; }
+    bool operator<(const tag_iterator& rhs) const { return p_ < rhs.p_; }
+
+private:
+    T* p_;
+};
+
+template <class T> using forward_iter = tag_iterator<T, mystl::forward_iterator_tag>;
+template <class T> using bidi_iter = tag_iterator<T, mystl::bidirectional_iterator_tag>;
+template <class T> using random_iter = tag_iterator<T, mystl::random_access_iterator_tag>;
+template <class T> using contiguous_iter = tag_iterator<T, mystl::contiguous_iterator_tag>;
+
+} // namespace mystl_test
+
+#endif // MYSTL_TEST_TEST_H_
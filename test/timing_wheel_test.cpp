@@ -0,0 +1,225 @@
+// timing_wheel.h 的正确性测试
+// 随机 schedule、cancel、advance，与按 (到期时刻, 编号) 排序的参照集合比较触发的定时器与顺序；
+// 另测回调中的 schedule / cancel、回调抛出异常、跨越多个 2^36 区间的远期定时器、
+// kNever 的饱和语义以及 next_event 的跳转
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/timing_wheel_test.cpp -o timing_wheel_test
+//   ./timing_wheel_test
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "timing_wheel.h"
+#include "test.h"
+
+namespace {
+
+std::mt19937_64 rng(44);
+
+typedef mystl::timing_wheel<uint32_t> wheel_type;
+typedef uint64_t tick;
+const tick kNever = wheel_type::kNever;
+
+// 参照实现: 等待中的定时器按 (到期时刻, 编号) 排序
+struct reference {
+    std::set<std::pair<tick, uint32_t>> pending;
+    std::map<uint32_t, tick> expiry;
+
+    void add(uint32_t id, tick e) {
+        pending.insert({e, id});
+        expiry[id] = e;
+    }
+    void erase(uint32_t id) {
+        pending.erase({expiry[id], id});
+        expiry.erase(id);
+    }
+};
+
+// 推进到 t，检查触发的定时器恰好是参照集合中到期时刻不晚于 t 的那些，且按到期时刻的顺序触发
+void advance_and_check(wheel_type& w, reference& ref, tick t) {
+    std::vector<uint32_t> fired;
+    const size_t n = w.advance(t, [&](uint32_t id) { fired.push_back(id); });
+    CHECK(n == fired.size());
+    tick last = 0;
+    for(uint32_t id : fired) {
+        CHECK(ref.expiry.count(id) == 1);
+        const tick e = ref.expiry[id];
+        CHECK(e <= t && e != kNever);
+        CHECK(e >= last);
+        last = e;
+        ref.erase(id);
+    }
+    CHECK(ref.pending.empty() || ref.pending.begin()->first > t || ref.pending.begin()->first == kNever);
+    CHECK(w.size() == ref.pending.size());
+}
+
+// 随机操作，到期时刻分布在 span 以内
+void test_random(tick start, tick span) {
+    wheel_type w(start);
+    reference ref;
+    std::map<uint32_t, uint64_t> handle;
+    uint32_t next_id = 0;
+    for(int step = 0; step < 3000; ++step) {
+        const int op = static_cast<int>(rng() % 8);
+        if(op < 4) {
+            tick e = w.now() + rng() % span;
+            if(e < w.now())
+                e = kNever;                             // 加法回绕
+            if(rng() % 50 == 0)
+                e = w.now() - rng() % 10;               // 过去的时刻按 now() 处理
+            if(rng() % 100 == 0)
+                e = kNever;
+            const uint32_t id = next_id++;
+            handle[id] = w.schedule(e, id);
+            ref.add(id, e < w.now() ? w.now() : e);
+        }
+        else if(op < 6 && !ref.expiry.empty()) {
+            auto it = ref.expiry.begin();
+            std::advance(it, rng() % ref.expiry.size());
+            const uint32_t id = it->first;
+            CHECK(w.contains(handle[id]));
+            CHECK(w.cancel(handle[id]));
+            CHECK(!w.contains(handle[id]));
+            CHECK(!w.cancel(handle[id]));
+            ref.erase(id);
+        }
+        else {
+            const tick before = w.now();
+            const tick t = before + rng() % (op == 6 ? 100 : span);
+            if(t >= before) {
+                advance_and_check(w, ref, t);
+                CHECK(w.now() == t + 1);
+            }
+        }
+    }
+    // 已触发的句柄全部失效
+    for(const auto& kv : handle)
+        CHECK(w.contains(kv.second) == (ref.expiry.count(kv.first) == 1));
+    advance_and_check(w, ref, kNever);
+    CHECK(w.now() == kNever);
+    for(const auto& kv : ref.pending)
+        CHECK(kv.first == kNever);
+}
+
+// 回调中 schedule 与 cancel，包括取消同一批中尚未触发的定时器
+void test_reentrant() {
+    wheel_type w;
+    std::vector<uint64_t> h(10);
+    for(uint32_t i = 0; i < 10; ++i)
+        h[i] = w.schedule(5, i);
+    std::vector<uint32_t> fired;
+    w.advance(5, [&](uint32_t id) {
+        fired.push_back(id);
+        if(fired.size() == 1) {
+            for(uint32_t i = 0; i < 10; ++i)
+                if(i != id && i % 2 == 0)
+                    CHECK(w.cancel(h[i]));
+            w.schedule(5, 100);         // 早于 now() 的时刻，在下一个时刻触发
+            w.schedule(7, 101);
+        }
+    });
+    CHECK(fired.size() == 5 + (fired[0] % 2 == 0 ? 1 : 0));
+    CHECK(w.size() == 2);
+    fired.clear();
+    CHECK(w.next_event() == 6);
+    w.advance(6, [&](uint32_t id) { fired.push_back(id); });
+    CHECK(fired.size() == 1 && fired[0] == 100);
+    w.advance(7, [&](uint32_t id) { fired.push_back(id); });
+    CHECK(fired.size() == 2 && fired[1] == 101 && w.empty());
+}
+
+// 回调抛出异常时，同一批中其余的定时器放回时间轮，之后仍会触发
+void test_exception() {
+    wheel_type w;
+    for(uint32_t i = 0; i < 8; ++i)
+        w.schedule(3, i);
+    size_t calls = 0;
+    bool thrown = false;
+    try {
+        w.advance(10, [&](uint32_t) {
+            if(++calls == 3)
+                throw 44;
+        });
+    }
+    catch(int) {
+        thrown = true;
+    }
+    CHECK(thrown && calls == 3);
+    CHECK(w.size() == 5);
+    size_t rest = w.advance(10, [](uint32_t) {});
+    CHECK(rest == 5 && w.empty());
+}
+
+// 远期定时器: next_event 直接跳到最早的溢出定时器所在的 2^36 区间，不逐个区间下移；
+// 到期时刻为 kNever 的定时器不产生事件
+void test_far_future() {
+    const tick window = tick(1) << 36;
+    wheel_type w;
+    w.schedule(kNever, 1);
+    CHECK(w.next_event() == kNever);
+    w.schedule(1000 * window + 12345, 2);
+    const uint64_t h3 = w.schedule(900 * window + 7, 3);
+    CHECK(w.next_event() == 900 * window);
+    CHECK(w.cancel(h3));
+    // 取消后记录的最早时刻可能偏早，至多多出一次下移
+    size_t steps = 0;
+    std::vector<uint32_t> fired;
+    for(tick e = w.next_event(); e != kNever; e = w.next_event()) {
+        w.advance(e, [&](uint32_t id) { fired.push_back(id); });
+        CHECK(++steps < 40);
+    }
+    CHECK(fired.size() == 1 && fired[0] == 2);
+    CHECK(w.now() == 1000 * window + 12346);
+    CHECK(w.size() == 1);
+
+    // advance(kNever) 触发其余所有定时器后 now() 停在 kNever，之后 schedule 的定时器都不会触发
+    w.schedule(kNever - 1, 4);
+    w.schedule(kNever - window - 3, 5);
+    fired.clear();
+    CHECK(w.advance(kNever, [&](uint32_t id) { fired.push_back(id); }) == 2);
+    CHECK(fired.size() == 2 && fired[0] == 5 && fired[1] == 4);
+    CHECK(w.now() == kNever);
+    w.schedule(5, 6);
+    CHECK(w.next_event() == kNever);
+    CHECK(w.advance(kNever, [](uint32_t) { CHECK(false); }) == 0);
+    CHECK(w.size() == 2);
+    w.clear();
+    CHECK(w.empty());
+}
+
+// 只能移动、需要析构的数据
+void test_value_type() {
+    mystl::timing_wheel<std::string> w(100);
+    const std::string long_text(100, 'z');
+    w.schedule(150, long_text);
+    const uint64_t h = w.schedule(120, std::string("cancelled") + long_text);
+    w.emplace(130, size_t(3), 'c');
+    CHECK(w.cancel(h));
+    std::vector<std::string> got;
+    w.advance(200, [&](std::string& s) { got.push_back(s); });
+    CHECK(got.size() == 2 && got[0] == "ccc" && got[1] == long_text);
+    w.schedule(300, long_text);
+    w.schedule(kNever, long_text);
+}   // 析构时销毁等待中的定时器
+
+} // namespace
+
+int main() {
+    test_random(0, 100);
+    test_random(0, 5000);
+    test_random(12345, tick(1) << 20);
+    test_random(tick(1) << 35, tick(1) << 38);
+    test_random(kNever - (tick(1) << 40), tick(1) << 39);
+    test_reentrant();
+    test_exception();
+    test_far_future();
+    test_value_type();
+    std::printf("timing_wheel_test: ok\n");
+    return 0;
+}
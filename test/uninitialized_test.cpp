@@ -0,0 +1,163 @@
+// uninitialized.h 的正确性测试: 在未初始化的缓冲区上复制、移动与填充构造元素
+// 构造与赋值都平凡的类型按字节复制；赋值平凡但构造不平凡的类型必须逐个调用构造函数；
+// 构造函数抛出异常时，已构造的元素全部析构后再把异常传出
+//
+// 编译运行（在仓库根目录）：
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -IMySTL test/uninitialized_test.cpp -o uninitialized_test
+//   ./uninitialized_test
+
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "uninitialized.h"
+#include "test.h"
+
+namespace {
+
+// 赋值是平凡的，复制构造会计数，不能用赋值代替构造
+struct counted_copy {
+    int v;
+    static int copies;
+    counted_copy(int x = 0) : v(x) {}
+    counted_copy(const counted_copy& rhs) : v(rhs.v) { ++copies; }
+    counted_copy& operator=(const counted_copy&) = default;
+};
+int counted_copy::copies = 0;
+
+static_assert(mystl::is_trivially_uninit_copy<int>::value, "");
+static_assert(!mystl::is_trivially_uninit_copy<counted_copy>::value, "");
+static_assert(!mystl::is_trivially_uninit_copy<std::string>::value, "");
+
+// 第 throw_at 次构造时抛出异常，live 记录存活的对象数
+struct fragile {
+    int v;
+    static int live;
+    static int throw_at;
+    fragile(int x = 0) : v(x) { ++live; }
+    fragile(const fragile& rhs) : v(rhs.v) {
+        if(--throw_at == 0)
+            throw 42;
+        ++live;
+    }
+    ~fragile() { --live; }
+};
+int fragile::live = 0;
+int fragile::throw_at = 0;
+
+// 未初始化的缓冲区
+template <class T>
+struct raw_buffer {
+    explicit raw_buffer(size_t n) : p(static_cast<T*>(::operator new(n * sizeof(T)))), n(n) {}
+    ~raw_buffer() { ::operator delete(p); }
+    T* p;
+    size_t n;
+};
+
+template <class T, class Make>
+void check_type(size_t n, Make make) {
+    std::vector<T> src;
+    for(size_t i = 0; i < n; ++i)
+        src.push_back(make(i));
+    raw_buffer<T> buf(n);
+
+    T* end = mystl::uninitialized_copy(src.data(), src.data() + n, buf.p);
+    CHECK(end == buf.p + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == src[i]);
+    mystl::destory(buf.p, buf.p + n);
+
+    end = mystl::uninitialized_copy_n(src.data(), n, buf.p);
+    CHECK(end == buf.p + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == src[i]);
+    mystl::destory(buf.p, buf.p + n);
+
+    std::vector<T> from = src;
+    end = mystl::uninitialized_move(from.data(), from.data() + n, buf.p);
+    CHECK(end == buf.p + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == src[i]);
+    mystl::destory(buf.p, buf.p + n);
+
+    from = src;
+    end = mystl::uninitialized_move_n(from.data(), n, buf.p);
+    CHECK(end == buf.p + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == src[i]);
+    mystl::destory(buf.p, buf.p + n);
+
+    const T value = make(n + 1);
+    mystl::uninitialized_fill(buf.p, buf.p + n, value);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == value);
+    mystl::destory(buf.p, buf.p + n);
+    end = mystl::uninitialized_fill_n(buf.p, n, value);
+    CHECK(end == buf.p + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == value);
+    mystl::destory(buf.p, buf.p + n);
+
+    // 通用迭代器
+    using mystl_test::forward_iter;
+    auto it = mystl::uninitialized_copy(forward_iter<T>(src.data()), forward_iter<T>(src.data() + n),
+                                        forward_iter<T>(buf.p));
+    CHECK(it.base() == buf.p + n);
+    for(size_t i = 0; i < n; ++i)
+        CHECK(buf.p[i] == src[i]);
+    mystl::destory(buf.p, buf.p + n);
+}
+
+void test_construct_count() {
+    std::vector<counted_copy> src(50);
+    raw_buffer<counted_copy> buf(50);
+    counted_copy::copies = 0;
+    mystl::uninitialized_copy(src.data(), src.data() + 50, buf.p);
+    CHECK(counted_copy::copies == 50);
+    mystl::uninitialized_copy_n(src.data(), 50, buf.p);
+    CHECK(counted_copy::copies == 100);
+    mystl::uninitialized_fill_n(buf.p, 50, src[0]);
+    CHECK(counted_copy::copies == 150);
+}
+
+void test_exception() {
+    for(int at : {1, 2, 17, 40}) {
+        std::vector<fragile> src(40);
+        raw_buffer<fragile> buf(40);
+        const int before = fragile::live;
+        fragile::throw_at = at;
+        bool thrown = false;
+        try {
+            mystl::uninitialized_copy(src.data(), src.data() + 40, buf.p);
+        }
+        catch(int) {
+            thrown = true;
+        }
+        CHECK(thrown && fragile::live == before);
+
+        fragile::throw_at = at;
+        thrown = false;
+        try {
+            mystl::uninitialized_fill_n(buf.p, 40, src[0]);
+        }
+        catch(int) {
+            thrown = true;
+        }
+        CHECK(thrown && fragile::live == before);
+    }
+}
+
+} // namespace
+
+int main() {
+    for(size_t n : {size_t(0), size_t(1), size_t(33), size_t(1000)}) {
+        check_type<int64_t>(n, [](size_t i) { return static_cast<int64_t>(i * 31); });
+        check_type<double>(n, [](size_t i) { return static_cast<double>(i) / 3; });
+        check_type<std::string>(n, [](size_t i) { return std::string(i % 40, 'a') + std::to_string(i); });
+    }
+    test_construct_count();
+    test_exception();
+    std::printf("uninitialized_test: ok\n");
+    return 0;
+}